@@ -58,6 +58,14 @@ void JetMETPerformanceAnalysisDriver::init() {
 //      {"Jet", {}},
   };
 
+  // sliding-window CaloTower jets (only in NTuples produced with customiseNanoForL1ScoutSlidingWindowJets):
+  // response w.r.t. GEN jets, and comparison with the L1T jets and the AK4 CaloTower jets
+  if (hasOption("slidingWindowJets") and getOption("slidingWindowJets") == "1") {
+    labelMap_jetAK4_["GenJetNoMu"]["L1SW0"] = "L1EmulSW9x9CTJet0";
+    labelMap_jetAK4_["L1EmulSW9x9CTJet0"] = {
+        {"GEN", "GenJetNoMu"}, {"L1T", "L1EmulJet"}, {"L1CT0", "L1EmulAK4CTJet0"}};
+  }
+
   labelMap_jetAK8_ = {};
 
   labelMap_MET_ = {};
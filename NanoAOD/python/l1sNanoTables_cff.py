@@ -78,30 +78,50 @@ l1EmulEtSumTable = l1EtSumTable.clone(
     name = "L1EmulEtSum",
 )
 
-l1EmulAK4CTJet0Table = l1JetTable.clone(
-    src = 'l1sAK4CTJets0Emu',
-    name = 'L1EmulAK4CTJet0',
-    variables = cms.PSet(
-        l1P3Vars,
-        mass = Var("mass", float, precision=l1_float_precision_)
-    )
+l1EmulAK4CTJet0Table = cms.EDProducer("L1TJetSoAFlatTableProducer",
+    src = cms.InputTag('l1sAK4CTJetsEmu', 'Jets0SoA'),
+    name = cms.string('L1EmulAK4CTJet0'),
+    doc = cms.string(''),
+    minBX = cms.int32(0),
+    maxBX = cms.int32(0),
+    extension = cms.bool(False),
+    precision = cms.int32(l1_float_precision_)
 )
 
 l1EmulAK4CTJet0CorrBTable = l1EmulAK4CTJet0Table.clone(
-    src = 'l1sAK4CTJets0EmuCorrB',
+    src = 'l1sAK4CTJets0EmuCorrB:SoA',
     name = 'L1EmulAK4CTJet0CorrB'
 )
 
 l1EmulAK4CTJet0CorrCTable = l1EmulAK4CTJet0Table.clone(
-    src = 'l1sAK4CTJets0EmuCorrC',
+    src = 'l1sAK4CTJets0EmuCorrC:SoA',
     name = 'L1EmulAK4CTJet0CorrC'
 )
 
 l1EmulAK4CTJet1Table = l1EmulAK4CTJet0Table.clone(
-    src = 'l1sAK4CTJets1Emu',
+    src = 'l1sAK4CTJetsEmu:Jets1SoA',
     name = 'L1EmulAK4CTJet1'
 )
 
+l1EmulAK4CTJet0CorrCTopologyTable = cms.EDProducer("L1TJetTopologyFlatTableProducer",
+    src = cms.InputTag('l1sAK4CTJets0EmuCorrCTopology'),
+    name = cms.string('L1EmulAK4CTJet0CorrCTopology'),
+    doc = cms.string('HT, MHT, leading-pair and jet-count quantities of the L1EmulAK4CTJet0CorrC jets'),
+    minBX = cms.int32(0),
+    maxBX = cms.int32(0),
+    extension = cms.bool(False),
+    precision = cms.int32(l1_float_precision_)
+)
+
+l1EmulSW9x9CTJet0Table = l1JetTable.clone(
+    src = 'l1sSW9x9CTJets0Emu',
+    name = 'L1EmulSW9x9CTJet0',
+    variables = cms.PSet(
+        l1P3Vars,
+        mass = Var("mass", float, precision=l1_float_precision_)
+    )
+)
+
 ##
 ## Tasks
 ##
@@ -3,10 +3,13 @@ import FWCore.ParameterSet.Config as cms
 from L1ScoutingTools.NanoAOD.l1sNanoTables_cff import *
 
 from L1ScoutingTools.Reconstruction.l1sCTMultAbsIEta4_cfi import l1sCTMultAbsIEta4
-from L1ScoutingTools.Reconstruction.l1sAK4CTJets0Emu_cfi import l1sAK4CTJets0Emu
+from L1ScoutingTools.Reconstruction.l1sAK4CTJetsEmu_cfi import l1sAK4CTJetsEmu
+from L1ScoutingTools.Reconstruction.l1sAK4CTJetCorrectorB_cfi import l1sAK4CTJetCorrectorB
+from L1ScoutingTools.Reconstruction.l1sAK4CTJetCorrectorC_cfi import l1sAK4CTJetCorrectorC
 from L1ScoutingTools.Reconstruction.l1sAK4CTJets0EmuCorrB_cfi import l1sAK4CTJets0EmuCorrB
 from L1ScoutingTools.Reconstruction.l1sAK4CTJets0EmuCorrC_cfi import l1sAK4CTJets0EmuCorrC
-from L1ScoutingTools.Reconstruction.l1sAK4CTJets1Emu_cfi import l1sAK4CTJets1Emu
+from L1ScoutingTools.Reconstruction.l1sAK4CTJets0EmuCorrCTopology_cfi import l1sAK4CTJets0EmuCorrCTopology
+from L1ScoutingTools.Reconstruction.l1sSW9x9CTJets0Emu_cfi import l1sSW9x9CTJets0Emu
 
 from PhysicsTools.NanoAOD.nano_cff import nanoMetadata
 
@@ -16,10 +19,21 @@ l1sNanoSequence = cms.Sequence(l1sNanoTask)
 
 l1EmulExtraObjsTask = cms.Task(
     l1sCTMultAbsIEta4,
-    l1sAK4CTJets0Emu,
+    l1sAK4CTJetsEmu,
     l1sAK4CTJets0EmuCorrB,
     l1sAK4CTJets0EmuCorrC,
-    l1sAK4CTJets1Emu,
+)
+
+# sliding-window CaloTower jets (opt-in, see customiseNanoForL1ScoutSlidingWindowJets)
+l1EmulSlidingWindowJetsTask = cms.Task(
+    l1sSW9x9CTJets0Emu,
+    l1EmulSW9x9CTJet0Table,
+)
+
+# topological quantities of the corrected AK4 CaloTower jets (opt-in, see customiseNanoForL1ScoutJetTopology)
+l1EmulJetTopologyTask = cms.Task(
+    l1sAK4CTJets0EmuCorrCTopology,
+    l1EmulAK4CTJet0CorrCTopologyTable,
 )
 
 def customiseNanoForL1ScoutCaloTowersMC(process):
@@ -27,3 +41,12 @@ def customiseNanoForL1ScoutCaloTowersMC(process):
     process.l1sNanoTask.add(process.l1EmulCaloLayer1NanoTask)
     process.l1sNanoTask.add(process.l1EmulObjTablesTask)
     return process
+
+def customiseNanoForL1ScoutSlidingWindowJets(process):
+    process.l1sNanoTask.add(process.l1EmulSlidingWindowJetsTask)
+    return process
+
+def customiseNanoForL1ScoutJetTopology(process):
+    process.l1sNanoTask.add(process.l1EmulExtraObjsTask)
+    process.l1sNanoTask.add(process.l1EmulJetTopologyTask)
+    return process
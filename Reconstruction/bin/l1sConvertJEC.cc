@@ -0,0 +1,46 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrectionPayload.h"
+
+// Convert a text file of jet-energy-scale corrections (e.g. Reconstruction/data/*.txt)
+// to the binary JEC format read by JetCorrector (see JetCorrectionPayload).
+int main(int argc, char** argv) {
+  if (argc != 3 or std::strcmp(argv[1], "-h") == 0 or std::strcmp(argv[1], "--help") == 0) {
+    std::cerr << "usage: " << argv[0] << " <input text file> <output binary file>" << std::endl;
+    return 1;
+  }
+
+  std::string const inputFile{argv[1]};
+  std::string const outputFile{argv[2]};
+
+  try {
+    JetCorrectionPayload const payload{inputFile};
+    if (payload.mapped()) {
+      std::cerr << "input file is already in the binary JEC format: " << inputFile << std::endl;
+      return 1;
+    }
+
+    payload.writeBinary(outputFile);
+
+    // read back the output file, and compare it to the input payload
+    JetCorrectionPayload const output{outputFile};
+    if (output.bins().size() != payload.bins().size() or
+        output.parameters().size() != payload.parameters().size() or
+        std::memcmp(output.bins().data(), payload.bins().data(), payload.bins().size_bytes()) != 0 or
+        std::memcmp(output.parameters().data(), payload.parameters().data(), payload.parameters().size_bytes()) != 0) {
+      std::cerr << "output file differs from the input file after conversion: " << outputFile << std::endl;
+      return 1;
+    }
+
+    std::cout << inputFile << " -> " << outputFile << " (version " << JetCorrectionPayload::version << ", "
+              << payload.bins().size() << " bins, " << payload.parameters().size() << " parameters)" << std::endl;
+  } catch (cms::Exception const& ex) {
+    std::cerr << ex.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef L1ScoutingTools_Reconstruction_BxArrayRange_h
+#define L1ScoutingTools_Reconstruction_BxArrayRange_h
+
+// Contiguous range of BXs [firstBX, lastBX] of the per-BX array products (PUProxyBxArray, EtSumBxArray,
+// JetTopologyBxArray): every array of such a product has one value per BX (i-th value: BX firstBX + i).
+class BxArrayRange {
+public:
+  BxArrayRange() = default;
+  BxArrayRange(int const firstBX, int const lastBX) : firstBX_{firstBX}, lastBX_{lastBX} {}
+
+  int getFirstBX() const { return firstBX_; }
+  int getLastBX() const { return lastBX_; }
+
+  bool contains(int const bx) const { return bx >= firstBX_ and bx <= lastBX_; }
+
+  // number of BXs (zero if lastBX < firstBX)
+  unsigned int nBXs() const { return (lastBX_ >= firstBX_) ? lastBX_ - firstBX_ + 1 : 0; }
+
+protected:
+  // index of BX bx in the arrays (exception if bx is outside [firstBX, lastBX])
+  unsigned int index(int bx) const;
+
+private:
+  int firstBX_{0};
+  int lastBX_{-1};
+};
+
+#endif
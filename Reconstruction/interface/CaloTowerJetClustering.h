@@ -0,0 +1,91 @@
+#ifndef L1ScoutingTools_Reconstruction_CaloTowerJetClustering_h
+#define L1ScoutingTools_Reconstruction_CaloTowerJetClustering_h
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "DataFormats/L1Scouting/interface/L1ScoutingCaloTower.h"
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+#include "L1ScoutingTools/Reconstruction/interface/LatticeAntiKtClustering.h"
+
+#include "fastjet/JetDefinition.hh"
+#include "fastjet/PseudoJet.hh"
+
+namespace fastjet {
+  class ClusterSequence;
+}
+
+// Helpers shared by the modules clustering CaloL1 towers into anti-kT jets.
+namespace caloTowerJetClustering {
+  // clustering backend: fastjet::ClusterSequence, or LatticeAntiKtClustering
+  enum class Backend { FastJet, Lattice };
+
+  // backend from the value of the "backend" parameter of the modules ("FastJet" or "Lattice")
+  Backend backend(std::string const& name);
+
+  // FastJet input of one tower (hwEta and hwPhi must be valid): same as fastjet::PtYPhiM(Et, eta, phi, 0),
+  // with exp(eta), cos(phi) and sin(phi) from lookup tables
+  inline fastjet::PseudoJet fastJetInput(CaloTowerLUT const& lut, int const hwEt, int const hwEta, int const hwPhi) {
+    double const ctEt = lut.et(hwEt);
+    double const ctExpEta = lut.expEta(hwEta);
+    double const pminus = ctEt / ctExpEta;
+    double const pplus = ctEt * ctExpEta;
+
+    fastjet::PseudoJet ret(
+        ctEt * lut.cosPhi(hwPhi), ctEt * lut.sinPhi(hwPhi), 0.5 * (pplus - pminus), 0.5 * (pplus + pminus));
+    ret.set_cached_rap_phi(lut.eta(hwEta), lut.phi(hwPhi));
+    return ret;
+  }
+
+  // inclusive jets of a fastjet::ClusterSequence with pT >= ptMin, in the order of LatticeAntiKtClustering::inclusiveJets
+  // (fastjet::sorted_by_pt, except for jets with equal pT, see LatticeAntiKtClustering::higherPt)
+  void inclusiveJets(fastjet::ClusterSequence const&, double ptMin, std::vector<LatticeAntiKtClustering::Jet>& jets);
+
+  // Anti-kT clustering of the towers of one BX with one backend (same jets with both backends),
+  // used by all the modules clustering CaloL1 towers. Buffers are re-used across BXs.
+  class Clustering {
+  public:
+    Clustering(Backend, double rParam);
+
+    // cluster the towers of one BX selected by the pre-selector (after a call to CaloTowerPreSelector::select
+    // for the same BX)
+    void run(CaloTowerPreSelector const&, l1t::CaloTowerBxCollection const&, int bx);
+    void run(CaloTowerPreSelector const&, l1ScoutingRun3::CaloTowerOrbitCollection const&, unsigned int bx);
+
+    // cluster the towers added since the last call to clear()
+    // (hwEta and hwPhi must be valid; fjInput: fastJetInput of the tower, if already computed)
+    void clear();
+    void addTower(int hwPt, int hwEta, int hwPhi);
+    void addTower(int hwPt, int hwEta, int hwPhi, fastjet::PseudoJet const& fjInput);
+    void run();
+
+    // inclusive jets of the last clustering with pT >= ptMin, in the order of LatticeAntiKtClustering::higherPt
+    // (the jets of one clustering can be read for several values of ptMin)
+    std::vector<LatticeAntiKtClustering::Jet> const& inclusiveJets(double ptMin);
+
+    Backend backend() const { return backend_; }
+
+    // false if the last clustering used fastjet::ClusterSequence (backend FastJet, or ambiguous recombinations)
+    bool clusteredOnLattice() const { return clusteredOnLattice_; }
+
+    // total capacity (number of elements) of the internal buffers (used to monitor re-allocations)
+    std::size_t bufferCapacity() const;
+
+  private:
+    Backend const backend_;
+    CaloTowerLUT const& lut_;
+    fastjet::JetDefinition const fjJetDefinition_;
+    LatticeAntiKtClustering latticeClustering_;
+    std::vector<fastjet::PseudoJet> fjInputs_;
+
+    // all the inclusive jets of fastjet::ClusterSequence (backend FastJet), and the jets with pT >= ptMin
+    std::vector<LatticeAntiKtClustering::Jet> fjJets_;
+    std::vector<LatticeAntiKtClustering::Jet> jets_;
+    bool clusteredOnLattice_;
+  };
+}  // namespace caloTowerJetClustering
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef L1ScoutingTools_Reconstruction_CaloTowerLUT_h
+#define L1ScoutingTools_Reconstruction_CaloTowerLUT_h
+
+#include <array>
+
+// Lookup tables for the conversion of CaloL1 towers from hardware to physical units
+// (values of l1ScoutingRun3::calol1::fEt/fEta/fPhi, and the trigonometric/hyperbolic functions of eta and phi).
+//  - Tables cover the full domains of hwPt (9 bits), hwEta (8 bits, signed) and hwPhi (8 bits).
+//  - Entries are computed once (first call to get()) with the same arithmetic as fastjet::PtYPhiM,
+//    i.e. from the float values returned by the calol1 functions, promoted to double.
+//  - Accessors do not check their argument: hwEta and hwPhi must satisfy validHwEta/validHwPhi,
+//    and et() falls back to l1ScoutingRun3::calol1::fEt outside the 9-bit domain.
+class CaloTowerLUT {
+public:
+  static constexpr int kHwPtMax = 511;
+  static constexpr int kHwEtaMin = -128;
+  static constexpr int kHwEtaMax = 127;
+  static constexpr int kHwPhiMin = 0;
+  static constexpr int kHwPhiMax = 255;
+
+  static CaloTowerLUT const& get();
+
+  bool validHwEta(int const hwEta) const {
+    return hwEta >= kHwEtaMin and hwEta <= kHwEtaMax and validEta_[hwEta - kHwEtaMin];
+  }
+  bool validHwPhi(int const hwPhi) const {
+    return hwPhi >= kHwPhiMin and hwPhi <= kHwPhiMax and validPhi_[hwPhi - kHwPhiMin];
+  }
+
+  double et(int const hwPt) const { return (hwPt >= 0 and hwPt <= kHwPtMax) ? et_[hwPt] : etOutOfRange(hwPt); }
+
+  double eta(int const hwEta) const { return eta_[hwEta - kHwEtaMin]; }
+  double expEta(int const hwEta) const { return expEta_[hwEta - kHwEtaMin]; }
+  double sinhEta(int const hwEta) const { return sinhEta_[hwEta - kHwEtaMin]; }
+  double coshEta(int const hwEta) const { return coshEta_[hwEta - kHwEtaMin]; }
+
+  // phi in the range returned by l1ScoutingRun3::calol1::fPhi
+  double phi(int const hwPhi) const { return phi_[hwPhi - kHwPhiMin]; }
+  double cosPhi(int const hwPhi) const { return cosPhi_[hwPhi - kHwPhiMin]; }
+  double sinPhi(int const hwPhi) const { return sinPhi_[hwPhi - kHwPhiMin]; }
+
+private:
+  static constexpr int kEtaSize = kHwEtaMax - kHwEtaMin + 1;
+  static constexpr int kPhiSize = kHwPhiMax - kHwPhiMin + 1;
+
+  CaloTowerLUT();
+
+  static double etOutOfRange(int hwPt);
+
+  std::array<double, kHwPtMax + 1> et_;
+
+  std::array<bool, kEtaSize> validEta_;
+  std::array<double, kEtaSize> eta_;
+  std::array<double, kEtaSize> expEta_;
+  std::array<double, kEtaSize> sinhEta_;
+  std::array<double, kEtaSize> coshEta_;
+
+  std::array<bool, kPhiSize> validPhi_;
+  std::array<double, kPhiSize> phi_;
+  std::array<double, kPhiSize> cosPhi_;
+  std::array<double, kPhiSize> sinPhi_;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef L1ScoutingTools_Reconstruction_CaloTowerPreSelector_h
+#define L1ScoutingTools_Reconstruction_CaloTowerPreSelector_h
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "DataFormats/L1Scouting/interface/L1ScoutingCaloTower.h"
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+
+// Pre-selection of the CaloL1 towers of one BX, returning a compact list of indices.
+//  - Towers are first copied to contiguous arrays (hwPt, hwEta, hwPhi),
+//    then classified in a branch-free loop (hwPt window, validity of hwEta and hwPhi),
+//    and finally the indices of the selected towers are written without branches.
+//  - Towers in the hwPt window with invalid hwEta (or valid hwEta and invalid hwPhi)
+//    are not selected, and are counted instead (same logic as the former per-tower checks).
+class CaloTowerPreSelector {
+public:
+  // counts of towers in the hwPt window that were rejected because of invalid lattice coordinates
+  struct InvalidTowerCounts {
+    unsigned long long nBXs{0};
+    unsigned long long nInvalidHwEta{0};
+    unsigned long long nInvalidHwPhi{0};
+    unsigned int maxInvalidPerBX{0};
+
+    void add(InvalidTowerCounts const&);
+    void addBX(unsigned int nInvalidHwEta, unsigned int nInvalidHwPhi);
+    unsigned long long nInvalid() const { return nInvalidHwEta + nInvalidHwPhi; }
+
+    // add the counts of other, and reset them (e.g. per-stream counts, at the end of a lumi-section)
+    void take(InvalidTowerCounts& other);
+
+    // one LogWarning with the counts of a lumi-section, if any tower was rejected
+    // (usage: what the towers were not used for, e.g. "jet clustering")
+    void report(std::string const& logCategory,
+                std::string const& moduleLabel,
+                edm::LuminosityBlock const&,
+                std::string const& usage) const;
+  };
+
+  // hwPt window (inclusive), ignored if negative
+  CaloTowerPreSelector(int towerMinHwPt, int towerMaxHwPt);
+
+  // select the towers of one BX
+  void select(l1t::CaloTowerBxCollection const&, int bx);
+  void select(l1ScoutingRun3::CaloTowerOrbitCollection const&, unsigned int bx);
+
+  // indices (in the BX) of the selected towers, in input order
+  std::vector<unsigned int> const& indices() const { return indices_; }
+
+  // invalid towers in the last call to select()
+  unsigned int nInvalidHwEta() const { return nInvalidHwEta_; }
+  unsigned int nInvalidHwPhi() const { return nInvalidHwPhi_; }
+
+  std::size_t bufferCapacity() const;
+
+private:
+  void selectFilledArrays(unsigned int nTowers);
+
+  static constexpr std::uint32_t kHwPtOK = 1;
+  static constexpr std::uint32_t kHwEtaOK = 2;
+  static constexpr std::uint32_t kHwPhiOK = 4;
+  static constexpr std::uint32_t kSelected = kHwPtOK | kHwEtaOK | kHwPhiOK;
+
+  int const hwPtMin_;
+  int const hwPtMax_;
+  // 32-bit entries, so that the lookups can be vectorised with gather instructions
+  std::array<std::uint32_t, 256> validHwEta_;
+  std::array<std::uint32_t, 256> validHwPhi_;
+
+  std::vector<int> hwPt_;
+  std::vector<int> hwEta_;
+  std::vector<int> hwPhi_;
+  std::vector<std::uint32_t> flags_;
+  std::vector<unsigned int> indices_;
+
+  unsigned int nInvalidHwEta_;
+  unsigned int nInvalidHwPhi_;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef L1ScoutingTools_Reconstruction_CaloTowerWindowMasks_h
+#define L1ScoutingTools_Reconstruction_CaloTowerWindowMasks_h
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Lookup tables of the (hwPt, |hwEta|) windows of CaloL1 towers containing a tower (at most 64 windows, one bit per
+// window, bit i: i-th window), so that the windows of a tower are found with two lookups whatever their number:
+//  - one bitmask per hwPt value and per |hwEta| value, in [0, largest edge + 1] (the values above the largest edge
+//    are all in the same windows as largest edge + 1),
+//  - negative hwPt values are only in the windows without a lower bound on hwPt.
+class CaloTowerWindowMasks {
+public:
+  using Mask = std::uint64_t;
+
+  static constexpr unsigned int kMaxWindows = 64;
+
+  // edges are inclusive (negative edges: no bound)
+  struct Window {
+    int towerMinHwPt;
+    int towerMaxHwPt;
+    int towerMinAbsHwEta;
+    int towerMaxAbsHwEta;
+  };
+
+  // no windows (mask() must not be called before assigning a CaloTowerWindowMasks with windows)
+  CaloTowerWindowMasks() = default;
+  explicit CaloTowerWindowMasks(std::vector<Window> const& windows);
+
+  // windows containing a tower with hwPt and hwEta
+  Mask mask(int const hwPt, int const hwEta) const {
+    auto const hwPtMask = (hwPt < 0) ? negativeHwPtMask_ : hwPtMasks_[std::min(hwPt, lastHwPtIdx_)];
+    return hwPtMask & absHwEtaMasks_[std::min(std::abs(hwEta), lastAbsHwEtaIdx_)];
+  }
+
+private:
+  static std::vector<Mask> masks(std::vector<Window> const&, int Window::*min, int Window::*max);
+
+  std::vector<Mask> hwPtMasks_;
+  std::vector<Mask> absHwEtaMasks_;
+  int lastHwPtIdx_{-1};
+  int lastAbsHwEtaIdx_{-1};
+  Mask negativeHwPtMask_{0};
+};
+
+#endif
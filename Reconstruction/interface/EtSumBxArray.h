@@ -0,0 +1,37 @@
+#ifndef L1ScoutingTools_Reconstruction_EtSumBxArray_h
+#define L1ScoutingTools_Reconstruction_EtSumBxArray_h
+
+#include <vector>
+
+#include "L1ScoutingTools/Reconstruction/interface/BxArrayRange.h"
+
+// Scalar ET and missing-ET vector for every BX of a contiguous range of BXs
+// (missing ET: minus the vector sum of the transverse energies; zero for BXs without inputs).
+// The values of every quantity are stored in one array with one value per BX (see BxArrayRange).
+class EtSumBxArray : public BxArrayRange {
+public:
+  EtSumBxArray() = default;
+  EtSumBxArray(int firstBX, int lastBX);
+
+  // set the values of BX bx (bx must be in [firstBX, lastBX])
+  void set(int bx, float et, float metX, float metY);
+
+  // values of BX bx (bx must be in [firstBX, lastBX])
+  float et(int bx) const { return et_[index(bx)]; }
+  float metX(int bx) const { return metX_[index(bx)]; }
+  float metY(int bx) const { return metY_[index(bx)]; }
+  float met(int bx) const;
+  float metPhi(int bx) const;
+
+  // arrays of all BXs
+  std::vector<float> const& et() const { return et_; }
+  std::vector<float> const& metX() const { return metX_; }
+  std::vector<float> const& metY() const { return metY_; }
+
+private:
+  std::vector<float> et_;
+  std::vector<float> metX_;
+  std::vector<float> metY_;
+};
+
+#endif
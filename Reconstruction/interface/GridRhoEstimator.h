@@ -0,0 +1,79 @@
+#ifndef L1ScoutingTools_Reconstruction_GridRhoEstimator_h
+#define L1ScoutingTools_Reconstruction_GridRhoEstimator_h
+
+#include <array>
+#include <vector>
+
+class CaloTowerLUT;
+
+// Median transverse-energy density (rho) of CaloL1 towers, computed on the tower lattice.
+//  - The lattice is divided in patches of patchEtaSize x patchPhiSize towers
+//    (eta positions are contiguous across hwEta = 0 and across the invalid hwEta values;
+//    the last patch of a row/column may be smaller).
+//  - rho is the median over all patches of (sum of tower Et) / (patch area),
+//    the rho of an eta ring is the median over the patches of that row of patches.
+//  - The area of a tower is its size in (eta, phi), with eta boundaries half-way between
+//    neighbouring tower centres (the outermost towers are taken symmetric).
+// jetArea() returns the lattice area of a jet, i.e. the total area of the towers with centre
+// within DeltaR < R of the jet axis (no ghosts), to be used for offset subtraction (pT - rho * area);
+// only the towers of the eta rings and phi columns within R of the jet axis are visited.
+class GridRhoEstimator {
+public:
+  GridRhoEstimator(int patchEtaSize, int patchPhiSize);
+
+  // remove all inputs (buffers keep their capacity)
+  void clear();
+
+  // add one tower (hwEta and hwPhi must be valid, see CaloTowerLUT::validHwEta/validHwPhi)
+  void addTower(int hwPt, int hwEta, int hwPhi);
+
+  // compute rho from the towers added since the last call to clear()
+  void run();
+
+  double rho() const { return rho_; }
+
+  // rho of every eta ring (row of patches), in order of increasing eta
+  std::vector<double> const& ringRhos() const { return ringRhos_; }
+
+  // eta range of every eta ring
+  std::vector<std::array<double, 2>> const& ringEtaRanges() const { return ringEtaRanges_; }
+
+  double jetArea(double eta, double phi, double rParam) const;
+
+private:
+  static constexpr int kHwEtaOffset = 128;
+  static constexpr int kHwRange = 256;
+
+  static double median(std::vector<double>&, unsigned int begin, unsigned int end);
+
+  CaloTowerLUT const& lut_;
+  int const patchEtaSize_;
+  int const patchPhiSize_;
+
+  // lattice (cell = etaIndex * nPhi_ + phiIndex)
+  std::array<int, kHwRange> etaIndex_;
+  std::array<int, kHwRange> phiIndex_;
+  int nEta_;
+  int nPhi_;
+  std::vector<double> cellEta_;
+  std::vector<double> cellPhi_;
+  std::vector<double> cellEtaWidth_;
+  double cellPhiWidth_;
+
+  // phi columns in order of increasing phi, and their phi values
+  std::vector<int> phiOrder_;
+  std::vector<double> sortedCellPhi_;
+
+  // patches (patch = patchEtaIndex * nPatchesPhi_ + patchPhiIndex)
+  int nPatchesEta_;
+  int nPatchesPhi_;
+  std::vector<double> patchArea_;
+  std::vector<double> patchEt_;
+  std::vector<double> patchDensities_;
+
+  double rho_;
+  std::vector<double> ringRhos_;
+  std::vector<std::array<double, 2>> ringEtaRanges_;
+};
+
+#endif
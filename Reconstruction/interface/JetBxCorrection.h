@@ -0,0 +1,79 @@
+#ifndef L1ScoutingTools_Reconstruction_JetBxCorrection_h
+#define L1ScoutingTools_Reconstruction_JetBxCorrection_h
+
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+#include "L1ScoutingTools/Reconstruction/interface/PUProxyBxArray.h"
+
+// Jet-energy-scale corrections of the jets of a range of BXs of an l1t::JetBxCollection
+// (shared by the jet-corrector modules, with one object per stream: the buffers are re-used across events).
+//  - setInputs() gathers the pT and eta of the jets of all BXs in contiguous arrays, with the PU proxy of every BX,
+//    so that the jets are corrected with the batch interface of JetCorrector (one batch per run of consecutive BXs
+//    with the same PU proxy).
+//  - findBins() finds the bin of every jet once, for all the JetCorrectors with the same binning.
+//  - correctedJets() writes the corrected jets of every BX, in order of decreasing corrected pT.
+class JetBxCorrection {
+public:
+  // logCategory: MessageLogger category (and prefix) of the LogTrace messages, e.g. the name of the module
+  // maxJetsPerBx: max number of corrected jets per BX, in order of decreasing corrected pT (all jets, if negative)
+  JetBxCorrection(std::string logCategory, int maxJetsPerBx);
+
+  // input jets of the BXs [bxMin, bxMax], with the same PU proxy for all BXs, or the PU proxy of every BX
+  void setInputs(l1t::JetBxCollection const&, int bxMin, int bxMax, int puProxy);
+  void setInputs(l1t::JetBxCollection const&, int bxMin, int bxMax, PUProxyBxArray const& puProxyPerBx);
+
+  // bins of the input jets in the binning of the JetCorrector
+  void findBins(JetCorrector const&);
+
+  // correction factors of the input jets (resized to the number of jets), from the bins found by findBins()
+  // if the JetCorrector has the same binning, otherwise with one batch per run of BXs with the same PU proxy
+  void corrections(JetCorrector const&, std::vector<double>& corrections);
+
+  // corrected jets of every BX (jets with a non-positive correction factor are dropped), in order of decreasing
+  // corrected pT (ties: input order), in a new collection for the BXs [bxMin, bxMax], and optionally in a finalized
+  // JetSoABxCollection (label: label of the corrections in the LogTrace messages, e.g. of a variation)
+  void correctedJets(std::span<double const> corrections,
+                     l1t::JetBxCollection& output,
+                     JetSoABxCollection* soaOutput,
+                     std::string const& label = "");
+
+  int bxMin() const { return bxMin_; }
+  int bxMax() const { return bxMax_; }
+
+  // number of input jets
+  unsigned int size() const { return pts_.size(); }
+
+private:
+  void gatherInputs();
+
+  std::string const logCategory_;
+  int const maxJetsPerBx_;
+
+  l1t::JetBxCollection const* inputs_{nullptr};
+  int bxMin_{0};
+  int bxMax_{-1};
+
+  // PU proxy of every BX, and index of the first jet of every BX (plus the number of jets)
+  std::vector<int> puProxies_;
+  std::vector<unsigned int> bxOffsets_;
+  std::vector<float> pts_;
+  std::vector<float> etas_;
+
+  // bins of the jets (valid after findBins(), for JetCorrectors with the same binning as binnedCorrector_)
+  JetCorrector const* binnedCorrector_{nullptr};
+  std::vector<int> bins_;
+
+  // buffers of the batch interface of JetCorrector
+  JetCorrector::Workspace jetCorrectorWorkspace_;
+
+  // corrected pT and index of the jets of one BX
+  std::vector<std::pair<double, unsigned int>> sortKeys_;
+};
+
+#endif
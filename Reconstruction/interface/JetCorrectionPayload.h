@@ -0,0 +1,99 @@
+#ifndef L1ScoutingTools_Reconstruction_JetCorrectionPayload_h
+#define L1ScoutingTools_Reconstruction_JetCorrectionPayload_h
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Bins of jet-energy-scale corrections (see JetCorrector), in the layout of the binary JEC format:
+//   Header | Bin[nBins] | double parameters[nParameters] | char formulas[formulasSize]
+//  - formulas: null-terminated formula strings (every distinct formula stored once).
+//  - Numbers are stored in the byte order of the machine which wrote the file (checked when reading).
+// The payload is read either from a text file (see JetCorrector, parsed into a buffer with the binary layout),
+// or from a binary file (mapped read-only into memory, so that processes on the same node share its pages).
+class JetCorrectionPayload {
+public:
+  // formulas with an inline implementation in JetCorrector
+  enum class Kernel : std::uint32_t {
+    Generic = 0,        // reco::FormulaEvaluator
+    PolyLog = 1,        // [0]+[1]*x+[2]*x^2+[3]*log(x)
+    ScaledPolyLog = 2,  // [0]+[1]*(x/1000)+[2]*(x/1000)^2+[3]*log(x)
+  };
+
+  static constexpr char magic[8] = {'L', '1', 'S', 'J', 'E', 'C', '\0', '\0'};
+  static constexpr std::uint32_t version = 1;
+  static constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::uint32_t nBins;
+    std::uint32_t nParameters;
+    std::uint32_t formulasSize;
+    std::uint32_t reserved;
+  };
+
+  struct Bin {
+    float ptMin;
+    float ptMax;
+    float etaMin;
+    float etaMax;
+    std::int32_t puProxyMin;
+    std::int32_t puProxyMax;
+    Kernel kernel;
+    // offset of the formula in the formula strings, and of the first parameter in the parameters
+    std::uint32_t formulaOffset;
+    std::uint32_t parameterOffset;
+    std::uint32_t nParameters;
+  };
+
+  // kernel of a formula (Kernel::Generic if the formula has no inline implementation)
+  static Kernel kernel(std::string_view formula, unsigned int nParameters);
+
+  // text or binary file (the format is given by the first bytes of the file)
+  explicit JetCorrectionPayload(std::string const& filePath);
+  ~JetCorrectionPayload();
+
+  JetCorrectionPayload(JetCorrectionPayload&&) noexcept;
+  JetCorrectionPayload& operator=(JetCorrectionPayload&&) noexcept;
+  JetCorrectionPayload(JetCorrectionPayload const&) = delete;
+  JetCorrectionPayload& operator=(JetCorrectionPayload const&) = delete;
+
+  // true if the payload was read from a binary file (memory-mapped)
+  bool mapped() const { return mappedSize_ > 0; }
+
+  std::span<Bin const> bins() const { return bins_; }
+  std::span<double const> parameters() const { return parameters_; }
+  std::span<double const> parameters(Bin const& bin) const {
+    return parameters_.subspan(bin.parameterOffset, bin.nParameters);
+  }
+  std::string_view formula(Bin const& bin) const { return formulas_.data() + bin.formulaOffset; }
+
+  // write the payload to a file in the binary format
+  void writeBinary(std::string const& filePath) const;
+
+private:
+  void readText(std::string const& filePath);
+  void mapBinary(std::string const& filePath);
+
+  // set the views of the header, bins, parameters and formulas (checking sizes and offsets)
+  void setViews(std::byte const* data, std::size_t size, std::string const& filePath);
+
+  // buffer with the binary layout (text files), or memory mapping (binary files)
+  std::vector<std::byte> buffer_;
+  void* mappedData_{nullptr};
+  std::size_t mappedSize_{0};
+
+  std::byte const* data_{nullptr};
+  std::size_t size_{0};
+
+  std::span<Bin const> bins_;
+  std::span<double const> parameters_;
+  std::span<char const> formulas_;
+};
+
+#endif
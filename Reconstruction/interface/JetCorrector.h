@@ -0,0 +1,192 @@
+#ifndef L1ScoutingTools_Reconstruction_JetCorrector_h
+#define L1ScoutingTools_Reconstruction_JetCorrector_h
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "CommonTools/Utils/interface/FormulaEvaluator.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrectionPayload.h"
+
+// Jet-energy-scale corrections in bins of (eta, PU proxy), read from a text file with one line per bin:
+//   ptMin ptMax etaMin etaMax puProxyMin puProxyMax formula nParameters parameter_0 .. parameter_n-1
+// or from the equivalent binary file (memory-mapped, see JetCorrectionPayload and l1sConvertJEC).
+//  - The formula is evaluated at the jet pT clamped to [ptMin, ptMax].
+//  - Bins cover [etaMin, etaMax) and [puProxyMin, puProxyMax) (a negative PU-proxy edge means no bound).
+//  - Known formulas are bound at construction to inline kernels (parameters of all bins in one flat array),
+//    other formulas are evaluated with reco::FormulaEvaluator.
+//  - Optionally (tabulationTolerance > 0), the formula of every bin is sampled at construction
+//    on a log-spaced pt grid between ptMin and ptMax, and corrections are obtained by linear interpolation.
+//    The grid has 2^k points per factor 2 in pt (the grid position of a pt value follows from the exponent
+//    and mantissa of the float, without evaluating any function), with the smallest k such that the relative
+//    deviation from the formula is below the tolerance in the whole bin.
+//  - The bins are indexed at construction (sorted eta edges, then sorted PU-proxy edges in every eta bin),
+//    so that the bin of a jet is found with two binary searches; bins which overlap, and gaps between
+//    bins, are rejected.
+class JetCorrector {
+public:
+  // meaning of the value of the formula
+  enum class FormulaType { CorrectionFactor, CorrectedPt };
+
+  // useKernels=false: evaluate all formulas with reco::FormulaEvaluator (reference for the kernels)
+  // tabulationTolerance > 0: corrections from interpolation tables, with max relative deviation tabulationTolerance
+  JetCorrector(std::string const& filePath, FormulaType, bool useKernels = true, double tabulationTolerance = 0);
+
+  // correction factor (zero if the jet is not in any bin)
+  double correction(float pt, float eta, int puProxy) const;
+
+  // buffers of the batch interface, re-used across calls (e.g. one Workspace per stream, or per thread):
+  // the batch methods do not allocate memory once the buffers have grown to the size of the largest batch
+  struct Workspace {
+    // bin of the PU proxy in every eta bin
+    std::vector<int> etaBinEntries;
+    // bins of the jets of a batch
+    std::vector<int> bins;
+    // evaluation bin by bin: offsets of the bins, and jets, pt values and corrections ordered by bin
+    std::vector<unsigned int> binOffsets;
+    std::vector<unsigned int> order;
+    std::vector<float> sortedPts;
+    std::vector<double> sortedCorrections;
+  };
+
+  // correction factors of a batch of jets with the same PU proxy, written to corrections (same size as pts and etas);
+  // identical to correction() for every jet, with branch-free eta-bin searches, and the PU-proxy bins resolved once
+  // per eta bin (instead of once per jet) for batches larger than the number of eta bins; batches with at least as
+  // many jets as bins are evaluated bin by bin, with one straight-line loop over the contiguous pt values of every bin
+  void corrections(std::span<float const> pts,
+                   std::span<float const> etas,
+                   int puProxy,
+                   std::span<double> corrections,
+                   Workspace&) const;
+
+  // correction factors of the jets of consecutive groups (e.g. BXs) with one PU proxy per group: the jets of group i
+  // are [groupOffsets[i], groupOffsets[i+1]) (groupOffsets: one more element than puProxies, from 0 to the number
+  // of jets), and every run of consecutive groups with the same PU proxy is corrected as one batch
+  // (or all groups are evaluated together bin by bin, if they have at least as many jets as bins)
+  void corrections(std::span<float const> pts,
+                   std::span<float const> etas,
+                   std::span<int const> puProxies,
+                   std::span<unsigned int const> groupOffsets,
+                   std::span<double> corrections,
+                   Workspace&) const;
+
+  // corrections in two steps, so that the bin of every jet can be found once for several JetCorrectors with the same
+  // binning (e.g. variations of the same corrections): bins of a batch of jets (-1 for jets outside all bins),
+  // with one PU proxy or one PU proxy per group of jets, and correction factors of a batch of jets from their bins
+  // (identical to corrections() with the same jets and PU proxies)
+  void bins(std::span<float const> etas, int puProxy, std::span<int> bins, Workspace&) const;
+  void bins(std::span<float const> etas,
+            std::span<int const> puProxies,
+            std::span<unsigned int const> groupOffsets,
+            std::span<int> bins,
+            Workspace&) const;
+  void corrections(std::span<int const> bins,
+                   std::span<float const> pts,
+                   std::span<double> corrections,
+                   Workspace&) const;
+
+  // same eta and PU-proxy bins as another JetCorrector (in the same order): bins() of one can be used with the other
+  bool sameBinning(JetCorrector const&) const;
+
+  FormulaType formulaType() const { return formulaType_; }
+
+  unsigned int nBins() const { return entries_.size(); }
+  unsigned int nEtaBins() const { return etaBinOffsets_.size() - 1; }
+  unsigned int nGenericBins() const { return genericFormulas_.size(); }
+
+  // interpolation tables: max relative deviation from the formulas (sampled densely in every bin), and number of points
+  bool tabulated() const { return tabulated_; }
+  double maxTabulationDeviation() const { return maxTabulationDeviation_; }
+  unsigned int tableSize() const { return table_.size(); }
+
+private:
+  using Kernel = JetCorrectionPayload::Kernel;
+
+  struct Entry {
+    float ptMin;
+    float ptMax;
+    float etaMin;
+    float etaMax;
+    int puProxyMin;
+    int puProxyMax;
+    Kernel kernel;
+    // index of the first parameter in parameters_ (kernels), or of the formula in genericFormulas_ (Kernel::Generic)
+    unsigned int index;
+    // interpolation table: index of the first point in table_, bit pattern of the first point shifted by tableShift,
+    // and number of mantissa bits below the grid spacing (23 - k)
+    unsigned int tableOffset;
+    unsigned int tableFirstPoint;
+    unsigned int tableShift;
+  };
+
+  struct GenericFormula {
+    reco::FormulaEvaluator formulaEvaluator;
+    std::vector<double> formulaParameters;
+  };
+
+  // correction factor of a jet in the bin
+  double correction(Entry const&, float pt) const;
+
+  // whether a batch of nJets jets is evaluated bin by bin (at least as many jets as bins, and not too few jets)
+  bool groupedEvaluation(std::size_t nJets) const;
+
+  // correction factors of a batch of jets from their bins (valid indices in entries_, or -1): identical to correction()
+  // for every jet; large batches are ordered by bin (counting sort), and the jets of every bin are evaluated together
+  void evaluate(std::span<int const> bins,
+                std::span<float const> pts,
+                std::span<double> corrections,
+                Workspace&) const;
+
+  // correction factors of jets of the same bin, in one straight-line loop over their (contiguous) pt values
+  void evaluateBin(Entry const&, std::span<float const> pts, std::span<double> corrections) const;
+
+  // value of the formula of the bin (x: pt clamped to the range of the bin)
+  double formula(Entry const&, double x) const;
+
+  // value of the formula of the bin from its interpolation table
+  double interpolate(Entry const&, float x) const;
+
+  // build the interpolation table of one bin with the coarsest grid within the tolerance, and return its max deviation
+  double tabulate(Entry&, double tolerance);
+
+  void buildIndex();
+
+  // index of the bin of (eta, puProxy) in entries_, or -1
+  int findEntry(float eta, int puProxy) const;
+
+  // index of the bin of puProxy in eta bin etaBin, or -1
+  int findEntryInEtaBin(int etaBin, int puProxy) const;
+
+  // bin of puProxy in every eta bin, for batches of nJets jets larger than the number of eta bins (otherwise empty)
+  void findEtaBinEntries(std::size_t nJets, int puProxy, std::vector<int>& etaBinEntries) const;
+
+  // index of the eta bin of eta, or -1 (branch-free)
+  int findEtaBin(float eta) const;
+
+  FormulaType const formulaType_;
+
+  // bins, formulas and parameters read from the input file
+  JetCorrectionPayload payload_;
+
+  // parameters of all bins (in payload_)
+  double const* parameters_;
+  std::vector<GenericFormula> genericFormulas_;
+
+  bool tabulated_;
+  double maxTabulationDeviation_;
+  std::vector<double> table_;
+
+  // bins sorted by eta, then by PU proxy
+  std::vector<Entry> entries_;
+
+  // lower edges of the eta bins (plus the upper edge of the last one),
+  // and index of the first entry of every eta bin (plus the number of entries)
+  std::vector<float> etaEdges_;
+  std::vector<unsigned int> etaBinOffsets_;
+
+  // lower and upper PU-proxy edges of every entry (open edges replaced by the limits of int)
+  std::vector<int> puProxyLowEdges_;
+  std::vector<int> puProxyHighEdges_;
+};
+
+#endif
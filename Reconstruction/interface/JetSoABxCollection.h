@@ -0,0 +1,73 @@
+#ifndef L1ScoutingTools_Reconstruction_JetSoABxCollection_h
+#define L1ScoutingTools_Reconstruction_JetSoABxCollection_h
+
+#include <span>
+#include <vector>
+
+// Jets of a range of BXs as a structure of arrays (pt, eta, phi, mass), with per-BX offsets.
+//  - The jets of one BX are contiguous, and the BXs are stored in increasing order,
+//    so the kinematics of the jets of one BX (or of a range of BXs) can be read as contiguous arrays.
+//  - Jets must be added in non-decreasing order of BX, and finalize() must be called after the last jet
+//    (before the collection is read, or put in the event): the offsets of a BX are written once,
+//    when the first jet of a later BX is added, or by finalize() for the last BXs.
+// Lightweight alternative to l1t::JetBxCollection for consumers that only need the jet kinematics.
+class JetSoABxCollection {
+public:
+  JetSoABxCollection() = default;
+  JetSoABxCollection(int firstBX, int lastBX);
+
+  void reserve(unsigned int nJets);
+
+  // add one jet to BX bx (bx must be in [firstBX, lastBX], and not smaller than the BX of the last jet)
+  void push_back(int bx, float pt, float eta, float phi, float mass);
+
+  // set the offsets of the BXs after the BX of the last jet (no jets can be added afterwards)
+  void finalize();
+
+  bool finalized() const { return openBXIdx_ < 0; }
+
+  int getFirstBX() const { return firstBX_; }
+  int getLastBX() const { return lastBX_; }
+
+  // total number of jets, and number of jets in BX bx (zero for BXs outside the range)
+  unsigned int size() const { return pt_.size(); }
+  unsigned int size(int bx) const;
+
+  // index of the first jet of BX bx, and of the first jet after BX bx (in the arrays of all jets)
+  // (the collection must be finalized)
+  unsigned int begin(int bx) const;
+  unsigned int end(int bx) const;
+
+  // arrays of all jets
+  std::vector<float> const& pt() const { return pt_; }
+  std::vector<float> const& eta() const { return eta_; }
+  std::vector<float> const& phi() const { return phi_; }
+  std::vector<float> const& mass() const { return mass_; }
+
+  // arrays of the jets in the BX range [bxMin, bxMax] (clamped to [firstBX, lastBX])
+  std::span<float const> pt(int bxMin, int bxMax) const { return range(pt_, bxMin, bxMax); }
+  std::span<float const> eta(int bxMin, int bxMax) const { return range(eta_, bxMin, bxMax); }
+  std::span<float const> phi(int bxMin, int bxMax) const { return range(phi_, bxMin, bxMax); }
+  std::span<float const> mass(int bxMin, int bxMax) const { return range(mass_, bxMin, bxMax); }
+
+private:
+  std::span<float const> range(std::vector<float> const&, int bxMin, int bxMax) const;
+  void checkFinalized() const;
+
+  int firstBX_{0};
+  int lastBX_{-1};
+
+  // bxOffsets_[i] is the index of the first jet of BX (firstBX + i), and bxOffsets_.back() == size()
+  // (before finalize(), only the offsets up to index openBXIdx_ are set)
+  std::vector<unsigned int> bxOffsets_{0};
+
+  // index of the BX to which jets can be added (jets of the BXs before it are complete), -1 once finalized
+  int openBXIdx_{-1};
+
+  std::vector<float> pt_;
+  std::vector<float> eta_;
+  std::vector<float> phi_;
+  std::vector<float> mass_;
+};
+
+#endif
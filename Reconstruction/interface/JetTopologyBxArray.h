@@ -0,0 +1,79 @@
+#ifndef L1ScoutingTools_Reconstruction_JetTopologyBxArray_h
+#define L1ScoutingTools_Reconstruction_JetTopologyBxArray_h
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include "L1ScoutingTools/Reconstruction/interface/BxArrayRange.h"
+
+// Topological quantities of the jets of every BX of a contiguous range of BXs (one summary per BX):
+//  - nJets, HT, and missing-HT vector of the jets passing the HT selection,
+//  - invariant mass, |delta-eta| and |delta-phi| of the two leading jets (in pT) passing the HT selection
+//    (zero if fewer than two jets pass the HT selection),
+//  - number of jets passing each of a list of (pT, |eta|) selections ("jet counts", identified by a label).
+// The values of every quantity are stored in one array with one value per BX (see BxArrayRange),
+// so they can be read per BX by filters, or used directly as columns of a NanoAOD table.
+class JetTopologyBxArray : public BxArrayRange {
+public:
+  // values of one BX (except the jet counts)
+  struct Values {
+    int nJets{0};
+    float ht{0};
+    float mhtX{0};
+    float mhtY{0};
+    float mjj{0};
+    float dEtajj{0};
+    float dPhijj{0};
+  };
+
+  JetTopologyBxArray() = default;
+  JetTopologyBxArray(int firstBX, int lastBX, std::vector<std::string> countLabels);
+
+  // set the values of BX bx (bx must be in [firstBX, lastBX], counts: one value per jet count)
+  void set(int bx, Values const& values, std::span<int const> counts);
+
+  // values of BX bx (bx must be in [firstBX, lastBX])
+  Values values(int bx) const;
+  int nJets(int bx) const { return nJets_[index(bx)]; }
+  float ht(int bx) const { return ht_[index(bx)]; }
+  float mht(int bx) const;
+  float mhtPhi(int bx) const;
+  float mjj(int bx) const { return mjj_[index(bx)]; }
+  float dEtajj(int bx) const { return dEtajj_[index(bx)]; }
+  float dPhijj(int bx) const { return dPhijj_[index(bx)]; }
+
+  // labels of the jet counts, and jet counts of BX bx (one value per label)
+  std::vector<std::string> const& countLabels() const { return countLabels_; }
+  std::span<int const> counts(int bx) const;
+
+  // index of the jet count with label "label" (-1 if not found)
+  int countIndex(std::string const& label) const;
+
+  // arrays of all BXs
+  std::vector<int> const& nJets() const { return nJets_; }
+  std::vector<float> const& ht() const { return ht_; }
+  std::vector<float> const& mhtX() const { return mhtX_; }
+  std::vector<float> const& mhtY() const { return mhtY_; }
+  std::vector<float> const& mjj() const { return mjj_; }
+  std::vector<float> const& dEtajj() const { return dEtajj_; }
+  std::vector<float> const& dPhijj() const { return dPhijj_; }
+
+  // jet counts of all BXs for one label (one value per BX)
+  std::vector<int> countArray(unsigned int countIdx) const;
+
+private:
+  std::vector<int> nJets_;
+  std::vector<float> ht_;
+  std::vector<float> mhtX_;
+  std::vector<float> mhtY_;
+  std::vector<float> mjj_;
+  std::vector<float> dEtajj_;
+  std::vector<float> dPhijj_;
+
+  // jet counts: BX by BX, countLabels_.size() values per BX
+  std::vector<std::string> countLabels_;
+  std::vector<int> counts_;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef L1ScoutingTools_Reconstruction_JetTopologyCalculator_h
+#define L1ScoutingTools_Reconstruction_JetTopologyCalculator_h
+
+#include <span>
+#include <vector>
+
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyBxArray.h"
+
+// Topological quantities of the jets of one BX (see JetTopologyBxArray), from the jet kinematics in SoA layout:
+//  - nJets, HT, missing-HT vector, and jet counts: loops over the (pt, eta, phi) arrays without data-dependent
+//    branches (the selections are evaluated as masks on every jet),
+//  - leading pair: search of the two leading jets (in pT) passing the HT selection (the first jet in input order
+//    if equal pT), followed by their mjj, |delta-eta| and |delta-phi| (delta-phi wrapped to [0, pi]).
+class JetTopologyCalculator {
+public:
+  // pT > ptMin and |eta| in (absEtaMin, absEtaMax) (|eta| bounds ignored if negative)
+  struct Selection {
+    double ptMin;
+    double absEtaMin;
+    double absEtaMax;
+
+    bool selected(double const pt, double const absEta) const {
+      return ((absEtaMin < 0) | (absEta > absEtaMin)) & ((absEtaMax < 0) | (absEta < absEtaMax)) & (pt > ptMin);
+    }
+  };
+
+  JetTopologyCalculator(Selection const& htSelection, std::vector<Selection> countSelections);
+
+  unsigned int nCounts() const { return countSelections_.size(); }
+
+  // values of the jets of one BX (same size for all arrays), and their jet counts (one value per count selection)
+  JetTopologyBxArray::Values compute(std::span<float const> pts,
+                                     std::span<float const> etas,
+                                     std::span<float const> phis,
+                                     std::span<float const> masses,
+                                     std::span<int> counts) const;
+
+private:
+  Selection const htSelection_;
+  std::vector<Selection> const countSelections_;
+};
+
+#endif
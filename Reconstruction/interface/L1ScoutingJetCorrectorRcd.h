@@ -0,0 +1,9 @@
+#ifndef L1ScoutingTools_Reconstruction_L1ScoutingJetCorrectorRcd_h
+#define L1ScoutingTools_Reconstruction_L1ScoutingJetCorrectorRcd_h
+
+#include "FWCore/Framework/interface/EventSetupRecordImplementation.h"
+
+// EventSetup record of the jet-energy-scale corrections of L1-Scouting jets (JetCorrector)
+class L1ScoutingJetCorrectorRcd : public edm::eventsetup::EventSetupRecordImplementation<L1ScoutingJetCorrectorRcd> {};
+
+#endif
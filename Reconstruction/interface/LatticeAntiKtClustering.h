@@ -0,0 +1,148 @@
+#ifndef L1ScoutingTools_Reconstruction_LatticeAntiKtClustering_h
+#define L1ScoutingTools_Reconstruction_LatticeAntiKtClustering_h
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "fastjet/JetDefinition.hh"
+#include "fastjet/PseudoJet.hh"
+
+class CaloTowerLUT;
+
+// Anti-kT clustering of CaloL1 towers (E-scheme recombination),
+// specialised for inputs sitting on the fixed (hwEta, hwPhi) lattice.
+//
+// The arithmetic mirrors the one of fastjet::ClusterSequence
+// (fastjet::PtYPhiM inputs, cached rapidity/phi, same distance measures),
+// so that the inclusive jets are identical to the ones obtained with FastJet:
+//  - distances between two towers are read from precomputed (eta, phi) tables,
+//  - nearest-neighbour searches are restricted to the 3x3 neighbouring tiles
+//    (tiles have size >= R in both rapidity and phi, neighbour lists are precomputed),
+//  - the minimum distance is tracked with a tournament tree.
+//
+// On the lattice, exact ties between distances are common (e.g. a tower with two nearest neighbours at the same
+// distance), and FastJet resolves them in an order that depends on its internal data structures (and on the strategy
+// it selects for the given number of inputs). Every recombination is therefore checked to be the only one possible
+// for any resolution of the ties: the nearest neighbour of the jet with the minimum d_ij is unique, and no other jet
+// can reach the same d_ij, except its nearest neighbour (same pair), or other jets recombined with the beam if the
+// jet is recombined with the beam too (jets without neighbours within R: their order does not change any other jet).
+// If a recombination is ambiguous, the towers of the BX are clustered with fastjet::ClusterSequence instead,
+// so that the jets are always the FastJet ones.
+class LatticeAntiKtClustering {
+public:
+  struct Jet {
+    double px;
+    double py;
+    double pz;
+    double E;
+  };
+
+  explicit LatticeAntiKtClustering(double rParam);
+
+  // remove all inputs and outputs (buffers keep their capacity)
+  void clear();
+
+  // add one tower (hwEta and hwPhi must be valid, see CaloTowerLUT::validHwEta/validHwPhi)
+  void addTower(int hwPt, int hwEta, int hwPhi);
+
+  // run the clustering on the towers added since the last call to clear()
+  // (returns false if a recombination was ambiguous and the towers were clustered with fastjet::ClusterSequence)
+  bool run();
+
+  // inclusive jets with pT >= ptMin, in the order of higherPt
+  std::vector<Jet> const& inclusiveJets(double ptMin);
+
+  // order of the inclusive jets: decreasing pT^2 (px^2 + py^2, as fastjet::sorted_by_pt), then decreasing E, pz, px
+  // and py (jets with equal pT are in a fixed order, independent of the order of their recombinations with the beam)
+  static bool higherPt(Jet const& jet1, Jet const& jet2);
+
+  unsigned int nInputs() const { return px_.size(); }
+
+  // total capacity (number of elements) of the internal buffers (used to monitor re-allocations)
+  std::size_t bufferCapacity() const;
+
+  double rParam() const { return rParam_; }
+
+private:
+  static constexpr int kHwEtaOffset = 128;
+  static constexpr int kHwRange = 256;
+
+  void insertInTile(int slot);
+  void removeFromTile(int slot);
+  double distance(int slot1, int slot2) const;
+  void setNearestNeighbour(int slot);
+  void setDiJ(int slot);
+  void updateTree(int slot);
+  bool unambiguous(int jetA);
+  void runFastJet();
+  void setKinematics(int slot);
+  int tileIndex(double rap, double phi) const;
+
+  CaloTowerLUT const& lut_;
+  double const rParam_;
+  double const r2_;
+  fastjet::JetDefinition const fjJetDefinition_;
+
+  // lattice tables
+  std::array<int, kHwRange> etaIndex_;
+  std::array<int, kHwRange> phiIndex_;
+  std::vector<double> latticeEta_;
+  std::vector<double> latticePhi_;
+  std::vector<double> latticeDEta2_;
+  std::vector<double> latticeDPhi2_;
+  std::vector<int> latticeTile_;
+
+  // tiles
+  double tileEtaMin_;
+  double tileEtaSize_;
+  double tilePhiSize_;
+  int nTilesEta_;
+  int nTilesPhi_;
+  std::vector<std::vector<int>> tileNeighbours_;
+  std::vector<int> tileHead_;
+  std::vector<unsigned int> tileMark_;
+  unsigned int tileMarkCounter_;
+  std::vector<int> touchedTiles_;
+
+  // per-jet data (one slot per input tower; a merged jet re-uses the lower slot of its parents)
+  std::vector<double> px_;
+  std::vector<double> py_;
+  std::vector<double> pz_;
+  std::vector<double> E_;
+  std::vector<double> rap_;
+  std::vector<double> phi_;
+  std::vector<double> momFactor_;
+  std::vector<double> nnDist_;
+  std::vector<double> diJ_;
+  std::vector<int> nn_;
+  std::vector<char> nnTie_;
+  std::vector<int> cellEta_;
+  std::vector<int> cellPhi_;
+  std::vector<int> tile_;
+  std::vector<int> tileNext_;
+  std::vector<int> tilePrev_;
+
+  // tournament tree over diJ_ (leaves hold slot indices), and nodes to visit when searching for equal minima
+  std::vector<int> tree_;
+  unsigned int treeLeaves_;
+  std::vector<unsigned int> treeStack_;
+
+  // input towers, clustered with fastjet::ClusterSequence if a recombination is ambiguous
+  std::vector<int> towerHwPt_;
+  std::vector<int> towerHwEta_;
+  std::vector<int> towerHwPhi_;
+  std::vector<fastjet::PseudoJet> fjInputs_;
+  bool usedFastJet_;
+
+  // inclusive jets of fastjet::ClusterSequence (all of them, if a recombination was ambiguous)
+  std::vector<Jet> fjJets_;
+
+  // jets recombined with the beam, in order of recombination
+  std::vector<int> beamJets_;
+
+  // output
+  std::vector<Jet> jets_;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef L1ScoutingTools_Reconstruction_PUProxyBxArray_h
+#define L1ScoutingTools_Reconstruction_PUProxyBxArray_h
+
+#include <vector>
+
+#include "L1ScoutingTools/Reconstruction/interface/BxArrayRange.h"
+
+// One PU-proxy value (e.g. a CaloTower multiplicity) for every BX of a contiguous range of BXs.
+// Dense alternative to one int product per BX, used to correct the jets of every BX with the PU proxy of that BX.
+class PUProxyBxArray : public BxArrayRange {
+public:
+  PUProxyBxArray() = default;
+  PUProxyBxArray(int firstBX, int lastBX);
+
+  // value of BX bx (bx must be in [firstBX, lastBX])
+  int at(int bx) const { return values_[index(bx)]; }
+  int& at(int bx) { return values_[index(bx)]; }
+
+  // values of all BXs
+  std::vector<int> const& values() const { return values_; }
+
+private:
+  std::vector<int> values_;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef L1ScoutingTools_Reconstruction_SlidingWindowJetFinder_h
+#define L1ScoutingTools_Reconstruction_SlidingWindowJetFinder_h
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class CaloTowerLUT;
+
+// Sliding-window jet finder on the CaloL1 tower lattice (in the spirit of the Calo Layer-2 jets).
+//  - Seeds are towers with hwPt >= seedMinHwPt which are local maxima in a square window
+//    of (2 * windowHalfSize + 1) x (2 * windowHalfSize + 1) towers (9x9 for windowHalfSize = 4).
+//  - Ties between towers with equal hwPt are resolved with the Layer-2 convention: the seed must be
+//    strictly larger than the towers at higher (eta, phi) positions, and larger or equal to the others.
+//  - The jet four-momentum is the sum of the (massless) four-momenta of the towers in the window of the seed.
+//  - The window wraps around in phi, and is truncated at the edges of the lattice in eta
+//    (eta positions are contiguous across hwEta = 0 and across the invalid hwEta values).
+// The cost is linear in the number of towers (seeds x window size).
+class SlidingWindowJetFinder {
+public:
+  struct Jet {
+    double px;
+    double py;
+    double pz;
+    double E;
+  };
+
+  SlidingWindowJetFinder(int windowHalfSize, int seedMinHwPt);
+
+  // remove all inputs and outputs (buffers keep their capacity)
+  void clear();
+
+  // add one tower (hwEta and hwPhi must be valid, see CaloTowerLUT::validHwEta/validHwPhi)
+  void addTower(int hwPt, int hwEta, int hwPhi);
+
+  // find the jets from the towers added since the last call to clear()
+  void run();
+
+  // jets with pT >= ptMin, sorted by decreasing pT
+  std::vector<Jet> const& jets(double ptMin);
+
+  unsigned int nInputs() const { return nInputs_; }
+
+  // total capacity (number of elements) of the internal buffers (used to monitor re-allocations)
+  std::size_t bufferCapacity() const;
+
+  int windowHalfSize() const { return windowHalfSize_; }
+  int seedMinHwPt() const { return seedMinHwPt_; }
+
+private:
+  static constexpr int kHwEtaOffset = 128;
+  static constexpr int kHwRange = 256;
+
+  bool isSeed(int cell) const;
+
+  CaloTowerLUT const& lut_;
+  int const windowHalfSize_;
+  int const seedMinHwPt_;
+
+  // lattice (cell = etaIndex * nPhi_ + phiIndex)
+  std::array<int, kHwRange> etaIndex_;
+  std::array<int, kHwRange> phiIndex_;
+  int nEta_;
+  int nPhi_;
+  std::vector<double> cosPhi_;
+  std::vector<double> sinPhi_;
+  std::vector<double> sinhEta_;
+  std::vector<double> coshEta_;
+
+  // per-cell hwPt (sum over the towers in the cell), and list of non-empty cells
+  std::vector<int> cellHwPt_;
+  std::vector<int> filledCells_;
+  unsigned int nInputs_;
+
+  // output (allJets_ and seedCells_ in order of seed finding, jets_ after selection and sorting)
+  std::vector<Jet> allJets_;
+  std::vector<int> seedCells_;
+  std::vector<Jet> jets_;
+  std::vector<double> sortValues_;
+  std::vector<int> sortIndices_;
+};
+
+#endif
@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -7,22 +10,87 @@
 #include "DataFormats/L1Trigger/interface/Jet.h"
 #include "FWCore/Framework/interface/global/EDProducer.h"
 #include "FWCore/Framework/interface/Event.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
-#include "L1TriggerScouting/Utilities/interface/conversion.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
 
-#include "fastjet/ClusterSequence.hh"
-#include "fastjet/JetDefinition.hh"
-#include "fastjet/PseudoJet.hh"
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
 
-class L1TCaloTowerAKJetProducer : public edm::global::EDProducer<> {
+namespace l1tCaloTowerAKJetProducer {
+  // per-stream buffers, re-used across BXs and events
+  struct Workspace {
+    Workspace(double const rParam, int const towerMinHwPt, int const towerMaxHwPt)
+        : preSelector{towerMinHwPt, towerMaxHwPt},
+          fjClustering{caloTowerJetClustering::Backend::FastJet, rParam},
+          latticeClustering{caloTowerJetClustering::Backend::Lattice, rParam} {}
+
+    std::size_t bufferCapacity() const {
+      return preSelector.bufferCapacity() + fjClustering.bufferCapacity() + latticeClustering.bufferCapacity() +
+             fjJetP4s.capacity() + latticeJetP4s.capacity();
+    }
+
+    CaloTowerPreSelector preSelector;
+    caloTowerJetClustering::Clustering fjClustering;
+    caloTowerJetClustering::Clustering latticeClustering;
+    std::vector<l1t::Jet::LorentzVector> fjJetP4s;
+    std::vector<l1t::Jet::LorentzVector> latticeJetP4s;
+
+    // number of BXs in which at least one buffer had to grow
+    unsigned long long nAllocations{0};
+    unsigned long long nClusterSequences{0};
+
+    // towers rejected because of invalid lattice coordinates (reset at the end of every lumi)
+    CaloTowerPreSelector::InvalidTowerCounts invalidTowers;
+  };
+
+  struct StreamCache {
+    StreamCache(double const rParam, int const towerMinHwPt, int const towerMaxHwPt)
+        : workspace{rParam, towerMinHwPt, towerMaxHwPt}, concurrentWorkspaces{rParam, towerMinHwPt, towerMaxHwPt} {}
+
+    // workspace for serial processing, and one workspace per thread when BXs are clustered concurrently
+    Workspace workspace;
+    tbb::enumerable_thread_specific<Workspace> concurrentWorkspaces;
+
+    // output jets of every BX, copied into the output product in BX order
+    std::vector<std::vector<l1t::Jet::LorentzVector>> bxJetP4s;
+  };
+}  // namespace l1tCaloTowerAKJetProducer
+
+class L1TCaloTowerAKJetProducer
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerAKJetProducer::StreamCache>,
+                                     edm::LuminosityBlockSummaryCache<CaloTowerPreSelector::InvalidTowerCounts>> {
 public:
   explicit L1TCaloTowerAKJetProducer(edm::ParameterSet const&);
 
   static void fillDescriptions(edm::ConfigurationDescriptions&);
 
 private:
+  using Workspace = l1tCaloTowerAKJetProducer::Workspace;
+  using StreamCache = l1tCaloTowerAKJetProducer::StreamCache;
+  using InvalidTowerCounts = CaloTowerPreSelector::InvalidTowerCounts;
+
+  using Backend = caloTowerJetClustering::Backend;
+
+  std::unique_ptr<StreamCache> beginStream(edm::StreamID) const override;
   void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  std::shared_ptr<InvalidTowerCounts> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const override;
+  void streamEndLuminosityBlockSummary(edm::StreamID,
+                                       edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void clusterBX(l1t::CaloTowerBxCollection const&, int bx, Workspace&, std::vector<l1t::Jet::LorentzVector>&) const;
+  void endJob() override;
 
   edm::EDGetTokenT<l1t::CaloTowerBxCollection> const srcToken_;
   int const bxMin_;
@@ -31,7 +99,18 @@ private:
   int const towerMaxHwPt_;
   double const rParam_;
   double const jetPtMin_;
-  fastjet::JetDefinition const fjJetDefinition_;
+  Backend const backend_;
+  bool const compareBackends_;
+  bool const concurrentBXs_;
+  bool const produceSoA_;
+
+  edm::EDPutTokenT<JetSoABxCollection> soaPutToken_;
+
+  // summary of the comparison between the clustering backends
+  mutable std::atomic<unsigned long long> nComparedBXs_{0};
+  mutable std::atomic<unsigned long long> nMismatchedBXs_{0};
+  mutable std::atomic<unsigned long long> timeFastJetNs_{0};
+  mutable std::atomic<unsigned long long> timeLatticeNs_{0};
 };
 
 L1TCaloTowerAKJetProducer::L1TCaloTowerAKJetProducer(edm::ParameterSet const& iConfig)
@@ -42,58 +121,227 @@ L1TCaloTowerAKJetProducer::L1TCaloTowerAKJetProducer(edm::ParameterSet const& iC
       towerMaxHwPt_{iConfig.getParameter<int>("towerMaxHwPt")},
       rParam_{iConfig.getParameter<double>("rParam")},
       jetPtMin_{iConfig.getParameter<double>("jetPtMin")},
-      fjJetDefinition_{fastjet::antikt_algorithm, rParam_} {
+      backend_{caloTowerJetClustering::backend(iConfig.getParameter<std::string>("backend"))},
+      compareBackends_{iConfig.getParameter<bool>("compareBackends")},
+      concurrentBXs_{iConfig.getParameter<bool>("concurrentBXs")},
+      produceSoA_{iConfig.getParameter<bool>("produceSoA")} {
   produces<l1t::JetBxCollection>();
+  if (produceSoA_) {
+    soaPutToken_ = produces<JetSoABxCollection>("SoA");
+  }
+}
+
+std::unique_ptr<L1TCaloTowerAKJetProducer::StreamCache> L1TCaloTowerAKJetProducer::beginStream(edm::StreamID) const {
+  return std::make_unique<StreamCache>(rParam_, towerMinHwPt_, towerMaxHwPt_);
+}
+
+std::shared_ptr<L1TCaloTowerAKJetProducer::InvalidTowerCounts> L1TCaloTowerAKJetProducer::globalBeginLuminosityBlockSummary(
+    edm::LuminosityBlock const&, edm::EventSetup const&) const {
+  return std::make_shared<InvalidTowerCounts>();
+}
+
+void L1TCaloTowerAKJetProducer::streamEndLuminosityBlockSummary(edm::StreamID streamID,
+                                                                edm::LuminosityBlock const&,
+                                                                edm::EventSetup const&,
+                                                                InvalidTowerCounts* summary) const {
+  auto& cache = *streamCache(streamID);
+
+  summary->take(cache.workspace.invalidTowers);
+
+  for (auto& workspace : cache.concurrentWorkspaces) {
+    summary->take(workspace.invalidTowers);
+  }
+}
+
+void L1TCaloTowerAKJetProducer::globalEndLuminosityBlockSummary(edm::LuminosityBlock const& iLumi,
+                                                                edm::EventSetup const&,
+                                                                InvalidTowerCounts* summary) const {
+  summary->report("ScoutingJetProducer", moduleDescription().moduleLabel(), iLumi, "jet clustering");
 }
 
-void L1TCaloTowerAKJetProducer::produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
+void L1TCaloTowerAKJetProducer::produce(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const&) const {
   auto const& inputs = iEvent.get(srcToken_);
 
+  auto& cache = *streamCache(streamID);
+
   auto const bxMin = std::max(bxMin_, inputs.getFirstBX());
   auto const bxMax = std::min(bxMax_, inputs.getLastBX());
 
   auto output = std::make_unique<l1t::JetBxCollection>(0, bxMin, bxMax);
 
-  for (auto bx = bxMin; bx <= bxMax; ++bx) {
-    auto const nInputs = inputs.size(bx);
-
-    std::vector<fastjet::PseudoJet> fjInputs{};
-    fjInputs.reserve(nInputs);
-    for (auto idx = 0u; idx < nInputs; ++idx) {
-      auto const& input = inputs.at(bx, idx);
-      if ((towerMinHwPt_ < 0 or input.hwPt() >= towerMinHwPt_) and
-          (towerMaxHwPt_ < 0 or input.hwPt() <= towerMaxHwPt_)) {
-
-        if (not l1ScoutingRun3::calol1::validHwEta(input.hwEta())) {
-          edm::LogWarning("ScoutingJetProducer") << "CaloTower in BX=" << bx << " with invalid hwEta value ("
-                                                 << input.hwEta() << ") will not be used for jet clustering !";
-          continue;
-        }
-
-        if (not l1ScoutingRun3::calol1::validHwPhi(input.hwPhi())) {
-          edm::LogWarning("ScoutingJetProducer") << "CaloTower in BX=" << bx << " with invalid hwPhi value ("
-                                                 << input.hwPhi() << ") will not be used for jet clustering !";
-          continue;
-        }
-
-        float const ctEt = l1ScoutingRun3::calol1::fEt(input.hwPt());
-        float const ctEta = l1ScoutingRun3::calol1::fEta(input.hwEta());
-        float const ctPhi = l1ScoutingRun3::calol1::fPhi(input.hwPhi());
-
-        fjInputs.emplace_back(fastjet::PtYPhiM(ctEt, ctEta, ctPhi, 0));
-      }
+  auto const nBXs = std::max(0, bxMax - bxMin + 1);
+  if (cache.bxJetP4s.size() < unsigned(nBXs)) {
+    cache.bxJetP4s.resize(nBXs);
+  }
+
+  auto const workspaceCounts = [&cache]() {
+    auto counts = std::make_pair(cache.workspace.nAllocations, cache.workspace.nClusterSequences);
+    for (auto const& workspace : cache.concurrentWorkspaces) {
+      counts.first += workspace.nAllocations;
+      counts.second += workspace.nClusterSequences;
     }
+    return counts;
+  };
 
-    auto const fjClusterSeq = fastjet::ClusterSequence{fjInputs, fjJetDefinition_};
-    auto const fjJets = fastjet::sorted_by_pt(fjClusterSeq.inclusive_jets(jetPtMin_));
+  auto const countsBefore = workspaceCounts();
 
-    for (auto const& fjJet : fjJets) {
-      l1t::Jet::LorentzVector const p4{fjJet.px(), fjJet.py(), fjJet.pz(), fjJet.E()};
+  // BXs are clustered concurrently only if there are BXs in [bxMin, bxMax] (the range is empty if bxMin > bxMax)
+  if (concurrentBXs_ and nBXs > 0) {
+    // BXs are independent: cluster them concurrently, each task with its own workspace
+    tbb::parallel_for(tbb::blocked_range<int>(bxMin, bxMax + 1), [&](tbb::blocked_range<int> const& range) {
+      auto& workspace = cache.concurrentWorkspaces.local();
+      for (auto bx = range.begin(); bx != range.end(); ++bx) {
+        clusterBX(inputs, bx, workspace, cache.bxJetP4s[bx - bxMin]);
+      }
+    });
+  } else {
+    for (auto bx = bxMin; bx <= bxMax; ++bx) {
+      clusterBX(inputs, bx, cache.workspace, cache.bxJetP4s[bx - bxMin]);
+    }
+  }
+
+  // fill the output product in BX order (independent of the order in which BXs were processed)
+  for (auto bx = bxMin; bx <= bxMax; ++bx) {
+    for (auto const& p4 : cache.bxJetP4s[bx - bxMin]) {
       output->push_back(bx, l1t::Jet{p4});
     }
   }
 
+  auto const countsAfter = workspaceCounts();
+
+  LogTrace("L1TCaloTowerAKJetProducer")
+      << "[L1TCaloTowerAKJetProducer] [" << moduleDescription().moduleLabel()
+      << "] BXs with re-allocation of the stream workspaces: " << (countsAfter.first - countsBefore.first)
+      << " (total in this stream: " << countsAfter.first
+      << "), fastjet::ClusterSequence instances: " << (countsAfter.second - countsBefore.second);
+
+  auto const nJets = output->size();
   iEvent.put(std::move(output));
+
+  // same jets as structure of arrays
+  if (produceSoA_) {
+    JetSoABxCollection soaOutput(bxMin, bxMax);
+    soaOutput.reserve(nJets);
+    for (auto bx = bxMin; bx <= bxMax; ++bx) {
+      for (auto const& p4 : cache.bxJetP4s[bx - bxMin]) {
+        soaOutput.push_back(bx, p4.pt(), p4.eta(), p4.phi(), p4.mass());
+      }
+    }
+    soaOutput.finalize();
+    iEvent.emplace(soaPutToken_, std::move(soaOutput));
+  }
+}
+
+void L1TCaloTowerAKJetProducer::clusterBX(l1t::CaloTowerBxCollection const& inputs,
+                                          int const bx,
+                                          Workspace& workspace,
+                                          std::vector<l1t::Jet::LorentzVector>& jetP4s) const {
+  auto& fjClustering = workspace.fjClustering;
+  auto& latticeClustering = workspace.latticeClustering;
+  auto& fjJetP4s = workspace.fjJetP4s;
+  auto& latticeJetP4s = workspace.latticeJetP4s;
+
+  auto const runFastJet = (backend_ == Backend::FastJet or compareBackends_);
+  auto const runLattice = (backend_ == Backend::Lattice or compareBackends_);
+
+  auto const bufferCapacity = workspace.bufferCapacity();
+
+  fjJetP4s.clear();
+  latticeJetP4s.clear();
+
+  auto& preSelector = workspace.preSelector;
+  preSelector.select(inputs, bx);
+
+  if (preSelector.nInvalidHwEta() + preSelector.nInvalidHwPhi() > 0) {
+    workspace.invalidTowers.addBX(preSelector.nInvalidHwEta(), preSelector.nInvalidHwPhi());
+    LogTrace("L1TCaloTowerAKJetProducer")
+        << "[L1TCaloTowerAKJetProducer] BX=" << bx << " CaloTowers not used for jet clustering: invalid hwEta="
+        << preSelector.nInvalidHwEta() << ", invalid hwPhi=" << preSelector.nInvalidHwPhi();
+  }
+
+  // the clustering is timed only when the backends are compared
+  using Clock = std::chrono::steady_clock;
+
+  std::chrono::nanoseconds timeFastJet{0};
+  if (runFastJet) {
+    auto const startTime = compareBackends_ ? Clock::now() : Clock::time_point{};
+
+    fjClustering.run(preSelector, inputs, bx);
+    ++workspace.nClusterSequences;
+
+    for (auto const& fjJet : fjClustering.inclusiveJets(jetPtMin_)) {
+      fjJetP4s.emplace_back(fjJet.px, fjJet.py, fjJet.pz, fjJet.E);
+    }
+
+    if (compareBackends_) {
+      timeFastJet = Clock::now() - startTime;
+      timeFastJetNs_ += timeFastJet.count();
+    }
+  }
+
+  std::chrono::nanoseconds timeLattice{0};
+  bool onLattice{false};
+  if (runLattice) {
+    auto const startTime = compareBackends_ ? Clock::now() : Clock::time_point{};
+
+    // BXs with an ambiguous recombination are clustered with fastjet::ClusterSequence
+    latticeClustering.run(preSelector, inputs, bx);
+    onLattice = latticeClustering.clusteredOnLattice();
+    if (not onLattice) {
+      ++workspace.nClusterSequences;
+    }
+
+    for (auto const& latticeJet : latticeClustering.inclusiveJets(jetPtMin_)) {
+      latticeJetP4s.emplace_back(latticeJet.px, latticeJet.py, latticeJet.pz, latticeJet.E);
+    }
+
+    if (compareBackends_) {
+      timeLattice = Clock::now() - startTime;
+      timeLatticeNs_ += timeLattice.count();
+    }
+  }
+
+  if (compareBackends_) {
+    ++nComparedBXs_;
+
+    auto const identical = std::equal(
+        fjJetP4s.begin(), fjJetP4s.end(), latticeJetP4s.begin(), latticeJetP4s.end(), [](auto const& p4a, auto const& p4b) {
+          return p4a.px() == p4b.px() and p4a.py() == p4b.py() and p4a.pz() == p4b.pz() and p4a.E() == p4b.E();
+        });
+
+    LogTrace("L1TCaloTowerAKJetProducer")
+        << "[L1TCaloTowerAKJetProducer] BX=" << bx << " towers=" << workspace.preSelector.indices().size()
+        << " time(us): FastJet=" << 1e-3 * timeFastJet.count() << " Lattice=" << 1e-3 * timeLattice.count()
+        << " clustered on the lattice=" << onLattice << " identical=" << identical;
+
+    if (not identical) {
+      ++nMismatchedBXs_;
+      edm::LogWarning("L1TCaloTowerAKJetProducer")
+          << "different jets from FastJet and Lattice backends in BX=" << bx << " (number of jets: FastJet="
+          << fjJetP4s.size() << ", Lattice=" << latticeJetP4s.size() << ")";
+    }
+  }
+
+  auto const& selectedJetP4s = (backend_ == Backend::Lattice) ? latticeJetP4s : fjJetP4s;
+  jetP4s.assign(selectedJetP4s.begin(), selectedJetP4s.end());
+
+  if (workspace.bufferCapacity() > bufferCapacity) {
+    ++workspace.nAllocations;
+  }
+}
+
+void L1TCaloTowerAKJetProducer::endJob() {
+  if (not compareBackends_) {
+    return;
+  }
+
+  auto const nBXs = nComparedBXs_.load();
+  auto const timePerBX = [nBXs](unsigned long long const timeNs) { return (nBXs > 0) ? (1e-3 * timeNs / nBXs) : 0.; };
+
+  edm::LogInfo("L1TCaloTowerAKJetProducer")
+      << "[" << moduleDescription().moduleLabel() << "] comparison of clustering backends: BXs=" << nBXs
+      << ", BXs with different jets=" << nMismatchedBXs_.load() << ", mean time per BX (us): FastJet="
+      << timePerBX(timeFastJetNs_.load()) << ", Lattice=" << timePerBX(timeLatticeNs_.load());
 }
 
 void L1TCaloTowerAKJetProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
@@ -109,6 +357,16 @@ void L1TCaloTowerAKJetProducer::fillDescriptions(edm::ConfigurationDescriptions&
   desc.add<double>("rParam", 0.4)->setComment("R parameter for anti-kT clustering with FastJet");
   desc.add<double>("jetPtMin", 0)
       ->setComment("Minimum pT of output jets (argument of fastjet::ClusterSequence::inclusive_jets)");
+  desc.add<std::string>("backend", "FastJet")
+      ->setComment(
+          "Clustering backend: \"FastJet\" (fastjet::ClusterSequence) or \"Lattice\" (LatticeAntiKtClustering, "
+          "same jets as FastJet, BXs with ambiguous recombinations are clustered with fastjet::ClusterSequence)");
+  desc.add<bool>("compareBackends", false)
+      ->setComment("Run both clustering backends, compare their jets and report their timing (output jets from \"backend\")");
+  desc.add<bool>("concurrentBXs", false)
+      ->setComment("Cluster the BXs of one event concurrently with TBB tasks (the output does not depend on this option)");
+  desc.add<bool>("produceSoA", false)
+      ->setComment("Also produce the jets as a JetSoABxCollection (product instance label: \"SoA\")");
 
   descriptions.add("l1tCaloTowerAKJetProducer", desc);
 }
@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1Scouting/interface/L1ScoutingCaloTower.h"
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerWindowMasks.h"
+#include "L1ScoutingTools/Reconstruction/interface/EtSumBxArray.h"
+
+namespace l1tCaloTowerEtSumsProducer {
+  // per-stream buffers, re-used across events
+  struct Workspace {
+    // ET, Ex and Ey sums of every configuration in one BX
+    std::vector<double> et;
+    std::vector<double> ex;
+    std::vector<double> ey;
+
+    // towers not used because of invalid lattice coordinates (reset at the end of every lumi)
+    CaloTowerPreSelector::InvalidTowerCounts invalidTowers;
+  };
+}  // namespace l1tCaloTowerEtSumsProducer
+
+// Scalar ET and missing ET of the CaloL1 towers of every BX, for several (hwPt, |hwEta|) windows of the towers
+// ("configurations"), computed in one pass over the towers of every BX (type: EtSumBxArray, one product per
+// configuration, product instance label: label of the configuration).
+//  - ET of a tower from the CaloTowerLUT, Ex and Ey from the cos(phi) and sin(phi) tables of the CaloTowerLUT.
+//  - The configurations containing a tower are given by the bitmask lookup tables of CaloTowerWindowMasks
+//    (same as L1TCaloTowerMultiWindowMultiplicityProducer).
+//  - Towers with invalid hwEta or hwPhi values are not used (and are reported at the end of every lumi).
+// T: type of the input tower collection
+//  - l1t::CaloTowerBxCollection: BXs [bxMin, bxMax] of every event,
+//  - l1ScoutingRun3::CaloTowerOrbitCollection: all BXs of the orbit ([0, NBX], BXs without towers are skipped).
+template <typename T>
+class L1TCaloTowerEtSumsProducerT
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerEtSumsProducer::Workspace>,
+                                     edm::LuminosityBlockSummaryCache<CaloTowerPreSelector::InvalidTowerCounts>> {
+public:
+  explicit L1TCaloTowerEtSumsProducerT(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  using Workspace = l1tCaloTowerEtSumsProducer::Workspace;
+  using InvalidTowerCounts = CaloTowerPreSelector::InvalidTowerCounts;
+  static constexpr unsigned int kMaxConfigs = CaloTowerWindowMasks::kMaxWindows;
+  static constexpr bool kIsOrbit = std::is_same_v<T, l1ScoutingRun3::CaloTowerOrbitCollection>;
+
+  struct Config {
+    std::string label;
+    edm::EDPutTokenT<EtSumBxArray> putToken;
+  };
+
+  std::unique_ptr<Workspace> beginStream(edm::StreamID) const override;
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  std::shared_ptr<InvalidTowerCounts> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const override;
+  void streamEndLuminosityBlockSummary(edm::StreamID,
+                                       edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+
+  // sums of the towers of one BX, stored in BX bx of every output array
+  void sumBX(T const&, int bx, Workspace&, std::vector<EtSumBxArray>&) const;
+
+  static int hwPt(l1t::CaloTower const& tower) { return tower.hwPt(); }
+  static int hwPt(l1ScoutingRun3::CaloTower const& tower) { return tower.hwEt(); }
+
+  static unsigned int nTowers(l1t::CaloTowerBxCollection const& inputs, int const bx) { return inputs.size(bx); }
+  static unsigned int nTowers(l1ScoutingRun3::CaloTowerOrbitCollection const& inputs, int const bx) {
+    return inputs.getBxSize(bx);
+  }
+
+  static auto const& tower(l1t::CaloTowerBxCollection const& inputs, int const bx, unsigned int const idx) {
+    return inputs.at(bx, idx);
+  }
+  static auto const& tower(l1ScoutingRun3::CaloTowerOrbitCollection const& inputs,
+                           int const bx,
+                           unsigned int const idx) {
+    return inputs.getBxObject(bx, idx);
+  }
+
+  edm::EDGetTokenT<T> const srcToken_;
+  int const bxMin_;
+  int const bxMax_;
+  CaloTowerLUT const& lut_;
+
+  std::vector<Config> configs_;
+
+  // configurations containing a tower (bit i: i-th configuration)
+  CaloTowerWindowMasks configMasks_;
+};
+
+template <typename T>
+L1TCaloTowerEtSumsProducerT<T>::L1TCaloTowerEtSumsProducerT(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      bxMin_{kIsOrbit ? 0 : iConfig.getParameter<int>("bxMin")},
+      bxMax_{kIsOrbit ? l1ScoutingRun3::CaloTowerOrbitCollection::NBX : iConfig.getParameter<int>("bxMax")},
+      lut_{CaloTowerLUT::get()} {
+  if (bxMin_ > bxMax_) {
+    throw cms::Exception("Configuration")
+        << "invalid values for parameters \"bxMin\" and \"bxMax\" (bxMin must not be larger than bxMax): bxMin="
+        << bxMin_ << ", bxMax=" << bxMax_;
+  }
+
+  std::set<std::string> labels;
+  std::vector<CaloTowerWindowMasks::Window> windows;
+  for (auto const& pset : iConfig.getParameterSetVector("configs")) {
+    auto& config = configs_.emplace_back(Config{pset.getParameter<std::string>("label"), {}});
+    windows.emplace_back(CaloTowerWindowMasks::Window{pset.getParameter<int>("towerMinHwPt"),
+                                                      pset.getParameter<int>("towerMaxHwPt"),
+                                                      pset.getParameter<int>("towerMinAbsHwEta"),
+                                                      pset.getParameter<int>("towerMaxAbsHwEta")});
+
+    if (config.label.empty() or not labels.insert(config.label).second) {
+      throw cms::Exception("Configuration")
+          << "invalid value for parameter \"label\" of \"configs\" (must be non-empty and unique): \"" << config.label
+          << "\"";
+    }
+
+    config.putToken = produces<EtSumBxArray>(config.label);
+  }
+
+  if (configs_.empty() or configs_.size() > kMaxConfigs) {
+    throw cms::Exception("Configuration") << "invalid value for parameter \"configs\" (at least 1, and at most "
+                                          << kMaxConfigs << " configurations): " << configs_.size()
+                                          << " configurations";
+  }
+
+  configMasks_ = CaloTowerWindowMasks{windows};
+}
+
+template <typename T>
+std::unique_ptr<l1tCaloTowerEtSumsProducer::Workspace> L1TCaloTowerEtSumsProducerT<T>::beginStream(
+    edm::StreamID) const {
+  auto workspace = std::make_unique<Workspace>();
+  workspace->et.resize(configs_.size());
+  workspace->ex.resize(configs_.size());
+  workspace->ey.resize(configs_.size());
+  return workspace;
+}
+
+template <typename T>
+std::shared_ptr<CaloTowerPreSelector::InvalidTowerCounts>
+L1TCaloTowerEtSumsProducerT<T>::globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                  edm::EventSetup const&) const {
+  return std::make_shared<InvalidTowerCounts>();
+}
+
+template <typename T>
+void L1TCaloTowerEtSumsProducerT<T>::streamEndLuminosityBlockSummary(edm::StreamID streamID,
+                                                                     edm::LuminosityBlock const&,
+                                                                     edm::EventSetup const&,
+                                                                     InvalidTowerCounts* summary) const {
+  auto& workspace = *this->streamCache(streamID);
+  summary->take(workspace.invalidTowers);
+}
+
+template <typename T>
+void L1TCaloTowerEtSumsProducerT<T>::globalEndLuminosityBlockSummary(edm::LuminosityBlock const& iLumi,
+                                                                     edm::EventSetup const&,
+                                                                     InvalidTowerCounts* summary) const {
+  summary->report("L1TCaloTowerEtSumsProducer", this->moduleDescription().moduleLabel(), iLumi, "the ET sums");
+}
+
+template <typename T>
+void L1TCaloTowerEtSumsProducerT<T>::produce(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  auto& workspace = *this->streamCache(streamID);
+
+  std::vector<EtSumBxArray> sums(configs_.size(), EtSumBxArray{bxMin_, bxMax_});
+
+  // BXs without towers keep zero sums
+  unsigned int nFilledBXs{0};
+  for (auto bx = bxMin_; bx <= bxMax_; ++bx) {
+    if constexpr (not kIsOrbit) {
+      if (bx < inputs.getFirstBX() or bx > inputs.getLastBX()) {
+        continue;
+      }
+    }
+
+    if (nTowers(inputs, bx) > 0) {
+      sumBX(inputs, bx, workspace, sums);
+      ++nFilledBXs;
+    }
+  }
+
+  LogTrace("L1TCaloTowerEtSumsProducer") << "[L1TCaloTowerEtSumsProducer] [" << this->moduleDescription().moduleLabel()
+                                         << "] BXs [" << bxMin_ << ", " << bxMax_ << "], BXs with towers: "
+                                         << nFilledBXs << ", configurations: " << configs_.size();
+
+  for (auto icfg = 0u; icfg < configs_.size(); ++icfg) {
+    iEvent.emplace(configs_[icfg].putToken, std::move(sums[icfg]));
+  }
+}
+
+template <typename T>
+void L1TCaloTowerEtSumsProducerT<T>::sumBX(T const& inputs,
+                                           int const bx,
+                                           Workspace& workspace,
+                                           std::vector<EtSumBxArray>& sums) const {
+  auto& et = workspace.et;
+  auto& ex = workspace.ex;
+  auto& ey = workspace.ey;
+  std::fill(et.begin(), et.end(), 0.);
+  std::fill(ex.begin(), ex.end(), 0.);
+  std::fill(ey.begin(), ey.end(), 0.);
+
+  unsigned int nInvalidHwEta{0};
+  unsigned int nInvalidHwPhi{0};
+
+  auto const nInputs = nTowers(inputs, bx);
+  for (auto idx = 0u; idx < nInputs; ++idx) {
+    auto const& input = tower(inputs, bx, idx);
+    auto const towerHwPt = hwPt(input);
+    auto const hwEta = input.hwEta();
+    auto const hwPhi = input.hwPhi();
+
+    auto mask = configMasks_.mask(towerHwPt, hwEta);
+
+    if (mask == 0) {
+      continue;
+    }
+
+    if (not lut_.validHwEta(hwEta)) {
+      ++nInvalidHwEta;
+      continue;
+    }
+
+    if (not lut_.validHwPhi(hwPhi)) {
+      ++nInvalidHwPhi;
+      continue;
+    }
+
+    double const towerEt = lut_.et(towerHwPt);
+    double const towerEx = towerEt * lut_.cosPhi(hwPhi);
+    double const towerEy = towerEt * lut_.sinPhi(hwPhi);
+
+    for (; mask != 0; mask &= mask - 1) {
+      auto const icfg = std::countr_zero(mask);
+      et[icfg] += towerEt;
+      ex[icfg] += towerEx;
+      ey[icfg] += towerEy;
+    }
+  }
+
+  workspace.invalidTowers.addBX(nInvalidHwEta, nInvalidHwPhi);
+
+  // missing ET: minus the vector sum of the tower ETs
+  for (auto icfg = 0u; icfg < configs_.size(); ++icfg) {
+    sums[icfg].set(bx, et[icfg], -ex[icfg], -ey[icfg]);
+  }
+}
+
+template <typename T>
+void L1TCaloTowerEtSumsProducerT<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  if constexpr (kIsOrbit) {
+    desc.add<edm::InputTag>("src")->setComment("Input product (type: l1ScoutingRun3::CaloTowerOrbitCollection)");
+  } else {
+    desc.add<edm::InputTag>("src")->setComment("Input product (type: l1t::CaloTowerBxCollection)");
+    desc.add<int>("bxMin", 0)->setComment("Min BX (inclusive)");
+    desc.add<int>("bxMax", 0)->setComment("Max BX (inclusive)");
+  }
+
+  edm::ParameterSetDescription configDesc;
+  configDesc.add<std::string>("label")
+      ->setComment("Product instance label of the ET sums of the configuration (type: EtSumBxArray)");
+  configDesc.add<int>("towerMinHwPt", -1)->setComment("Min hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
+  configDesc.add<int>("towerMaxHwPt", -1)->setComment("Max hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
+  configDesc.add<int>("towerMinAbsHwEta", -1)
+      ->setComment("Min |hwEta| (inclusive) of l1t::CaloTowers (ignored if negative)");
+  configDesc.add<int>("towerMaxAbsHwEta", -1)
+      ->setComment("Max |hwEta| (inclusive) of l1t::CaloTowers (ignored if negative)");
+
+  desc.addVPSet("configs", configDesc, {})
+      ->setComment("Windows in (hwPt, |hwEta|) of the l1t::CaloTowers used for the ET sums (at least 1, at most 64)");
+
+  descriptions.add(kIsOrbit ? "l1tCaloTowerOrbitEtSumsProducer" : "l1tCaloTowerEtSumsProducer", desc);
+}
+
+using L1TCaloTowerEtSumsProducer = L1TCaloTowerEtSumsProducerT<l1t::CaloTowerBxCollection>;
+using L1TCaloTowerOrbitEtSumsProducer = L1TCaloTowerEtSumsProducerT<l1ScoutingRun3::CaloTowerOrbitCollection>;
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TCaloTowerEtSumsProducer);
+DEFINE_FWK_MODULE(L1TCaloTowerOrbitEtSumsProducer);
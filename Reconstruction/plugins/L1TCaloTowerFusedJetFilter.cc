@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDFilter.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+#include "L1ScoutingTools/Reconstruction/interface/L1ScoutingJetCorrectorRcd.h"
+#include "L1ScoutingTools/Reconstruction/interface/PUProxyBxArray.h"
+
+namespace l1tCaloTowerFusedJetFilter {
+  // per-stream buffers, re-used across BXs and events
+  struct Workspace {
+    Workspace(caloTowerJetClustering::Backend const backend,
+              double const rParam,
+              int const towerMinHwPt,
+              int const towerMaxHwPt)
+        : preSelector{towerMinHwPt, towerMaxHwPt}, clustering{backend, rParam} {}
+
+    CaloTowerPreSelector preSelector;
+    caloTowerJetClustering::Clustering clustering;
+
+    // uncorrected jets of all BXs (the jets of BX bxMin+i start at bxOffsets[i]), their pT and eta, and their JECs
+    std::vector<l1t::Jet::LorentzVector> jetP4s;
+    std::vector<unsigned int> bxOffsets;
+    std::vector<float> pts;
+    std::vector<float> etas;
+    std::vector<double> corrs;
+
+    // buffers of the batch interface of JetCorrector
+    JetCorrector::Workspace jetCorrectorWorkspace;
+
+    // PU proxy of every BX
+    std::vector<int> puProxies;
+
+    // corrected pT and index of the jets of one BX
+    std::vector<std::pair<double, unsigned int>> sortKeys;
+
+    // towers rejected because of invalid lattice coordinates (reset at the end of every lumi)
+    CaloTowerPreSelector::InvalidTowerCounts invalidTowers;
+  };
+}  // namespace l1tCaloTowerFusedJetFilter
+
+// Anti-kT CaloTower jets, jet-energy-scale corrections and kinematic selection in one module:
+// same jets as L1TCaloTowerAKJetProducer -> L1TCaloTowerJetCorrectorB/C, and same decision as L1TJetKinematicsFilter
+// on the corrected jets, without the intermediate l1t::JetBxCollection of uncorrected jets and without a separate
+// loop over the corrected jets for the selection.
+class L1TCaloTowerFusedJetFilter
+    : public edm::global::EDFilter<edm::StreamCache<l1tCaloTowerFusedJetFilter::Workspace>,
+                                   edm::LuminosityBlockSummaryCache<CaloTowerPreSelector::InvalidTowerCounts>> {
+public:
+  explicit L1TCaloTowerFusedJetFilter(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  using Workspace = l1tCaloTowerFusedJetFilter::Workspace;
+  using InvalidTowerCounts = CaloTowerPreSelector::InvalidTowerCounts;
+  using SortKeys = std::vector<std::pair<double, unsigned int>>;
+
+  using Backend = caloTowerJetClustering::Backend;
+
+  std::unique_ptr<Workspace> beginStream(edm::StreamID) const override;
+  bool filter(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  std::shared_ptr<InvalidTowerCounts> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const override;
+  void streamEndLuminosityBlockSummary(edm::StreamID,
+                                       edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+
+  // append the uncorrected jets of one BX to workspace.jetP4s
+  void clusterBX(l1t::CaloTowerBxCollection const&, int bx, Workspace&) const;
+
+  // leading maxJetsPerBx jets of one BX in order of decreasing corrected pT (first nOutputs entries of the keys)
+  unsigned int sortJets(SortKeys&) const;
+
+  // single precision, as L1TJetKinematicsFilter
+  bool selected(float const pt, float const eta) const {
+    auto const absEta = std::abs(eta);
+    return (selAbsEtaMin_ < 0 or absEta > selAbsEtaMin_) and (selAbsEtaMax_ < 0 or absEta < selAbsEtaMax_) and
+           pt > selPtMin_;
+  }
+
+  edm::EDGetTokenT<l1t::CaloTowerBxCollection> const srcToken_;
+  bool const puProxyPerBx_;
+  edm::EDGetTokenT<int> puProxyToken_;
+  edm::EDGetTokenT<PUProxyBxArray> puProxyPerBxToken_;
+  edm::ESGetToken<JetCorrector, L1ScoutingJetCorrectorRcd> const jetCorrectorToken_;
+  int const bxMin_;
+  int const bxMax_;
+  int const towerMinHwPt_;
+  int const towerMaxHwPt_;
+  double const rParam_;
+  double const jetPtMin_;
+  Backend const backend_;
+  int const maxJetsPerBx_;
+  int const selBxMin_;
+  int const selBxMax_;
+  int const selNMin_;
+  float const selPtMin_;
+  float const selAbsEtaMin_;
+  float const selAbsEtaMax_;
+  bool const produceSoA_;
+
+  edm::EDPutTokenT<l1t::JetBxCollection> const putToken_;
+  edm::EDPutTokenT<JetSoABxCollection> soaPutToken_;
+};
+
+L1TCaloTowerFusedJetFilter::L1TCaloTowerFusedJetFilter(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      puProxyPerBx_{iConfig.getParameter<bool>("puProxyPerBx")},
+      jetCorrectorToken_{esConsumes(iConfig.getParameter<edm::ESInputTag>("jetCorrector"))},
+      bxMin_{iConfig.getParameter<int>("bxMin")},
+      bxMax_{iConfig.getParameter<int>("bxMax")},
+      towerMinHwPt_{iConfig.getParameter<int>("towerMinHwPt")},
+      towerMaxHwPt_{iConfig.getParameter<int>("towerMaxHwPt")},
+      rParam_{iConfig.getParameter<double>("rParam")},
+      jetPtMin_{iConfig.getParameter<double>("jetPtMin")},
+      backend_{caloTowerJetClustering::backend(iConfig.getParameter<std::string>("backend"))},
+      maxJetsPerBx_{iConfig.getParameter<int>("maxJetsPerBx")},
+      selBxMin_{iConfig.getParameter<edm::ParameterSet>("selection").getParameter<int>("bxMin")},
+      selBxMax_{iConfig.getParameter<edm::ParameterSet>("selection").getParameter<int>("bxMax")},
+      selNMin_{iConfig.getParameter<edm::ParameterSet>("selection").getParameter<int>("nMin")},
+      selPtMin_{float(iConfig.getParameter<edm::ParameterSet>("selection").getParameter<double>("ptMin"))},
+      selAbsEtaMin_{float(iConfig.getParameter<edm::ParameterSet>("selection").getParameter<double>("absEtaMin"))},
+      selAbsEtaMax_{float(iConfig.getParameter<edm::ParameterSet>("selection").getParameter<double>("absEtaMax"))},
+      produceSoA_{iConfig.getParameter<bool>("produceSoA")},
+      putToken_{produces<l1t::JetBxCollection>()} {
+  if (puProxyPerBx_) {
+    puProxyPerBxToken_ = consumes(iConfig.getParameter<edm::InputTag>("puProxy"));
+  } else {
+    puProxyToken_ = consumes(iConfig.getParameter<edm::InputTag>("puProxy"));
+  }
+
+  if (produceSoA_) {
+    soaPutToken_ = produces<JetSoABxCollection>("SoA");
+  }
+}
+
+std::unique_ptr<L1TCaloTowerFusedJetFilter::Workspace> L1TCaloTowerFusedJetFilter::beginStream(edm::StreamID) const {
+  return std::make_unique<Workspace>(backend_, rParam_, towerMinHwPt_, towerMaxHwPt_);
+}
+
+std::shared_ptr<L1TCaloTowerFusedJetFilter::InvalidTowerCounts> L1TCaloTowerFusedJetFilter::globalBeginLuminosityBlockSummary(
+    edm::LuminosityBlock const&, edm::EventSetup const&) const {
+  return std::make_shared<InvalidTowerCounts>();
+}
+
+void L1TCaloTowerFusedJetFilter::streamEndLuminosityBlockSummary(edm::StreamID streamID,
+                                                                 edm::LuminosityBlock const&,
+                                                                 edm::EventSetup const&,
+                                                                 InvalidTowerCounts* summary) const {
+  auto& workspace = *streamCache(streamID);
+  summary->take(workspace.invalidTowers);
+}
+
+void L1TCaloTowerFusedJetFilter::globalEndLuminosityBlockSummary(edm::LuminosityBlock const& iLumi,
+                                                                 edm::EventSetup const&,
+                                                                 InvalidTowerCounts* summary) const {
+  summary->report("L1TCaloTowerFusedJetFilter", moduleDescription().moduleLabel(), iLumi, "jet clustering");
+}
+
+bool L1TCaloTowerFusedJetFilter::filter(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const& iSetup) const {
+  auto const& inputs = iEvent.get(srcToken_);
+  auto const& jetCorrector = iSetup.getData(jetCorrectorToken_);
+
+  auto& workspace = *streamCache(streamID);
+
+  auto const bxMin = std::max(bxMin_, inputs.getFirstBX());
+  auto const bxMax = std::min(bxMax_, inputs.getLastBX());
+
+  // PU proxy of every BX (the same for all BXs, unless puProxyPerBx)
+  auto& puProxies = workspace.puProxies;
+  puProxies.assign(std::max(0, bxMax - bxMin + 1), 0);
+  if (puProxyPerBx_) {
+    auto const& puProxyPerBx = iEvent.get(puProxyPerBxToken_);
+    for (auto bx = bxMin; bx <= bxMax; ++bx) {
+      puProxies[bx - bxMin] = puProxyPerBx.at(bx);
+    }
+  } else {
+    std::fill(puProxies.begin(), puProxies.end(), iEvent.get(puProxyToken_));
+  }
+
+  // uncorrected jets of all BXs
+  workspace.jetP4s.clear();
+  workspace.bxOffsets.clear();
+  for (auto bx = bxMin; bx <= bxMax; ++bx) {
+    workspace.bxOffsets.emplace_back(workspace.jetP4s.size());
+    clusterBX(inputs, bx, workspace);
+  }
+  workspace.bxOffsets.emplace_back(workspace.jetP4s.size());
+
+  // corrections of the jets of all BXs, in one batch per run of consecutive BXs with the same PU proxy
+  auto const nJets = workspace.jetP4s.size();
+  workspace.pts.resize(nJets);
+  workspace.etas.resize(nJets);
+  workspace.corrs.resize(nJets);
+  for (auto ijet = 0u; ijet < nJets; ++ijet) {
+    workspace.pts[ijet] = workspace.jetP4s[ijet].pt();
+    workspace.etas[ijet] = workspace.jetP4s[ijet].eta();
+  }
+  jetCorrector.corrections(workspace.pts,
+                           workspace.etas,
+                           puProxies,
+                           workspace.bxOffsets,
+                           workspace.corrs,
+                           workspace.jetCorrectorWorkspace);
+
+  l1t::JetBxCollection output(0, bxMin, bxMax);
+
+  JetSoABxCollection soaOutput;
+  if (produceSoA_) {
+    soaOutput = JetSoABxCollection(bxMin, bxMax);
+  }
+
+  // corrected jets in order of decreasing pT, and number of corrected jets passing the selection
+  int nSelected{0};
+  for (auto bx = bxMin; bx <= bxMax; ++bx) {
+    auto const first = workspace.bxOffsets[bx - bxMin];
+    auto const last = workspace.bxOffsets[bx - bxMin + 1];
+
+    auto& sortKeys = workspace.sortKeys;
+    sortKeys.clear();
+    for (auto ijet = first; ijet < last; ++ijet) {
+      auto const corr = workspace.corrs[ijet];
+      if (corr > 0) {
+        sortKeys.emplace_back((workspace.jetP4s[ijet] * corr).pt(), ijet);
+      }
+    }
+
+    auto const nOutputs = sortJets(sortKeys);
+    auto const inSelectedBXs = (bx >= selBxMin_ and bx <= selBxMax_);
+
+    for (auto ikey = 0u; ikey < nOutputs; ++ikey) {
+      auto const ijet = sortKeys[ikey].second;
+      l1t::Jet jet{workspace.jetP4s[ijet] * workspace.corrs[ijet]};
+
+      if (inSelectedBXs) {
+        nSelected += selected(jet.pt(), jet.eta());
+      }
+
+      if (produceSoA_) {
+        soaOutput.push_back(bx, jet.pt(), jet.eta(), jet.phi(), jet.mass());
+      }
+
+      output.push_back(bx, std::move(jet));
+    }
+  }
+
+  auto const accept = (nSelected >= selNMin_);
+
+  LogTrace("L1TCaloTowerFusedJetFilter") << "[L1TCaloTowerFusedJetFilter] [" << moduleDescription().moduleLabel()
+                                         << "] jets=" << output.size() << ", selected jets=" << nSelected
+                                         << ", accept=" << accept;
+
+  iEvent.emplace(putToken_, std::move(output));
+
+  if (produceSoA_) {
+    soaOutput.finalize();
+    iEvent.emplace(soaPutToken_, std::move(soaOutput));
+  }
+
+  return accept;
+}
+
+void L1TCaloTowerFusedJetFilter::clusterBX(l1t::CaloTowerBxCollection const& inputs,
+                                           int const bx,
+                                           Workspace& workspace) const {
+  auto& preSelector = workspace.preSelector;
+  preSelector.select(inputs, bx);
+
+  if (preSelector.nInvalidHwEta() + preSelector.nInvalidHwPhi() > 0) {
+    workspace.invalidTowers.addBX(preSelector.nInvalidHwEta(), preSelector.nInvalidHwPhi());
+  }
+
+  auto& clustering = workspace.clustering;
+  clustering.run(preSelector, inputs, bx);
+
+  for (auto const& jet : clustering.inclusiveJets(jetPtMin_)) {
+    workspace.jetP4s.emplace_back(jet.px, jet.py, jet.pz, jet.E);
+  }
+}
+
+unsigned int L1TCaloTowerFusedJetFilter::sortJets(SortKeys& sortKeys) const {
+  // same order as L1TCaloTowerJetCorrectorB/C (ties: increasing index)
+  auto const byDecreasingPt = [](auto const& key1, auto const& key2) {
+    return key1.first > key2.first or (key1.first == key2.first and key1.second < key2.second);
+  };
+
+  auto const nOutputs = (maxJetsPerBx_ < 0) ? sortKeys.size() : std::min(sortKeys.size(), std::size_t(maxJetsPerBx_));
+  auto const sortKeysEnd = sortKeys.begin() + nOutputs;
+  if (sortKeysEnd != sortKeys.end()) {
+    std::nth_element(sortKeys.begin(), sortKeysEnd, sortKeys.end(), byDecreasingPt);
+  }
+  std::sort(sortKeys.begin(), sortKeysEnd, byDecreasingPt);
+
+  return nOutputs;
+}
+
+void L1TCaloTowerFusedJetFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input product for CaloTowers (type: l1t::CaloTowerBxCollection)");
+  desc.add<int>("bxMin", -2)->setComment("Min BX (inclusive)");
+  desc.add<int>("bxMax", 2)->setComment("Max BX (inclusive)");
+
+  // L1TCaloTowerAKJetProducer
+  desc.add<int>("towerMinHwPt", 1)
+      ->setComment("Min hwPt (inclusive) of l1t::CaloTowers used for jet clustering (ignored if negative)");
+  desc.add<int>("towerMaxHwPt", -1)
+      ->setComment("Max hwPt (inclusive) of l1t::CaloTowers used for jet clustering (ignored if negative)");
+  desc.add<double>("rParam", 0.4)->setComment("R parameter for anti-kT clustering");
+  desc.add<double>("jetPtMin", 0)
+      ->setComment("Minimum pT of uncorrected jets (argument of fastjet::ClusterSequence::inclusive_jets)");
+  desc.add<std::string>("backend", "FastJet")
+      ->setComment(
+          "Clustering backend: \"FastJet\" (fastjet::ClusterSequence) or \"Lattice\" (LatticeAntiKtClustering, "
+          "same jets as FastJet, BXs with ambiguous recombinations are clustered with fastjet::ClusterSequence)");
+
+  // L1TCaloTowerJetCorrectorB/C
+  desc.add<edm::InputTag>("puProxy")
+      ->setComment("Input product for PU-proxy value (type: int, or PUProxyBxArray if puProxyPerBx is true)");
+  desc.add<bool>("puProxyPerBx", false)
+      ->setComment(
+          "Correct the jets of every BX with the PU proxy of that BX (from a PUProxyBxArray, e.g. the \"PerBx\" "
+          "product of L1TCaloTowerMultiplicityProducer), instead of one PU-proxy value for all BXs");
+  desc.add<edm::ESInputTag>("jetCorrector", edm::ESInputTag("", ""))
+      ->setComment("EventSetup product for jet-energy-scale corrections (type: JetCorrector, record: L1ScoutingJetCorrectorRcd)");
+  desc.add<int>("maxJetsPerBx", -1)
+      ->setComment("Max number of jets per BX, in order of decreasing corrected pT (if negative, all jets are kept)");
+
+  // L1TJetKinematicsFilter
+  edm::ParameterSetDescription selectionDesc;
+  selectionDesc.add<int>("bxMin", 0)->setComment("Min BX (inclusive)");
+  selectionDesc.add<int>("bxMax", 0)->setComment("Max BX (inclusive)");
+  selectionDesc.add<int>("nMin", 0)
+      ->setComment("Min number of corrected jets required to pass pT and |eta| selections (inclusive)");
+  selectionDesc.add<double>("ptMin", 1)->setComment("Min corrected jet pT");
+  selectionDesc.add<double>("absEtaMin", -1)->setComment("Min jet |eta| (ignored if negative)");
+  selectionDesc.add<double>("absEtaMax", -1)->setComment("Max jet |eta| (ignored if negative)");
+  desc.add<edm::ParameterSetDescription>("selection", selectionDesc)
+      ->setComment("Selection of the corrected jets for the filter decision (if nMin is not positive, every event is accepted)");
+
+  desc.add<bool>("produceSoA", false)
+      ->setComment("Also produce the corrected jets as a JetSoABxCollection (product instance label: \"SoA\")");
+
+  descriptions.add("l1tCaloTowerFusedJetFilter", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TCaloTowerFusedJetFilter);
@@ -1,170 +1,144 @@
 #include <algorithm>
-#include <cmath>
-#include <fstream>
 #include <memory>
-#include <numeric>
-#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "CommonTools/Utils/interface/FormulaEvaluator.h"
 #include "DataFormats/L1Trigger/interface/Jet.h"
 #include "FWCore/Framework/interface/global/EDProducer.h"
 #include "FWCore/Framework/interface/Event.h"
-#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
 #include "FWCore/Utilities/interface/Exception.h"
-#include "FWCore/Utilities/interface/FileInPath.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetBxCorrection.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+#include "L1ScoutingTools/Reconstruction/interface/L1ScoutingJetCorrectorRcd.h"
+#include "L1ScoutingTools/Reconstruction/interface/PUProxyBxArray.h"
+
+namespace l1tCaloTowerJetCorrectorB {
+  // per-stream buffers, re-used across events
+  struct Workspace {
+    Workspace(std::string logCategory, int const maxJetsPerBx)
+        : jetBxCorrection{std::move(logCategory), maxJetsPerBx} {}
+
+    JetBxCorrection jetBxCorrection;
+    std::vector<double> corrs;
+  };
+}  // namespace l1tCaloTowerJetCorrectorB
 
-class L1TCaloTowerJetCorrectorB : public edm::global::EDProducer<> {
+class L1TCaloTowerJetCorrectorB
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerJetCorrectorB::Workspace>> {
 public:
   explicit L1TCaloTowerJetCorrectorB(edm::ParameterSet const&);
 
   static void fillDescriptions(edm::ConfigurationDescriptions&);
 
 private:
-  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  using Workspace = l1tCaloTowerJetCorrectorB::Workspace;
 
-  class JetCorrector {
-  public:
-    explicit JetCorrector(std::string const& filePath) {
-      ifstream infile(filePath);
-      std::string line{};
-      while (std::getline(infile, line)) {
-        std::istringstream iss(line);
-
-        float ptMin{0.f};
-        float ptMax{0.f};
-        float etaMin{0.f};
-        float etaMax{0.f};
-        int puProxyMin{0};
-        int puProxyMax{0};
-        int formNParams{0};
-        std::string formEvalStr{""};
-
-        if (!(iss >> ptMin >> ptMax >> etaMin >> etaMax >> puProxyMin >> puProxyMax >> formEvalStr >> formNParams)) {
-          throw cms::Exception("InvalidInput")
-              << "failed to read line from input file (invalid format): \"" << line << "\"";
-        }
-
-        reco::FormulaEvaluator formEval{formEvalStr};
-
-        std::vector<double> formParams(formNParams);
-        for (auto idx = 0; idx < formNParams; ++idx) {
-          if (!(iss >> formParams[idx])) {
-            throw cms::Exception("InvalidInput")
-                << "failed to read line from input file (invalid format, formula parameter #" << idx << "): \"" << line
-                << "\"";
-          }
-        }
-
-        data_.emplace_back(ptMin, ptMax, etaMin, etaMax, puProxyMin, puProxyMax, std::move(formEval), std::move(formParams));
-      }
-    }
-
-    double correction(float const pt, float const eta, int const puProxy) const {
-      for (auto const& entry : data_) {
-        if (eta >= entry.etaMin and eta < entry.etaMax and
-            (entry.puProxyMin < 0 or puProxy >= entry.puProxyMin) and
-            (entry.puProxyMax < 0 or puProxy < entry.puProxyMax)) {
-          std::vector<double> vars{std::min(std::max(pt, entry.ptMin), entry.ptMax)};
-          return entry.formulaEvaluator.evaluate(vars, entry.formulaParameters);
-        }
-      }
-      return 0;
-    }
-
-  private:
-    struct Entry {
-      float ptMin;
-      float ptMax;
-      float etaMin;
-      float etaMax;
-      int puProxyMin;
-      int puProxyMax;
-      reco::FormulaEvaluator formulaEvaluator;
-      std::vector<double> formulaParameters;
-    };
-
-    std::vector<Entry> data_;
-  };
+  std::unique_ptr<Workspace> beginStream(edm::StreamID) const override;
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
 
   edm::EDGetTokenT<l1t::JetBxCollection> const srcToken_;
-  edm::EDGetTokenT<int> const puProxyToken_;
-  JetCorrector const jetCorrector_;
+  bool const puProxyPerBx_;
+  edm::EDGetTokenT<int> puProxyToken_;
+  edm::EDGetTokenT<PUProxyBxArray> puProxyPerBxToken_;
+  edm::ESGetToken<JetCorrector, L1ScoutingJetCorrectorRcd> const jetCorrectorToken_;
   int const bxMin_;
   int const bxMax_;
+  int const maxJetsPerBx_;
+  bool const produceSoA_;
+
+  edm::EDPutTokenT<JetSoABxCollection> soaPutToken_;
 };
 
 L1TCaloTowerJetCorrectorB::L1TCaloTowerJetCorrectorB(edm::ParameterSet const& iConfig)
     : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
-      puProxyToken_{consumes(iConfig.getParameter<edm::InputTag>("puProxy"))},
-      jetCorrector_{iConfig.getParameter<edm::FileInPath>("jecFile").fullPath()},
+      puProxyPerBx_{iConfig.getParameter<bool>("puProxyPerBx")},
+      jetCorrectorToken_{esConsumes(iConfig.getParameter<edm::ESInputTag>("jetCorrector"))},
       bxMin_{iConfig.getParameter<int>("bxMin")},
-      bxMax_{iConfig.getParameter<int>("bxMax")} {
+      bxMax_{iConfig.getParameter<int>("bxMax")},
+      maxJetsPerBx_{iConfig.getParameter<int>("maxJetsPerBx")},
+      produceSoA_{iConfig.getParameter<bool>("produceSoA")} {
+  if (puProxyPerBx_) {
+    puProxyPerBxToken_ = consumes(iConfig.getParameter<edm::InputTag>("puProxy"));
+  } else {
+    puProxyToken_ = consumes(iConfig.getParameter<edm::InputTag>("puProxy"));
+  }
+
   produces<l1t::JetBxCollection>();
+  if (produceSoA_) {
+    soaPutToken_ = produces<JetSoABxCollection>("SoA");
+  }
 }
 
-void L1TCaloTowerJetCorrectorB::produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
-  auto const& inputs = iEvent.get(srcToken_);
+std::unique_ptr<L1TCaloTowerJetCorrectorB::Workspace> L1TCaloTowerJetCorrectorB::beginStream(edm::StreamID) const {
+  return std::make_unique<Workspace>("L1TCaloTowerJetCorrectorB", maxJetsPerBx_);
+}
 
-  auto const& puProxy = iEvent.get(puProxyToken_);
+void L1TCaloTowerJetCorrectorB::produce(edm::StreamID streamID,
+                                        edm::Event& iEvent,
+                                        edm::EventSetup const& iSetup) const {
+  auto const& jetCorrector = iSetup.getData(jetCorrectorToken_);
+  if (jetCorrector.formulaType() != JetCorrector::FormulaType::CorrectionFactor) {
+    throw cms::Exception("Configuration")
+        << "invalid JetCorrector (formulaType must be \"CorrectionFactor\" for L1TCaloTowerJetCorrectorB)";
+  }
+
+  auto const& inputs = iEvent.get(srcToken_);
 
   auto const bxMin = std::max(bxMin_, inputs.getFirstBX());
   auto const bxMax = std::min(bxMax_, inputs.getLastBX());
 
-  auto output = std::make_unique<l1t::JetBxCollection>(0, bxMin, bxMax);
-
-  for (auto bx = bxMin; bx <= bxMax; ++bx) {
-    auto const nInputs = inputs.size(bx);
-
-    std::vector<l1t::Jet> out_jets{};
-    out_jets.reserve(nInputs);
-    for (auto idx = 0u; idx < nInputs; ++idx) {
-      auto jet = inputs.at(bx, idx);
-      auto const corr{jetCorrector_.correction(jet.pt(), jet.eta(), puProxy)};
-
-      LogTrace("L1TCaloTowerJetCorrectorB")
-          << "[L1TCaloTowerJetCorrectorB] Jet(bx=" << bx << ", index=" << idx << ") (PU proxy = " << puProxy << ")";
+  auto& workspace = *streamCache(streamID);
+  auto& jetBxCorrection = workspace.jetBxCorrection;
 
-      LogTrace("L1TCaloTowerJetCorrectorB")
-          << "[L1TCaloTowerJetCorrectorB]    Pre -JESC: eta=" << jet.eta() << " phi=" << jet.phi()
-          << " pT(uncorrected)=" << jet.pt() << " JESC=" << corr;
-
-      jet.setP4(jet.p4() * corr);
+  // PU proxy of every BX (the same for all BXs, unless puProxyPerBx)
+  if (puProxyPerBx_) {
+    jetBxCorrection.setInputs(inputs, bxMin, bxMax, iEvent.get(puProxyPerBxToken_));
+  } else {
+    jetBxCorrection.setInputs(inputs, bxMin, bxMax, iEvent.get(puProxyToken_));
+  }
 
-      LogTrace("L1TCaloTowerJetCorrectorB") << "[L1TCaloTowerJetCorrectorB]    Post-JESC: eta=" << jet.eta()
-                                           << " phi=" << jet.phi() << " pT(corrected)=" << jet.pt();
+  // corrections of the jets of all BXs, in one batch per run of consecutive BXs with the same PU proxy
+  // (a single batch, unless puProxyPerBx)
+  jetBxCorrection.corrections(jetCorrector, workspace.corrs);
 
-      if (corr > 0) {
-        out_jets.emplace_back(std::move(jet));
-      }
-    }
+  auto output = std::make_unique<l1t::JetBxCollection>();
+  JetSoABxCollection soaOutput;
+  jetBxCorrection.correctedJets(workspace.corrs, *output, produceSoA_ ? &soaOutput : nullptr);
 
-    std::vector<size_t> sortIdxs(out_jets.size());
-    std::iota(sortIdxs.begin(), sortIdxs.end(), 0);
-    std::sort(sortIdxs.begin(), sortIdxs.end(), [&](size_t const i1, size_t const i2) {
-      return out_jets[i1].pt() > out_jets[i2].pt();
-    });
+  iEvent.put(std::move(output));
 
-    for (auto idx : sortIdxs) {
-      output->push_back(bx, out_jets[idx]);
-    }
+  if (produceSoA_) {
+    iEvent.emplace(soaPutToken_, std::move(soaOutput));
   }
-
-  iEvent.put(std::move(output));
 }
 
 void L1TCaloTowerJetCorrectorB::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
 
   desc.add<edm::InputTag>("src")->setComment("Input product for jets (type: l1t::JetBxCollection)");
-  desc.add<edm::InputTag>("puProxy")->setComment("Input product for PU-proxy value (type: int)");
-  desc.add<edm::FileInPath>("jecFile")->setComment("Path to text file containing jet-energy-scale corrections");
+  desc.add<edm::InputTag>("puProxy")
+      ->setComment("Input product for PU-proxy value (type: int, or PUProxyBxArray if puProxyPerBx is true)");
+  desc.add<bool>("puProxyPerBx", false)
+      ->setComment(
+          "Correct the jets of every BX with the PU proxy of that BX (from a PUProxyBxArray, e.g. the \"PerBx\" "
+          "product of L1TCaloTowerMultiplicityProducer), instead of one PU-proxy value for all BXs");
+  desc.add<edm::ESInputTag>("jetCorrector", edm::ESInputTag("", ""))
+      ->setComment(
+          "EventSetup product for jet-energy-scale corrections "
+          "(type: JetCorrector, record: L1ScoutingJetCorrectorRcd, formulaType: \"CorrectionFactor\")");
   desc.add<int>("bxMin", -2)->setComment("Min BX (inclusive)");
   desc.add<int>("bxMax", 2)->setComment("Max BX (inclusive)");
+  desc.add<int>("maxJetsPerBx", -1)
+      ->setComment("Max number of jets per BX, in order of decreasing corrected pT (if negative, all jets are kept)");
+  desc.add<bool>("produceSoA", false)
+      ->setComment("Also produce the corrected jets as a JetSoABxCollection (product instance label: \"SoA\")");
 
   descriptions.addDefault(desc);
 }
@@ -1,202 +1,252 @@
 #include <algorithm>
-#include <cmath>
-#include <fstream>
 #include <memory>
-#include <numeric>
-#include <sstream>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "CommonTools/Utils/interface/FormulaEvaluator.h"
 #include "DataFormats/L1Trigger/interface/Jet.h"
 #include "FWCore/Framework/interface/global/EDProducer.h"
 #include "FWCore/Framework/interface/Event.h"
-#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/ESGetToken.h"
 #include "FWCore/Utilities/interface/Exception.h"
-#include "FWCore/Utilities/interface/FileInPath.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetBxCorrection.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+#include "L1ScoutingTools/Reconstruction/interface/L1ScoutingJetCorrectorRcd.h"
+#include "L1ScoutingTools/Reconstruction/interface/PUProxyBxArray.h"
+
+namespace l1tCaloTowerJetCorrectorC {
+  // per-stream buffers, re-used across events
+  struct Workspace {
+    Workspace(std::string logCategory, int const maxJetsPerBx)
+        : jetBxCorrection{std::move(logCategory), maxJetsPerBx} {}
+
+    JetBxCorrection jetBxCorrection;
+    std::vector<double> corrs;
+    std::vector<double> variationCorrs;
+  };
+}  // namespace l1tCaloTowerJetCorrectorC
 
-class L1TCaloTowerJetCorrectorC : public edm::global::EDProducer<> {
+class L1TCaloTowerJetCorrectorC
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerJetCorrectorC::Workspace>> {
 public:
   explicit L1TCaloTowerJetCorrectorC(edm::ParameterSet const&);
 
   static void fillDescriptions(edm::ConfigurationDescriptions&);
 
 private:
-  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
-
-  class JetCorrector {
-  public:
-    explicit JetCorrector(std::string const& filePath) {
-      ifstream infile(filePath);
-      std::string line{};
-      while (std::getline(infile, line)) {
-        std::istringstream iss(line);
-
-        float ptMin{0.f};
-        float ptMax{0.f};
-        float etaMin{0.f};
-        float etaMax{0.f};
-        int puProxyMin{0};
-        int puProxyMax{0};
-        int formNParams{0};
-        std::string formEvalStr{""};
-
-        if (!(iss >> ptMin >> ptMax >> etaMin >> etaMax >> puProxyMin >> puProxyMax >> formEvalStr >> formNParams)) {
-          throw cms::Exception("InvalidInput")
-              << "failed to read line from input file (invalid format): \"" << line << "\"";
-        }
+  using Workspace = l1tCaloTowerJetCorrectorC::Workspace;
 
-        if (ptMin <= 0) {
-          throw cms::Exception("InvalidInput")
-              << "invalid value for parameter \"ptMin\" (must be greater than zero): " << ptMin;
-        }
+  std::unique_ptr<Workspace> beginStream(edm::StreamID) const override;
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
 
-        if (ptMax <= 0) {
-          throw cms::Exception("InvalidInput")
-              << "invalid value for parameter \"ptMax\" (must be greater than zero): " << ptMax;
-        }
+  // corrected jets with the given corrections (of all BXs), in order of decreasing corrected pT in every BX
+  // (label: label of the variation, empty for the nominal corrections)
+  void putJets(edm::Event&,
+               JetBxCorrection&,
+               std::vector<double> const& corrs,
+               std::string const& label,
+               edm::EDPutTokenT<l1t::JetBxCollection> putToken,
+               edm::EDPutTokenT<JetSoABxCollection> soaPutToken) const;
+
+  // additional corrected jets, with a different JetCorrector and/or scaled corrections
+  struct Variation {
+    std::string label;
+    bool ownJetCorrector;
+    edm::ESGetToken<JetCorrector, L1ScoutingJetCorrectorRcd> jetCorrectorToken;
+    double scale;
+    edm::EDPutTokenT<l1t::JetBxCollection> putToken;
+    edm::EDPutTokenT<JetSoABxCollection> soaPutToken;
+  };
 
-        if (ptMin >= ptMax) {
-          throw cms::Exception("InvalidInput")
-              << "inconsistent values for parameters \"ptMin\" and \"ptMax\" (the latter must be greater than the former): ptMin=" << ptMin << " ptMax=" << ptMax;
-        }
+  edm::EDGetTokenT<l1t::JetBxCollection> const srcToken_;
+  bool const puProxyPerBx_;
+  edm::EDGetTokenT<int> puProxyToken_;
+  edm::EDGetTokenT<PUProxyBxArray> puProxyPerBxToken_;
+  edm::ESGetToken<JetCorrector, L1ScoutingJetCorrectorRcd> const jetCorrectorToken_;
+  int const bxMin_;
+  int const bxMax_;
+  int const maxJetsPerBx_;
+  bool const produceSoA_;
 
-        if (etaMin >= etaMax) {
-          throw cms::Exception("InvalidInput")
-              << "inconsistent values for parameters \"etaMin\" and \"etaMax\" (the latter must be greater than the former): etaMin=" << etaMin << " etaMax=" << etaMax;
-        }
+  edm::EDPutTokenT<l1t::JetBxCollection> const putToken_;
+  edm::EDPutTokenT<JetSoABxCollection> soaPutToken_;
 
-        if (puProxyMin > 0 and puProxyMax > 0 and puProxyMin >= puProxyMax) {
-          throw cms::Exception("InvalidInput")
-              << "inconsistent values for parameters \"puProxyMin\" and \"puProxyMax\" (if both are greater than zero, the latter must be greater than the former): puProxyMin=" << puProxyMin << " puProxyMax=" << puProxyMax;
-        }
+  std::vector<Variation> variations_;
+};
 
-        if (formNParams <= 0) {
-          throw cms::Exception("InvalidInput")
-              << "invalid value for parameter \"formNParams\" (must be greater than zero): " << formNParams;
-        }
+L1TCaloTowerJetCorrectorC::L1TCaloTowerJetCorrectorC(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      puProxyPerBx_{iConfig.getParameter<bool>("puProxyPerBx")},
+      jetCorrectorToken_{esConsumes(iConfig.getParameter<edm::ESInputTag>("jetCorrector"))},
+      bxMin_{iConfig.getParameter<int>("bxMin")},
+      bxMax_{iConfig.getParameter<int>("bxMax")},
+      maxJetsPerBx_{iConfig.getParameter<int>("maxJetsPerBx")},
+      produceSoA_{iConfig.getParameter<bool>("produceSoA")},
+      putToken_{produces<l1t::JetBxCollection>()} {
+  if (puProxyPerBx_) {
+    puProxyPerBxToken_ = consumes(iConfig.getParameter<edm::InputTag>("puProxy"));
+  } else {
+    puProxyToken_ = consumes(iConfig.getParameter<edm::InputTag>("puProxy"));
+  }
 
-        reco::FormulaEvaluator formEval{formEvalStr};
+  if (produceSoA_) {
+    soaPutToken_ = produces<JetSoABxCollection>("SoA");
+  }
 
-        std::vector<double> formParams(formNParams);
-        for (auto idx = 0; idx < formNParams; ++idx) {
-          if (!(iss >> formParams[idx])) {
-            throw cms::Exception("InvalidInput")
-                << "failed to read line from input file (invalid format, formula parameter #" << idx << "): \"" << line
-                << "\"";
-          }
-        }
+  // product instance labels of the nominal jets, and of the jets of every variation (label, and label + "SoA"),
+  // reserved independently of produceSoA so that the validity of a configuration does not depend on it
+  std::set<std::string> instanceLabels{"", "SoA"};
+  for (auto const& pset : iConfig.getParameterSetVector("variations")) {
+    auto& variation = variations_.emplace_back();
+    variation.label = pset.getParameter<std::string>("label");
+    if (not instanceLabels.insert(variation.label).second or not instanceLabels.insert(variation.label + "SoA").second) {
+      throw cms::Exception("Configuration")
+          << "invalid value for parameter \"label\" of \"variations\" (the label, and the label followed by \"SoA\", "
+             "must be non-empty and different from the product instance labels of the nominal jets and of the "
+             "other variations): \""
+          << variation.label << "\"";
+    }
 
-        data_.emplace_back(ptMin, ptMax, etaMin, etaMax, puProxyMin, puProxyMax, std::move(formEval), std::move(formParams));
-      }
+    variation.ownJetCorrector = pset.existsAs<edm::ESInputTag>("jetCorrector");
+    if (variation.ownJetCorrector) {
+      variation.jetCorrectorToken = esConsumes(pset.getParameter<edm::ESInputTag>("jetCorrector"));
     }
+    variation.scale = pset.getParameter<double>("scale");
 
-    double correction(float const pt, float const eta, int const puProxy) const {
-      for (auto const& entry : data_) {
-        if (eta >= entry.etaMin and eta < entry.etaMax and
-            (entry.puProxyMin < 0 or puProxy >= entry.puProxyMin) and
-            (entry.puProxyMax < 0 or puProxy < entry.puProxyMax)) {
-          std::vector<double> vars{std::clamp(pt, entry.ptMin, entry.ptMax)};
-          return (entry.formulaEvaluator.evaluate(vars, entry.formulaParameters) / vars[0]);
-        }
-      }
-      return 0;
+    variation.putToken = produces<l1t::JetBxCollection>(variation.label);
+    if (produceSoA_) {
+      variation.soaPutToken = produces<JetSoABxCollection>(variation.label + "SoA");
     }
+  }
+}
 
-  private:
-    struct Entry {
-      float ptMin;
-      float ptMax;
-      float etaMin;
-      float etaMax;
-      int puProxyMin;
-      int puProxyMax;
-      reco::FormulaEvaluator formulaEvaluator;
-      std::vector<double> formulaParameters;
-    };
-
-    std::vector<Entry> data_;
-  };
+std::unique_ptr<L1TCaloTowerJetCorrectorC::Workspace> L1TCaloTowerJetCorrectorC::beginStream(edm::StreamID) const {
+  return std::make_unique<Workspace>("L1TCaloTowerJetCorrectorC", maxJetsPerBx_);
+}
 
-  edm::EDGetTokenT<l1t::JetBxCollection> const srcToken_;
-  edm::EDGetTokenT<int> const puProxyToken_;
-  JetCorrector const jetCorrector_;
-  int const bxMin_;
-  int const bxMax_;
-};
+void L1TCaloTowerJetCorrectorC::produce(edm::StreamID streamID,
+                                        edm::Event& iEvent,
+                                        edm::EventSetup const& iSetup) const {
+  auto const checkFormulaType = [](JetCorrector const& jetCorrector) {
+    if (jetCorrector.formulaType() != JetCorrector::FormulaType::CorrectedPt) {
+      throw cms::Exception("Configuration")
+          << "invalid JetCorrector (formulaType must be \"CorrectedPt\" for L1TCaloTowerJetCorrectorC)";
+    }
+  };
 
-L1TCaloTowerJetCorrectorC::L1TCaloTowerJetCorrectorC(edm::ParameterSet const& iConfig)
-    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
-      puProxyToken_{consumes(iConfig.getParameter<edm::InputTag>("puProxy"))},
-      jetCorrector_{iConfig.getParameter<edm::FileInPath>("jecFile").fullPath()},
-      bxMin_{iConfig.getParameter<int>("bxMin")},
-      bxMax_{iConfig.getParameter<int>("bxMax")} {
-  produces<l1t::JetBxCollection>();
-}
+  auto const& jetCorrector = iSetup.getData(jetCorrectorToken_);
+  checkFormulaType(jetCorrector);
 
-void L1TCaloTowerJetCorrectorC::produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
   auto const& inputs = iEvent.get(srcToken_);
 
-  auto const& puProxy = iEvent.get(puProxyToken_);
-
   auto const bxMin = std::max(bxMin_, inputs.getFirstBX());
   auto const bxMax = std::min(bxMax_, inputs.getLastBX());
 
-  auto output = std::make_unique<l1t::JetBxCollection>(0, bxMin, bxMax);
+  auto& workspace = *streamCache(streamID);
+  auto& jetBxCorrection = workspace.jetBxCorrection;
+  auto& corrs = workspace.corrs;
+  auto& variationCorrs = workspace.variationCorrs;
 
-  for (auto bx = bxMin; bx <= bxMax; ++bx) {
-    auto const nInputs = inputs.size(bx);
+  // PU proxy of every BX (the same for all BXs, unless puProxyPerBx)
+  if (puProxyPerBx_) {
+    jetBxCorrection.setInputs(inputs, bxMin, bxMax, iEvent.get(puProxyPerBxToken_));
+  } else {
+    jetBxCorrection.setInputs(inputs, bxMin, bxMax, iEvent.get(puProxyToken_));
+  }
 
-    std::vector<l1t::Jet> out_jets{};
-    out_jets.reserve(nInputs);
-    for (auto idx = 0u; idx < nInputs; ++idx) {
-      auto jet = inputs.at(bx, idx);
-      auto const corr{jetCorrector_.correction(jet.pt(), jet.eta(), puProxy)};
+  // corrections of the jets of all BXs, in one batch per run of consecutive BXs with the same PU proxy
+  // (a single batch, unless puProxyPerBx); the bin of every jet is found once, and shared by the variations
+  // with the same binning, for which only the formulas are evaluated
+  jetBxCorrection.findBins(jetCorrector);
+  jetBxCorrection.corrections(jetCorrector, corrs);
 
-      LogTrace("L1TCaloTowerJetCorrectorC")
-          << "[L1TCaloTowerJetCorrectorC] Jet(bx=" << bx << ", index=" << idx << ") (PU proxy = " << puProxy << ")";
+  putJets(iEvent, jetBxCorrection, corrs, "", putToken_, soaPutToken_);
 
-      LogTrace("L1TCaloTowerJetCorrectorC")
-          << "[L1TCaloTowerJetCorrectorC]    Pre -JESC: eta=" << jet.eta() << " phi=" << jet.phi()
-          << " pT(uncorrected)=" << jet.pt() << " JESC=" << corr;
+  for (auto const& variation : variations_) {
+    if (variation.ownJetCorrector) {
+      auto const& variationJetCorrector = iSetup.getData(variation.jetCorrectorToken);
+      checkFormulaType(variationJetCorrector);
 
-      if (corr <= 0) {
-        continue;
-      }
+      jetBxCorrection.corrections(variationJetCorrector, variationCorrs);
 
-      jet.setP4(jet.p4() * corr);
+      if (variation.scale != 1) {
+        for (auto& corr : variationCorrs) {
+          corr *= variation.scale;
+        }
+      }
+    } else {
+      // scale-only variation: nominal corrections times the scale
+      variationCorrs.resize(corrs.size());
+      for (auto ijet = 0u; ijet < corrs.size(); ++ijet) {
+        variationCorrs[ijet] = corrs[ijet] * variation.scale;
+      }
+    }
 
-      LogTrace("L1TCaloTowerJetCorrectorC") << "[L1TCaloTowerJetCorrectorC]    Post-JESC: eta=" << jet.eta()
-                                           << " phi=" << jet.phi() << " pT(corrected)=" << jet.pt();
+    putJets(iEvent, jetBxCorrection, variationCorrs, variation.label, variation.putToken, variation.soaPutToken);
+  }
+}
 
-      out_jets.emplace_back(std::move(jet));
-    }
+void L1TCaloTowerJetCorrectorC::putJets(edm::Event& iEvent,
+                                        JetBxCorrection& jetBxCorrection,
+                                        std::vector<double> const& corrs,
+                                        std::string const& label,
+                                        edm::EDPutTokenT<l1t::JetBxCollection> const putToken,
+                                        edm::EDPutTokenT<JetSoABxCollection> const soaPutToken) const {
+  l1t::JetBxCollection output;
+  JetSoABxCollection soaOutput;
+  jetBxCorrection.correctedJets(corrs, output, produceSoA_ ? &soaOutput : nullptr, label);
 
-    std::vector<size_t> sortIdxs(out_jets.size());
-    std::iota(sortIdxs.begin(), sortIdxs.end(), 0);
-    std::sort(sortIdxs.begin(), sortIdxs.end(), [&](size_t const i1, size_t const i2) {
-      return out_jets[i1].pt() > out_jets[i2].pt();
-    });
+  iEvent.emplace(putToken, std::move(output));
 
-    for (auto idx : sortIdxs) {
-      output->push_back(bx, out_jets[idx]);
-    }
+  if (produceSoA_) {
+    iEvent.emplace(soaPutToken, std::move(soaOutput));
   }
-
-  iEvent.put(std::move(output));
 }
 
 void L1TCaloTowerJetCorrectorC::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
 
   desc.add<edm::InputTag>("src")->setComment("Input product for jets (type: l1t::JetBxCollection)");
-  desc.add<edm::InputTag>("puProxy")->setComment("Input product for PU-proxy value (type: int)");
-  desc.add<edm::FileInPath>("jecFile")->setComment("Path to text file containing jet-energy-scale corrections");
+  desc.add<edm::InputTag>("puProxy")
+      ->setComment("Input product for PU-proxy value (type: int, or PUProxyBxArray if puProxyPerBx is true)");
+  desc.add<bool>("puProxyPerBx", false)
+      ->setComment(
+          "Correct the jets of every BX with the PU proxy of that BX (from a PUProxyBxArray, e.g. the \"PerBx\" "
+          "product of L1TCaloTowerMultiplicityProducer), instead of one PU-proxy value for all BXs");
+  desc.add<edm::ESInputTag>("jetCorrector", edm::ESInputTag("", ""))
+      ->setComment(
+          "EventSetup product for jet-energy-scale corrections "
+          "(type: JetCorrector, record: L1ScoutingJetCorrectorRcd, formulaType: \"CorrectedPt\")");
   desc.add<int>("bxMin", -2)->setComment("Min BX (inclusive)");
   desc.add<int>("bxMax", 2)->setComment("Max BX (inclusive)");
+  desc.add<int>("maxJetsPerBx", -1)
+      ->setComment("Max number of jets per BX, in order of decreasing corrected pT (if negative, all jets are kept)");
+  desc.add<bool>("produceSoA", false)
+      ->setComment("Also produce the corrected jets as a JetSoABxCollection (product instance label: \"SoA\")");
+
+  edm::ParameterSetDescription variationDesc;
+  variationDesc.add<std::string>("label")
+      ->setComment(
+          "Product instance label of the jets of the variation (and label + \"SoA\" for the JetSoABxCollection)");
+  variationDesc.addOptional<edm::ESInputTag>("jetCorrector")
+      ->setComment(
+          "EventSetup product for the jet-energy-scale corrections of the variation (formulaType: \"CorrectedPt\"; "
+          "if not given, the corrections of jetCorrector)");
+  variationDesc.add<double>("scale", 1)
+      ->setComment(
+          "Scale factor of the corrections of the variation (e.g. 1.02 for a shift of the jet energy scale by +2%)");
+
+  desc.addVPSet("variations", variationDesc, {})
+      ->setComment(
+          "Variations of the corrections (e.g. for systematic uncertainties), produced in addition to the nominal "
+          "corrected jets from the same input jets (the bin of every jet is found once for all the JetCorrectors with "
+          "the same bins)");
 
   descriptions.addDefault(desc);
 }
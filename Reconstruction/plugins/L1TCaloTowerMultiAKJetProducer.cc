@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+
+#include "fastjet/PseudoJet.hh"
+
+namespace l1tCaloTowerMultiAKJetProducer {
+  // towers of one BX, validated and converted once for all configurations
+  struct Tower {
+    int hwPt;
+    int hwEta;
+    int hwPhi;
+    fastjet::PseudoJet fjInput;
+  };
+
+  // per-stream buffers, re-used across BXs and events
+  struct Workspace {
+    Workspace(int const towerMinHwPt, int const towerMaxHwPt) : preSelector{towerMinHwPt, towerMaxHwPt} {}
+
+    CaloTowerPreSelector preSelector;
+    std::vector<Tower> towers;
+
+    // one clustering per clustering group
+    std::vector<caloTowerJetClustering::Clustering> clusterings;
+
+    // towers rejected because of invalid lattice coordinates
+    CaloTowerPreSelector::InvalidTowerCounts invalidTowers;
+  };
+}  // namespace l1tCaloTowerMultiAKJetProducer
+
+class L1TCaloTowerMultiAKJetProducer
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerMultiAKJetProducer::Workspace>,
+                                     edm::LuminosityBlockSummaryCache<CaloTowerPreSelector::InvalidTowerCounts>> {
+public:
+  explicit L1TCaloTowerMultiAKJetProducer(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  using Tower = l1tCaloTowerMultiAKJetProducer::Tower;
+  using Workspace = l1tCaloTowerMultiAKJetProducer::Workspace;
+  using InvalidTowerCounts = CaloTowerPreSelector::InvalidTowerCounts;
+
+  using Backend = caloTowerJetClustering::Backend;
+
+  // one output collection
+  struct Configuration {
+    std::string label;
+    double jetPtMin;
+    edm::EDPutTokenT<l1t::JetBxCollection> putToken;
+    edm::EDPutTokenT<JetSoABxCollection> soaPutToken;
+  };
+
+  // configurations sharing the same clustering (same R and same selection of towers)
+  struct ClusteringGroup {
+    double rParam;
+    int towerMinHwPt;
+    int towerMaxHwPt;
+    std::vector<unsigned int> configurations;
+
+    bool selected(int const hwPt) const {
+      return (towerMinHwPt < 0 or hwPt >= towerMinHwPt) and (towerMaxHwPt < 0 or hwPt <= towerMaxHwPt);
+    }
+  };
+
+  std::unique_ptr<Workspace> beginStream(edm::StreamID) const override;
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  std::shared_ptr<InvalidTowerCounts> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const override;
+  void streamEndLuminosityBlockSummary(edm::StreamID,
+                                       edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+
+  edm::EDGetTokenT<l1t::CaloTowerBxCollection> const srcToken_;
+  int const bxMin_;
+  int const bxMax_;
+  Backend const backend_;
+  bool const produceSoA_;
+  CaloTowerLUT const& lut_;
+  std::vector<Configuration> configurations_;
+  std::vector<ClusteringGroup> clusteringGroups_;
+
+  // hwPt window of the tower pre-selection (envelope of the hwPt windows of all clustering groups)
+  int preSelectionMinHwPt_;
+  int preSelectionMaxHwPt_;
+};
+
+L1TCaloTowerMultiAKJetProducer::L1TCaloTowerMultiAKJetProducer(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      bxMin_{iConfig.getParameter<int>("bxMin")},
+      bxMax_{iConfig.getParameter<int>("bxMax")},
+      backend_{caloTowerJetClustering::backend(iConfig.getParameter<std::string>("backend"))},
+      produceSoA_{iConfig.getParameter<bool>("produceSoA")},
+      lut_{CaloTowerLUT::get()},
+      preSelectionMinHwPt_{-1},
+      preSelectionMaxHwPt_{-1} {
+  auto const& pSets = iConfig.getParameter<std::vector<edm::ParameterSet>>("configurations");
+  configurations_.reserve(pSets.size());
+
+  for (auto const& pSet : pSets) {
+    auto const label = pSet.getParameter<std::string>("label");
+    auto const rParam = pSet.getParameter<double>("rParam");
+    auto const towerMinHwPt = pSet.getParameter<int>("towerMinHwPt");
+    auto const towerMaxHwPt = pSet.getParameter<int>("towerMaxHwPt");
+
+    if (std::any_of(configurations_.begin(), configurations_.end(), [&label](auto const& cfg) {
+          return cfg.label == label;
+        })) {
+      throw cms::Exception("Configuration") << "duplicate label in parameter \"configurations\": \"" << label << "\"";
+    }
+
+    auto const cfgIdx = configurations_.size();
+    configurations_.emplace_back(
+        Configuration{label, pSet.getParameter<double>("jetPtMin"), produces<l1t::JetBxCollection>(label), {}});
+    if (produceSoA_) {
+      configurations_.back().soaPutToken = produces<JetSoABxCollection>(label + "SoA");
+    }
+
+    auto group = std::find_if(clusteringGroups_.begin(), clusteringGroups_.end(), [&](auto const& grp) {
+      return grp.rParam == rParam and grp.towerMinHwPt == towerMinHwPt and grp.towerMaxHwPt == towerMaxHwPt;
+    });
+
+    if (group == clusteringGroups_.end()) {
+      clusteringGroups_.emplace_back(ClusteringGroup{rParam, towerMinHwPt, towerMaxHwPt, {}});
+      group = clusteringGroups_.end() - 1;
+    }
+
+    group->configurations.emplace_back(cfgIdx);
+  }
+
+  // envelope of the hwPt windows of all groups (a negative bound of any group disables the bound)
+  if (not clusteringGroups_.empty()) {
+    preSelectionMinHwPt_ = clusteringGroups_.front().towerMinHwPt;
+    preSelectionMaxHwPt_ = clusteringGroups_.front().towerMaxHwPt;
+    for (auto const& group : clusteringGroups_) {
+      preSelectionMinHwPt_ = (preSelectionMinHwPt_ < 0 or group.towerMinHwPt < 0)
+                                 ? -1
+                                 : std::min(preSelectionMinHwPt_, group.towerMinHwPt);
+      preSelectionMaxHwPt_ = (preSelectionMaxHwPt_ < 0 or group.towerMaxHwPt < 0)
+                                 ? -1
+                                 : std::max(preSelectionMaxHwPt_, group.towerMaxHwPt);
+    }
+  }
+}
+
+std::unique_ptr<L1TCaloTowerMultiAKJetProducer::Workspace> L1TCaloTowerMultiAKJetProducer::beginStream(
+    edm::StreamID) const {
+  auto workspace = std::make_unique<Workspace>(preSelectionMinHwPt_, preSelectionMaxHwPt_);
+  workspace->clusterings.reserve(clusteringGroups_.size());
+  for (auto const& group : clusteringGroups_) {
+    workspace->clusterings.emplace_back(backend_, group.rParam);
+  }
+  return workspace;
+}
+
+std::shared_ptr<L1TCaloTowerMultiAKJetProducer::InvalidTowerCounts>
+L1TCaloTowerMultiAKJetProducer::globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                  edm::EventSetup const&) const {
+  return std::make_shared<InvalidTowerCounts>();
+}
+
+void L1TCaloTowerMultiAKJetProducer::streamEndLuminosityBlockSummary(edm::StreamID streamID,
+                                                                     edm::LuminosityBlock const&,
+                                                                     edm::EventSetup const&,
+                                                                     InvalidTowerCounts* summary) const {
+  auto& workspace = *streamCache(streamID);
+  summary->take(workspace.invalidTowers);
+}
+
+void L1TCaloTowerMultiAKJetProducer::globalEndLuminosityBlockSummary(edm::LuminosityBlock const& iLumi,
+                                                                     edm::EventSetup const&,
+                                                                     InvalidTowerCounts* summary) const {
+  summary->report("ScoutingJetProducer", moduleDescription().moduleLabel(), iLumi, "jet clustering");
+}
+
+void L1TCaloTowerMultiAKJetProducer::produce(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  auto& workspace = *streamCache(streamID);
+  auto& preSelector = workspace.preSelector;
+  auto& towers = workspace.towers;
+
+  auto const bxMin = std::max(bxMin_, inputs.getFirstBX());
+  auto const bxMax = std::min(bxMax_, inputs.getLastBX());
+
+  std::vector<std::unique_ptr<l1t::JetBxCollection>> outputs;
+  outputs.reserve(configurations_.size());
+  for (auto icfg = 0u; icfg < configurations_.size(); ++icfg) {
+    outputs.emplace_back(std::make_unique<l1t::JetBxCollection>(0, bxMin, bxMax));
+  }
+
+  std::vector<JetSoABxCollection> soaOutputs;
+  if (produceSoA_) {
+    soaOutputs.assign(configurations_.size(), JetSoABxCollection(bxMin, bxMax));
+  }
+
+  auto const addJet = [&](unsigned int const icfg, int const bx, l1t::Jet::LorentzVector const& p4) {
+    outputs[icfg]->push_back(bx, l1t::Jet{p4});
+    if (produceSoA_) {
+      soaOutputs[icfg].push_back(bx, p4.pt(), p4.eta(), p4.phi(), p4.mass());
+    }
+  };
+
+  for (auto bx = bxMin; bx <= bxMax; ++bx) {
+    // tower preparation (validation and conversion), shared by all configurations
+    // (towers with invalid hwEta or hwPhi values are not selected, and are reported once per lumi-section)
+    towers.clear();
+
+    preSelector.select(inputs, bx);
+    workspace.invalidTowers.addBX(preSelector.nInvalidHwEta(), preSelector.nInvalidHwPhi());
+
+    for (auto const idx : preSelector.indices()) {
+      auto const& input = inputs.at(bx, idx);
+
+      // towers inside the envelope of the hwPt windows, but outside the window of every group
+      if (std::none_of(clusteringGroups_.begin(), clusteringGroups_.end(), [&input](auto const& group) {
+            return group.selected(input.hwPt());
+          })) {
+        continue;
+      }
+
+      auto& tower = towers.emplace_back(Tower{input.hwPt(), input.hwEta(), input.hwPhi(), {}});
+
+      if (backend_ == Backend::FastJet) {
+        tower.fjInput = caloTowerJetClustering::fastJetInput(lut_, tower.hwPt, tower.hwEta, tower.hwPhi);
+      }
+    }
+
+    // one clustering per group, jets of every configuration of the group from the same clustering history
+    for (auto igrp = 0u; igrp < clusteringGroups_.size(); ++igrp) {
+      auto const& group = clusteringGroups_[igrp];
+
+      auto& clustering = workspace.clusterings[igrp];
+      clustering.clear();
+      for (auto const& tower : towers) {
+        if (group.selected(tower.hwPt)) {
+          clustering.addTower(tower.hwPt, tower.hwEta, tower.hwPhi, tower.fjInput);
+        }
+      }
+
+      clustering.run();
+
+      for (auto const icfg : group.configurations) {
+        for (auto const& jet : clustering.inclusiveJets(configurations_[icfg].jetPtMin)) {
+          addJet(icfg, bx, l1t::Jet::LorentzVector{jet.px, jet.py, jet.pz, jet.E});
+        }
+      }
+    }
+  }
+
+  for (auto icfg = 0u; icfg < configurations_.size(); ++icfg) {
+    LogTrace("L1TCaloTowerMultiAKJetProducer")
+        << "[L1TCaloTowerMultiAKJetProducer] [" << moduleDescription().moduleLabel() << "] "
+        << configurations_[icfg].label << ": jets=" << outputs[icfg]->size();
+    iEvent.put(configurations_[icfg].putToken, std::move(outputs[icfg]));
+    if (produceSoA_) {
+      soaOutputs[icfg].finalize();
+      iEvent.emplace(configurations_[icfg].soaPutToken, std::move(soaOutputs[icfg]));
+    }
+  }
+}
+
+void L1TCaloTowerMultiAKJetProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input product (type: l1t::CaloTowerBxCollection)");
+  desc.add<int>("bxMin", -2)->setComment("Min BX (inclusive)");
+  desc.add<int>("bxMax", 2)->setComment("Max BX (inclusive)");
+  desc.add<std::string>("backend", "FastJet")
+      ->setComment(
+          "Clustering backend: \"FastJet\" (fastjet::ClusterSequence) or \"Lattice\" (LatticeAntiKtClustering, "
+          "same jets as FastJet, BXs with ambiguous recombinations are clustered with fastjet::ClusterSequence)");
+  desc.add<bool>("produceSoA", false)
+      ->setComment(
+          "Also produce the jets of every configuration as a JetSoABxCollection "
+          "(product instance label: label of the configuration followed by \"SoA\")");
+
+  edm::ParameterSetDescription descCfg;
+  descCfg.add<std::string>("label")->setComment("Product instance label of the output l1t::JetBxCollection");
+  descCfg.add<double>("rParam", 0.4)->setComment("R parameter for anti-kT clustering");
+  descCfg.add<int>("towerMinHwPt", 1)
+      ->setComment("Min hwPt (inclusive) of l1t::CaloTowers used for jet clustering (ignored if negative)");
+  descCfg.add<int>("towerMaxHwPt", -1)
+      ->setComment("Max hwPt (inclusive) of l1t::CaloTowers used for jet clustering (ignored if negative)");
+  descCfg.add<double>("jetPtMin", 0)->setComment("Minimum pT of output jets");
+
+  desc.addVPSet("configurations", descCfg, {})
+      ->setComment(
+          "Clustering configurations, one output collection each "
+          "(configurations with the same rParam, towerMinHwPt and towerMaxHwPt share the same clustering)");
+
+  descriptions.add("l1tCaloTowerMultiAKJetProducer", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TCaloTowerMultiAKJetProducer);
@@ -0,0 +1,134 @@
+#include <bit>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerWindowMasks.h"
+
+// Multiplicities of l1t::CaloTowers in several (hwPt, |hwEta|) windows, counted in one pass over the towers of one BX.
+// Same values as one L1TCaloTowerMultiplicityProducer per window: one int product per window (product instance label:
+// label of the window), plus the values of all windows, in the order of the windows (type: std::vector<int>).
+// The windows containing a tower are given by the bitmask lookup tables of CaloTowerWindowMasks,
+// so the cost per tower does not depend on the number of windows.
+class L1TCaloTowerMultiWindowMultiplicityProducer : public edm::global::EDProducer<> {
+public:
+  explicit L1TCaloTowerMultiWindowMultiplicityProducer(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  static constexpr unsigned int kMaxWindows = CaloTowerWindowMasks::kMaxWindows;
+
+  struct Window {
+    std::string label;
+    edm::EDPutTokenT<int> putToken;
+  };
+
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+
+  edm::EDGetTokenT<l1t::CaloTowerBxCollection> const srcToken_;
+  int const bunchCrossing_;
+
+  std::vector<Window> windows_;
+
+  // windows containing a tower (bit i: i-th window)
+  CaloTowerWindowMasks windowMasks_;
+
+  edm::EDPutTokenT<std::vector<int>> const putToken_;
+};
+
+L1TCaloTowerMultiWindowMultiplicityProducer::L1TCaloTowerMultiWindowMultiplicityProducer(
+    edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      bunchCrossing_{iConfig.getParameter<int>("bunchCrossing")},
+      putToken_{produces<std::vector<int>>()} {
+  std::set<std::string> labels;
+  std::vector<CaloTowerWindowMasks::Window> edges;
+  for (auto const& pset : iConfig.getParameterSetVector("windows")) {
+    auto& window = windows_.emplace_back(Window{pset.getParameter<std::string>("label"), {}});
+    edges.emplace_back(CaloTowerWindowMasks::Window{pset.getParameter<int>("towerMinHwPt"),
+                                                    pset.getParameter<int>("towerMaxHwPt"),
+                                                    pset.getParameter<int>("towerMinAbsHwEta"),
+                                                    pset.getParameter<int>("towerMaxAbsHwEta")});
+
+    if (window.label.empty() or not labels.insert(window.label).second) {
+      throw cms::Exception("Configuration")
+          << "invalid value for parameter \"label\" of \"windows\" (must be non-empty and unique): \"" << window.label
+          << "\"";
+    }
+
+    window.putToken = produces<int>(window.label);
+  }
+
+  if (windows_.size() > kMaxWindows) {
+    throw cms::Exception("Configuration") << "invalid value for parameter \"windows\" (at most " << kMaxWindows
+                                          << " windows): " << windows_.size() << " windows";
+  }
+
+  windowMasks_ = CaloTowerWindowMasks{edges};
+}
+
+void L1TCaloTowerMultiWindowMultiplicityProducer::produce(edm::StreamID,
+                                                          edm::Event& iEvent,
+                                                          edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  std::vector<int> counts(windows_.size(), 0);
+
+  if (bunchCrossing_ >= inputs.getFirstBX() and bunchCrossing_ <= inputs.getLastBX()) {
+    auto const nInputs = inputs.size(bunchCrossing_);
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& input = inputs.at(bunchCrossing_, idx);
+      for (auto mask = windowMasks_.mask(input.hwPt(), input.hwEta()); mask != 0; mask &= mask - 1) {
+        ++counts[std::countr_zero(mask)];
+      }
+    }
+  }
+
+  for (auto iwin = 0u; iwin < windows_.size(); ++iwin) {
+    LogTrace("L1TCaloTowerMultiWindowMultiplicityProducer")
+        << "[L1TCaloTowerMultiWindowMultiplicityProducer] [" << moduleDescription().moduleLabel() << "] "
+        << windows_[iwin].label << " = " << counts[iwin];
+
+    iEvent.emplace(windows_[iwin].putToken, counts[iwin]);
+  }
+
+  iEvent.emplace(putToken_, std::move(counts));
+}
+
+void L1TCaloTowerMultiWindowMultiplicityProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input product (type: l1t::CaloTowerBxCollection)");
+  desc.add<int>("bunchCrossing", 0)->setComment("BX value");
+
+  edm::ParameterSetDescription windowDesc;
+  windowDesc.add<std::string>("label")
+      ->setComment("Product instance label of the multiplicity of the window (type: int)");
+  windowDesc.add<int>("towerMinHwPt", -1)->setComment("Min hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
+  windowDesc.add<int>("towerMaxHwPt", -1)->setComment("Max hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
+  windowDesc.add<int>("towerMinAbsHwEta", -1)
+      ->setComment("Min |hwEta| (inclusive) of l1t::CaloTowers (ignored if negative)");
+  windowDesc.add<int>("towerMaxAbsHwEta", -1)
+      ->setComment("Max |hwEta| (inclusive) of l1t::CaloTowers (ignored if negative)");
+
+  desc.addVPSet("windows", windowDesc, {})
+      ->setComment(
+          "Windows in (hwPt, |hwEta|) of the l1t::CaloTowers to be counted (at most 64; the multiplicities of all "
+          "windows are also produced as a std::vector<int>, in the same order)");
+
+  descriptions.add("l1tCaloTowerMultiWindowMultiplicityProducer", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TCaloTowerMultiWindowMultiplicityProducer);
@@ -9,6 +9,8 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "L1ScoutingTools/Reconstruction/interface/PUProxyBxArray.h"
 
 class L1TCaloTowerMultiplicityProducer : public edm::global::EDProducer<> {
 public:
@@ -19,12 +21,18 @@ public:
 private:
   void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
 
+  // number of selected l1t::CaloTowers in BX bx
+  int multiplicity(l1t::CaloTowerBxCollection const&, int bx) const;
+
   edm::EDGetTokenT<l1t::CaloTowerBxCollection> const srcToken_;
   int const bunchCrossing_;
   int const towerMinHwPt_;
   int const towerMaxHwPt_;
   int const towerMinAbsHwEta_;
   int const towerMaxAbsHwEta_;
+  bool const producePerBx_;
+
+  edm::EDPutTokenT<PUProxyBxArray> perBxPutToken_;
 };
 
 L1TCaloTowerMultiplicityProducer::L1TCaloTowerMultiplicityProducer(edm::ParameterSet const& iConfig)
@@ -33,8 +41,12 @@ L1TCaloTowerMultiplicityProducer::L1TCaloTowerMultiplicityProducer(edm::Paramete
       towerMinHwPt_{iConfig.getParameter<int>("towerMinHwPt")},
       towerMaxHwPt_{iConfig.getParameter<int>("towerMaxHwPt")},
       towerMinAbsHwEta_{iConfig.getParameter<int>("towerMinAbsHwEta")},
-      towerMaxAbsHwEta_{iConfig.getParameter<int>("towerMaxAbsHwEta")} {
+      towerMaxAbsHwEta_{iConfig.getParameter<int>("towerMaxAbsHwEta")},
+      producePerBx_{iConfig.getParameter<bool>("producePerBx")} {
   produces<int>();
+  if (producePerBx_) {
+    perBxPutToken_ = produces<PUProxyBxArray>("PerBx");
+  }
 }
 
 void L1TCaloTowerMultiplicityProducer::produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
@@ -42,22 +54,20 @@ void L1TCaloTowerMultiplicityProducer::produce(edm::StreamID, edm::Event& iEvent
 
   int ret_value{0};
 
-  for (auto bx = inputs.getFirstBX(); bx <= inputs.getLastBX(); ++bx) {
-    if (bx != bunchCrossing_) {
-      continue;
+  if (producePerBx_) {
+    // multiplicities of all BXs in one pass over the input collection
+    PUProxyBxArray perBxOutput(inputs.getFirstBX(), inputs.getLastBX());
+    for (auto bx = inputs.getFirstBX(); bx <= inputs.getLastBX(); ++bx) {
+      perBxOutput.at(bx) = multiplicity(inputs, bx);
     }
 
-    auto const nInputs = inputs.size(bx);
-    for (auto idx = 0u; idx < nInputs; ++idx) {
-      auto const& input = inputs.at(bx, idx);
-      auto const absHwEta = std::abs(input.hwEta());
-      if ((towerMinHwPt_ < 0 or input.hwPt() >= towerMinHwPt_) and
-          (towerMaxHwPt_ < 0 or input.hwPt() <= towerMaxHwPt_) and
-          (towerMinAbsHwEta_ < 0 or absHwEta >= towerMinAbsHwEta_) and
-          (towerMaxAbsHwEta_ < 0 or absHwEta <= towerMaxAbsHwEta_)) {
-        ++ret_value;
-      }
+    if (perBxOutput.contains(bunchCrossing_)) {
+      ret_value = perBxOutput.at(bunchCrossing_);
     }
+
+    iEvent.emplace(perBxPutToken_, std::move(perBxOutput));
+  } else if (bunchCrossing_ >= inputs.getFirstBX() and bunchCrossing_ <= inputs.getLastBX()) {
+    ret_value = multiplicity(inputs, bunchCrossing_);
   }
 
   LogTrace("L1TCaloTowerMultiplicityProducer") << "[L1TCaloTowerMultiplicityProducer] ["
@@ -67,15 +77,37 @@ void L1TCaloTowerMultiplicityProducer::produce(edm::StreamID, edm::Event& iEvent
   iEvent.put(std::move(output));
 }
 
+int L1TCaloTowerMultiplicityProducer::multiplicity(l1t::CaloTowerBxCollection const& inputs, int const bx) const {
+  int ret_value{0};
+
+  auto const nInputs = inputs.size(bx);
+  for (auto idx = 0u; idx < nInputs; ++idx) {
+    auto const& input = inputs.at(bx, idx);
+    auto const absHwEta = std::abs(input.hwEta());
+    if ((towerMinHwPt_ < 0 or input.hwPt() >= towerMinHwPt_) and
+        (towerMaxHwPt_ < 0 or input.hwPt() <= towerMaxHwPt_) and
+        (towerMinAbsHwEta_ < 0 or absHwEta >= towerMinAbsHwEta_) and
+        (towerMaxAbsHwEta_ < 0 or absHwEta <= towerMaxAbsHwEta_)) {
+      ++ret_value;
+    }
+  }
+
+  return ret_value;
+}
+
 void L1TCaloTowerMultiplicityProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
 
   desc.add<edm::InputTag>("src")->setComment("Input product (type: l1t::CaloTowerBxCollection)");
-  desc.add<int>("bunchCrossing", 0)->setComment("BX value");
+  desc.add<int>("bunchCrossing", 0)->setComment("BX value (for the product of type int)");
   desc.add<int>("towerMinHwPt", -1)->setComment("Min hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
   desc.add<int>("towerMaxHwPt", -1)->setComment("Max hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
   desc.add<int>("towerMinAbsHwEta", -1)->setComment("Min |hwEta| (inclusive) of l1t::CaloTowers (ignored if negative)");
   desc.add<int>("towerMaxAbsHwEta", -1)->setComment("Max |hwEta| (inclusive) of l1t::CaloTowers (ignored if negative)");
+  desc.add<bool>("producePerBx", false)
+      ->setComment(
+          "Also produce the multiplicities of all the BXs of the input collection as a PUProxyBxArray "
+          "(product instance label: \"PerBx\")");
 
   descriptions.add("l1tCaloTowerMultiplicityProducer", desc);
 }
@@ -0,0 +1,222 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1Scouting/interface/L1ScoutingCaloTower.h"
+#include "DataFormats/L1Scouting/interface/OrbitCollection.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+namespace l1tCaloTowerOrbitAKJetProducer {
+  // per-thread buffers, re-used across BXs and orbits
+  struct Workspace {
+    Workspace(caloTowerJetClustering::Backend const backend,
+              double const rParam,
+              int const towerMinHwPt,
+              int const towerMaxHwPt)
+        : preSelector{towerMinHwPt, towerMaxHwPt}, clustering{backend, rParam} {}
+
+    CaloTowerPreSelector preSelector;
+    caloTowerJetClustering::Clustering clustering;
+
+    // towers rejected because of invalid lattice coordinates
+    CaloTowerPreSelector::InvalidTowerCounts invalidTowers;
+  };
+
+  struct StreamCache {
+    StreamCache(caloTowerJetClustering::Backend const backend,
+                double const rParam,
+                int const towerMinHwPt,
+                int const towerMaxHwPt)
+        : workspace{backend, rParam, towerMinHwPt, towerMaxHwPt},
+          concurrentWorkspaces{backend, rParam, towerMinHwPt, towerMaxHwPt} {}
+
+    Workspace workspace;
+    tbb::enumerable_thread_specific<Workspace> concurrentWorkspaces;
+
+    // BXs with at least one tower, and output jets of every BX (index = BX)
+    std::vector<unsigned int> filledBXs;
+    std::vector<std::vector<l1t::Jet>> orbitBuffer;
+  };
+}  // namespace l1tCaloTowerOrbitAKJetProducer
+
+class L1TCaloTowerOrbitAKJetProducer
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerOrbitAKJetProducer::StreamCache>,
+                                     edm::LuminosityBlockSummaryCache<CaloTowerPreSelector::InvalidTowerCounts>> {
+public:
+  explicit L1TCaloTowerOrbitAKJetProducer(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  using Workspace = l1tCaloTowerOrbitAKJetProducer::Workspace;
+  using StreamCache = l1tCaloTowerOrbitAKJetProducer::StreamCache;
+  using InvalidTowerCounts = CaloTowerPreSelector::InvalidTowerCounts;
+
+  using Backend = caloTowerJetClustering::Backend;
+
+  std::unique_ptr<StreamCache> beginStream(edm::StreamID) const override;
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  std::shared_ptr<InvalidTowerCounts> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const override;
+  void streamEndLuminosityBlockSummary(edm::StreamID,
+                                       edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void clusterBX(l1ScoutingRun3::CaloTowerOrbitCollection const&,
+                 unsigned int bx,
+                 Workspace&,
+                 std::vector<l1t::Jet>&) const;
+
+  edm::EDGetTokenT<l1ScoutingRun3::CaloTowerOrbitCollection> const srcToken_;
+  int const towerMinHwPt_;
+  int const towerMaxHwPt_;
+  double const rParam_;
+  double const jetPtMin_;
+  Backend const backend_;
+  bool const concurrentBXs_;
+};
+
+L1TCaloTowerOrbitAKJetProducer::L1TCaloTowerOrbitAKJetProducer(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      towerMinHwPt_{iConfig.getParameter<int>("towerMinHwPt")},
+      towerMaxHwPt_{iConfig.getParameter<int>("towerMaxHwPt")},
+      rParam_{iConfig.getParameter<double>("rParam")},
+      jetPtMin_{iConfig.getParameter<double>("jetPtMin")},
+      backend_{caloTowerJetClustering::backend(iConfig.getParameter<std::string>("backend"))},
+      concurrentBXs_{iConfig.getParameter<bool>("concurrentBXs")} {
+  produces<OrbitCollection<l1t::Jet>>();
+}
+
+std::unique_ptr<L1TCaloTowerOrbitAKJetProducer::StreamCache> L1TCaloTowerOrbitAKJetProducer::beginStream(
+    edm::StreamID) const {
+  auto cache = std::make_unique<StreamCache>(backend_, rParam_, towerMinHwPt_, towerMaxHwPt_);
+  cache->orbitBuffer.resize(l1ScoutingRun3::CaloTowerOrbitCollection::NBX + 1);
+  return cache;
+}
+
+std::shared_ptr<L1TCaloTowerOrbitAKJetProducer::InvalidTowerCounts>
+L1TCaloTowerOrbitAKJetProducer::globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                  edm::EventSetup const&) const {
+  return std::make_shared<InvalidTowerCounts>();
+}
+
+void L1TCaloTowerOrbitAKJetProducer::streamEndLuminosityBlockSummary(edm::StreamID streamID,
+                                                                     edm::LuminosityBlock const&,
+                                                                     edm::EventSetup const&,
+                                                                     InvalidTowerCounts* summary) const {
+  auto& cache = *streamCache(streamID);
+
+  summary->take(cache.workspace.invalidTowers);
+
+  for (auto& workspace : cache.concurrentWorkspaces) {
+    summary->take(workspace.invalidTowers);
+  }
+}
+
+void L1TCaloTowerOrbitAKJetProducer::globalEndLuminosityBlockSummary(edm::LuminosityBlock const& iLumi,
+                                                                     edm::EventSetup const&,
+                                                                     InvalidTowerCounts* summary) const {
+  summary->report("ScoutingJetProducer", moduleDescription().moduleLabel(), iLumi, "jet clustering");
+}
+
+void L1TCaloTowerOrbitAKJetProducer::produce(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  auto& cache = *streamCache(streamID);
+  auto& filledBXs = cache.filledBXs;
+  auto& orbitBuffer = cache.orbitBuffer;
+
+  // BXs without towers are skipped (the size of a BX is the difference of consecutive BX offsets)
+  filledBXs.clear();
+  for (auto bx = 0u; bx < orbitBuffer.size(); ++bx) {
+    if (inputs.getBxSize(bx) > 0) {
+      filledBXs.emplace_back(bx);
+    }
+  }
+
+  if (concurrentBXs_) {
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, filledBXs.size()),
+                      [&](tbb::blocked_range<std::size_t> const& range) {
+                        auto& workspace = cache.concurrentWorkspaces.local();
+                        for (auto ibx = range.begin(); ibx != range.end(); ++ibx) {
+                          clusterBX(inputs, filledBXs[ibx], workspace, orbitBuffer[filledBXs[ibx]]);
+                        }
+                      });
+  } else {
+    for (auto const bx : filledBXs) {
+      clusterBX(inputs, bx, cache.workspace, orbitBuffer[bx]);
+    }
+  }
+
+  unsigned int nJets{0};
+  for (auto const bx : filledBXs) {
+    nJets += orbitBuffer[bx].size();
+  }
+
+  LogTrace("L1TCaloTowerOrbitAKJetProducer")
+      << "[L1TCaloTowerOrbitAKJetProducer] [" << moduleDescription().moduleLabel()
+      << "] BXs with towers: " << filledBXs.size() << ", jets: " << nJets;
+
+  // the OrbitCollection takes the content of the per-BX buffers, and clears them
+  iEvent.put(std::make_unique<OrbitCollection<l1t::Jet>>(orbitBuffer, nJets));
+}
+
+void L1TCaloTowerOrbitAKJetProducer::clusterBX(l1ScoutingRun3::CaloTowerOrbitCollection const& inputs,
+                                               unsigned int const bx,
+                                               Workspace& workspace,
+                                               std::vector<l1t::Jet>& jets) const {
+  auto& preSelector = workspace.preSelector;
+  preSelector.select(inputs, bx);
+
+  if (preSelector.nInvalidHwEta() + preSelector.nInvalidHwPhi() > 0) {
+    workspace.invalidTowers.addBX(preSelector.nInvalidHwEta(), preSelector.nInvalidHwPhi());
+  }
+
+  auto& clustering = workspace.clustering;
+  clustering.run(preSelector, inputs, bx);
+
+  for (auto const& jet : clustering.inclusiveJets(jetPtMin_)) {
+    jets.emplace_back(l1t::Jet::LorentzVector{jet.px, jet.py, jet.pz, jet.E});
+  }
+}
+
+void L1TCaloTowerOrbitAKJetProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src", edm::InputTag("l1ScCaloTowerUnpacker", "CaloTower"))
+      ->setComment("Input product (type: l1ScoutingRun3::CaloTowerOrbitCollection)");
+  desc.add<int>("towerMinHwPt", 1)
+      ->setComment("Min hwEt (inclusive) of CaloTowers used for jet clustering (ignored if negative)");
+  desc.add<int>("towerMaxHwPt", -1)
+      ->setComment("Max hwEt (inclusive) of CaloTowers used for jet clustering (ignored if negative)");
+  desc.add<double>("rParam", 0.4)->setComment("R parameter for anti-kT clustering");
+  desc.add<double>("jetPtMin", 0)
+      ->setComment("Minimum pT of output jets (argument of fastjet::ClusterSequence::inclusive_jets)");
+  desc.add<std::string>("backend", "FastJet")
+      ->setComment(
+          "Clustering backend: \"FastJet\" (fastjet::ClusterSequence) or \"Lattice\" (LatticeAntiKtClustering, "
+          "same jets as FastJet, BXs with ambiguous recombinations are clustered with fastjet::ClusterSequence)");
+  desc.add<bool>("concurrentBXs", false)
+      ->setComment("Cluster the BXs of one orbit concurrently with TBB tasks (the output does not depend on this option)");
+
+  descriptions.add("l1tCaloTowerOrbitAKJetProducer", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TCaloTowerOrbitAKJetProducer);
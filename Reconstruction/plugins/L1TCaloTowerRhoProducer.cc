@@ -0,0 +1,177 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+#include "L1ScoutingTools/Reconstruction/interface/GridRhoEstimator.h"
+
+namespace l1tCaloTowerRhoProducer {
+  // per-stream buffers, re-used across events
+  struct Workspace {
+    Workspace(int const patchEtaSize, int const patchPhiSize, int const towerMinHwPt, int const towerMaxHwPt)
+        : preSelector{towerMinHwPt, towerMaxHwPt}, rhoEstimator{patchEtaSize, patchPhiSize} {}
+
+    CaloTowerPreSelector preSelector;
+    GridRhoEstimator rhoEstimator;
+
+    // towers rejected because of invalid lattice coordinates (reset at the end of every lumi)
+    CaloTowerPreSelector::InvalidTowerCounts invalidTowers;
+  };
+}  // namespace l1tCaloTowerRhoProducer
+
+class L1TCaloTowerRhoProducer
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerRhoProducer::Workspace>,
+                                     edm::LuminosityBlockSummaryCache<CaloTowerPreSelector::InvalidTowerCounts>> {
+public:
+  explicit L1TCaloTowerRhoProducer(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  using Workspace = l1tCaloTowerRhoProducer::Workspace;
+  using InvalidTowerCounts = CaloTowerPreSelector::InvalidTowerCounts;
+
+  std::unique_ptr<Workspace> beginStream(edm::StreamID) const override;
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  std::shared_ptr<InvalidTowerCounts> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const override;
+  void streamEndLuminosityBlockSummary(edm::StreamID,
+                                       edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+
+  edm::EDGetTokenT<l1t::CaloTowerBxCollection> const srcToken_;
+  int const bunchCrossing_;
+  int const towerMinHwPt_;
+  int const towerMaxHwPt_;
+  int const patchEtaSize_;
+  int const patchPhiSize_;
+  bool const computeJetAreas_;
+  edm::EDGetTokenT<l1t::JetBxCollection> jetsToken_;
+  double const jetAreaRParam_;
+
+  edm::EDPutTokenT<double> const rhoPutToken_;
+  edm::EDPutTokenT<std::vector<double>> const ringRhosPutToken_;
+  edm::EDPutTokenT<std::vector<double>> jetAreasPutToken_;
+};
+
+L1TCaloTowerRhoProducer::L1TCaloTowerRhoProducer(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      bunchCrossing_{iConfig.getParameter<int>("bunchCrossing")},
+      towerMinHwPt_{iConfig.getParameter<int>("towerMinHwPt")},
+      towerMaxHwPt_{iConfig.getParameter<int>("towerMaxHwPt")},
+      patchEtaSize_{iConfig.getParameter<int>("patchEtaSize")},
+      patchPhiSize_{iConfig.getParameter<int>("patchPhiSize")},
+      computeJetAreas_{not iConfig.getParameter<edm::InputTag>("jets").label().empty()},
+      jetAreaRParam_{iConfig.getParameter<double>("jetAreaRParam")},
+      rhoPutToken_{produces<double>()},
+      ringRhosPutToken_{produces<std::vector<double>>("rings")} {
+  if (computeJetAreas_) {
+    jetsToken_ = consumes(iConfig.getParameter<edm::InputTag>("jets"));
+    jetAreasPutToken_ = produces<std::vector<double>>("jetAreas");
+  }
+}
+
+std::unique_ptr<L1TCaloTowerRhoProducer::Workspace> L1TCaloTowerRhoProducer::beginStream(edm::StreamID) const {
+  return std::make_unique<Workspace>(patchEtaSize_, patchPhiSize_, towerMinHwPt_, towerMaxHwPt_);
+}
+
+std::shared_ptr<L1TCaloTowerRhoProducer::InvalidTowerCounts> L1TCaloTowerRhoProducer::globalBeginLuminosityBlockSummary(
+    edm::LuminosityBlock const&, edm::EventSetup const&) const {
+  return std::make_shared<InvalidTowerCounts>();
+}
+
+void L1TCaloTowerRhoProducer::streamEndLuminosityBlockSummary(edm::StreamID streamID,
+                                                              edm::LuminosityBlock const&,
+                                                              edm::EventSetup const&,
+                                                              InvalidTowerCounts* summary) const {
+  summary->take(streamCache(streamID)->invalidTowers);
+}
+
+void L1TCaloTowerRhoProducer::globalEndLuminosityBlockSummary(edm::LuminosityBlock const& iLumi,
+                                                              edm::EventSetup const&,
+                                                              InvalidTowerCounts* summary) const {
+  summary->report("L1TCaloTowerRhoProducer", moduleDescription().moduleLabel(), iLumi, "the rho estimation");
+}
+
+void L1TCaloTowerRhoProducer::produce(edm::StreamID streamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  auto& workspace = *streamCache(streamID);
+  auto& rhoEstimator = workspace.rhoEstimator;
+  rhoEstimator.clear();
+
+  if (bunchCrossing_ >= inputs.getFirstBX() and bunchCrossing_ <= inputs.getLastBX()) {
+    // towers in the hwPt window with valid lattice coordinates (towers with invalid coordinates are counted)
+    auto& preSelector = workspace.preSelector;
+    preSelector.select(inputs, bunchCrossing_);
+
+    if (preSelector.nInvalidHwEta() + preSelector.nInvalidHwPhi() > 0) {
+      workspace.invalidTowers.addBX(preSelector.nInvalidHwEta(), preSelector.nInvalidHwPhi());
+    }
+
+    for (auto const idx : preSelector.indices()) {
+      auto const& input = inputs.at(bunchCrossing_, idx);
+      rhoEstimator.addTower(input.hwPt(), input.hwEta(), input.hwPhi());
+    }
+  }
+
+  rhoEstimator.run();
+
+  LogTrace("L1TCaloTowerRhoProducer") << "[L1TCaloTowerRhoProducer] [" << moduleDescription().moduleLabel()
+                                      << "] rho = " << rhoEstimator.rho();
+
+  iEvent.emplace(rhoPutToken_, rhoEstimator.rho());
+  iEvent.emplace(ringRhosPutToken_, rhoEstimator.ringRhos());
+
+  if (computeJetAreas_) {
+    // one value per jet in bunchCrossing, in the same order as in the jet collection
+    auto const& jets = iEvent.get(jetsToken_);
+
+    std::vector<double> jetAreas;
+    if (bunchCrossing_ >= jets.getFirstBX() and bunchCrossing_ <= jets.getLastBX()) {
+      auto const nJets = jets.size(bunchCrossing_);
+      jetAreas.reserve(nJets);
+      for (auto idx = 0u; idx < nJets; ++idx) {
+        auto const& jet = jets.at(bunchCrossing_, idx);
+        jetAreas.emplace_back(rhoEstimator.jetArea(jet.eta(), jet.phi(), jetAreaRParam_));
+      }
+    }
+
+    iEvent.emplace(jetAreasPutToken_, std::move(jetAreas));
+  }
+}
+
+void L1TCaloTowerRhoProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input product (type: l1t::CaloTowerBxCollection)");
+  desc.add<int>("bunchCrossing", 0)->setComment("BX value");
+  desc.add<int>("towerMinHwPt", 1)->setComment("Min hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
+  desc.add<int>("towerMaxHwPt", -1)->setComment("Max hwPt (inclusive) of l1t::CaloTowers (ignored if negative)");
+  desc.add<int>("patchEtaSize", 1)
+      ->setComment("Size in eta of the patches used to compute rho (in units of towers, 1 gives rho per tower ring)");
+  desc.add<int>("patchPhiSize", 8)->setComment("Size in phi of the patches used to compute rho (in units of towers)");
+  desc.add<edm::InputTag>("jets", edm::InputTag())
+      ->setComment(
+          "Jets for which to compute the lattice area (type: l1t::JetBxCollection, "
+          "output \"jetAreas\" has one value per jet in bunchCrossing; ignored if empty)");
+  desc.add<double>("jetAreaRParam", 0.4)->setComment("Radius used to compute the lattice area of the jets");
+
+  descriptions.add("l1tCaloTowerRhoProducer", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TCaloTowerRhoProducer);
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+#include "L1ScoutingTools/Reconstruction/interface/SlidingWindowJetFinder.h"
+
+namespace l1tCaloTowerSlidingWindowJetProducer {
+  // per-stream buffers, re-used across BXs and events
+  struct Workspace {
+    Workspace(int const towerMinHwPt, int const towerMaxHwPt, int const windowHalfSize, int const seedMinHwPt)
+        : preSelector{towerMinHwPt, towerMaxHwPt}, jetFinder{windowHalfSize, seedMinHwPt} {}
+
+    CaloTowerPreSelector preSelector;
+    SlidingWindowJetFinder jetFinder;
+
+    // towers rejected because of invalid lattice coordinates
+    CaloTowerPreSelector::InvalidTowerCounts invalidTowers;
+  };
+}  // namespace l1tCaloTowerSlidingWindowJetProducer
+
+class L1TCaloTowerSlidingWindowJetProducer
+    : public edm::global::EDProducer<edm::StreamCache<l1tCaloTowerSlidingWindowJetProducer::Workspace>,
+                                     edm::LuminosityBlockSummaryCache<CaloTowerPreSelector::InvalidTowerCounts>> {
+public:
+  explicit L1TCaloTowerSlidingWindowJetProducer(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  using Workspace = l1tCaloTowerSlidingWindowJetProducer::Workspace;
+  using InvalidTowerCounts = CaloTowerPreSelector::InvalidTowerCounts;
+
+  std::unique_ptr<Workspace> beginStream(edm::StreamID) const override;
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+  std::shared_ptr<InvalidTowerCounts> globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const override;
+  void streamEndLuminosityBlockSummary(edm::StreamID,
+                                       edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+  void globalEndLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                       edm::EventSetup const&,
+                                       InvalidTowerCounts*) const override;
+
+  edm::EDGetTokenT<l1t::CaloTowerBxCollection> const srcToken_;
+  int const bxMin_;
+  int const bxMax_;
+  int const towerMinHwPt_;
+  int const towerMaxHwPt_;
+  int const windowHalfSize_;
+  int const seedMinHwPt_;
+  double const jetPtMin_;
+};
+
+L1TCaloTowerSlidingWindowJetProducer::L1TCaloTowerSlidingWindowJetProducer(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      bxMin_{iConfig.getParameter<int>("bxMin")},
+      bxMax_{iConfig.getParameter<int>("bxMax")},
+      towerMinHwPt_{iConfig.getParameter<int>("towerMinHwPt")},
+      towerMaxHwPt_{iConfig.getParameter<int>("towerMaxHwPt")},
+      windowHalfSize_{iConfig.getParameter<int>("windowHalfSize")},
+      seedMinHwPt_{iConfig.getParameter<int>("seedMinHwPt")},
+      jetPtMin_{iConfig.getParameter<double>("jetPtMin")} {
+  produces<l1t::JetBxCollection>();
+}
+
+std::unique_ptr<L1TCaloTowerSlidingWindowJetProducer::Workspace> L1TCaloTowerSlidingWindowJetProducer::beginStream(
+    edm::StreamID) const {
+  return std::make_unique<Workspace>(towerMinHwPt_, towerMaxHwPt_, windowHalfSize_, seedMinHwPt_);
+}
+
+std::shared_ptr<L1TCaloTowerSlidingWindowJetProducer::InvalidTowerCounts>
+L1TCaloTowerSlidingWindowJetProducer::globalBeginLuminosityBlockSummary(edm::LuminosityBlock const&,
+                                                                        edm::EventSetup const&) const {
+  return std::make_shared<InvalidTowerCounts>();
+}
+
+void L1TCaloTowerSlidingWindowJetProducer::streamEndLuminosityBlockSummary(edm::StreamID streamID,
+                                                                           edm::LuminosityBlock const&,
+                                                                           edm::EventSetup const&,
+                                                                           InvalidTowerCounts* summary) const {
+  auto& workspace = *streamCache(streamID);
+  summary->take(workspace.invalidTowers);
+}
+
+void L1TCaloTowerSlidingWindowJetProducer::globalEndLuminosityBlockSummary(edm::LuminosityBlock const& iLumi,
+                                                                           edm::EventSetup const&,
+                                                                           InvalidTowerCounts* summary) const {
+  summary->report("ScoutingJetProducer", moduleDescription().moduleLabel(), iLumi, "jet finding");
+}
+
+void L1TCaloTowerSlidingWindowJetProducer::produce(edm::StreamID streamID,
+                                                   edm::Event& iEvent,
+                                                   edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  auto& workspace = *streamCache(streamID);
+  auto& preSelector = workspace.preSelector;
+  auto& jetFinder = workspace.jetFinder;
+
+  auto const bxMin = std::max(bxMin_, inputs.getFirstBX());
+  auto const bxMax = std::min(bxMax_, inputs.getLastBX());
+
+  auto output = std::make_unique<l1t::JetBxCollection>(0, bxMin, bxMax);
+
+  for (auto bx = bxMin; bx <= bxMax; ++bx) {
+    jetFinder.clear();
+
+    // towers with invalid hwEta or hwPhi values are not selected, and are reported once per lumi-section
+    preSelector.select(inputs, bx);
+    workspace.invalidTowers.addBX(preSelector.nInvalidHwEta(), preSelector.nInvalidHwPhi());
+
+    for (auto const idx : preSelector.indices()) {
+      auto const& input = inputs.at(bx, idx);
+      jetFinder.addTower(input.hwPt(), input.hwEta(), input.hwPhi());
+    }
+
+    jetFinder.run();
+
+    for (auto const& jet : jetFinder.jets(jetPtMin_)) {
+      output->push_back(bx, l1t::Jet{l1t::Jet::LorentzVector{jet.px, jet.py, jet.pz, jet.E}});
+    }
+
+    LogTrace("L1TCaloTowerSlidingWindowJetProducer")
+        << "[L1TCaloTowerSlidingWindowJetProducer] [" << moduleDescription().moduleLabel() << "] BX=" << bx
+        << " towers=" << jetFinder.nInputs() << " jets=" << output->size(bx);
+  }
+
+  iEvent.put(std::move(output));
+}
+
+void L1TCaloTowerSlidingWindowJetProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input product (type: l1t::CaloTowerBxCollection)");
+  desc.add<int>("bxMin", -2)->setComment("Min BX (inclusive)");
+  desc.add<int>("bxMax", 2)->setComment("Max BX (inclusive)");
+  desc.add<int>("towerMinHwPt", 1)
+      ->setComment("Min hwPt (inclusive) of l1t::CaloTowers used for jet finding (ignored if negative)");
+  desc.add<int>("towerMaxHwPt", -1)
+      ->setComment("Max hwPt (inclusive) of l1t::CaloTowers used for jet finding (ignored if negative)");
+  desc.add<int>("windowHalfSize", 4)
+      ->setComment("Half-size of the square window of towers (in units of towers, 4 corresponds to a 9x9 window)");
+  desc.add<int>("seedMinHwPt", 8)->setComment("Min hwPt (inclusive) of the seed tower");
+  desc.add<double>("jetPtMin", 0)->setComment("Minimum pT of output jets");
+
+  descriptions.add("l1tCaloTowerSlidingWindowJetProducer", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TCaloTowerSlidingWindowJetProducer);
@@ -0,0 +1,150 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/Framework/interface/EventSetupRecordIntervalFinder.h"
+#include "FWCore/Framework/interface/IOVSyncValue.h"
+#include "FWCore/Framework/interface/SourceFactory.h"
+#include "FWCore/Framework/interface/ValidityInterval.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+#include "L1ScoutingTools/Reconstruction/interface/L1ScoutingJetCorrectorRcd.h"
+
+// JetCorrector in the EventSetup, built once per IOV and shared by all the modules which consume it.
+// The IOVs are given by the first runs of the JEC files (every file is valid until the first run of the next one).
+class L1TJetCorrectorESSource : public edm::ESProducer, public edm::EventSetupRecordIntervalFinder {
+public:
+  explicit L1TJetCorrectorESSource(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+  std::unique_ptr<JetCorrector> produce(L1ScoutingJetCorrectorRcd const&);
+
+private:
+  void setIntervalFor(edm::eventsetup::EventSetupRecordKey const&,
+                      edm::IOVSyncValue const&,
+                      edm::ValidityInterval&) override;
+
+  struct JecFile {
+    unsigned int firstRun;
+    edm::FileInPath jecFile;
+  };
+
+  // index of the JEC file of a run (-1 if the run is before the first run of the first file)
+  int jecFileIndex(unsigned int run) const;
+
+  JetCorrector::FormulaType const formulaType_;
+  double const tabulationTolerance_;
+  std::vector<JecFile> jecFiles_;
+};
+
+L1TJetCorrectorESSource::L1TJetCorrectorESSource(edm::ParameterSet const& iConfig)
+    : formulaType_{[&iConfig]() {
+        auto const formulaType = iConfig.getParameter<std::string>("formulaType");
+        if (formulaType == "CorrectionFactor") {
+          return JetCorrector::FormulaType::CorrectionFactor;
+        } else if (formulaType == "CorrectedPt") {
+          return JetCorrector::FormulaType::CorrectedPt;
+        }
+        throw cms::Exception("Configuration")
+            << "invalid value for parameter \"formulaType\" (must be \"CorrectionFactor\" or \"CorrectedPt\"): \""
+            << formulaType << "\"";
+      }()},
+      tabulationTolerance_{iConfig.getParameter<double>("jecTabulationTolerance")} {
+  for (auto const& pset : iConfig.getParameterSetVector("jecFiles")) {
+    auto const firstRun = pset.getParameter<unsigned int>("firstRun");
+    if (not jecFiles_.empty() and firstRun <= jecFiles_.back().firstRun) {
+      throw cms::Exception("Configuration")
+          << "invalid value for parameter \"jecFiles\" (the values of \"firstRun\" must be strictly increasing): "
+          << jecFiles_.back().firstRun << " followed by " << firstRun;
+    }
+    jecFiles_.emplace_back(JecFile{firstRun, pset.getParameter<edm::FileInPath>("jecFile")});
+  }
+
+  if (jecFiles_.empty()) {
+    throw cms::Exception("Configuration") << "invalid value for parameter \"jecFiles\" (empty)";
+  }
+
+  setWhatProduced(this);
+  findingRecord<L1ScoutingJetCorrectorRcd>();
+}
+
+int L1TJetCorrectorESSource::jecFileIndex(unsigned int const run) const {
+  int idx{-1};
+  while (idx + 1 < int(jecFiles_.size()) and jecFiles_[idx + 1].firstRun <= run) {
+    ++idx;
+  }
+  return idx;
+}
+
+void L1TJetCorrectorESSource::setIntervalFor(edm::eventsetup::EventSetupRecordKey const&,
+                                             edm::IOVSyncValue const& iTime,
+                                             edm::ValidityInterval& oInterval) {
+  auto const idx = jecFileIndex(iTime.eventID().run());
+  if (idx < 0) {
+    oInterval = edm::ValidityInterval::invalidInterval();
+    return;
+  }
+
+  edm::IOVSyncValue const first{edm::EventID(jecFiles_[idx].firstRun, 0, 0)};
+  if (idx + 1 < int(jecFiles_.size())) {
+    edm::IOVSyncValue const last{edm::EventID(jecFiles_[idx + 1].firstRun - 1,
+                                              edm::EventID::maxLuminosityBlockNumber(),
+                                              edm::EventID::maxEventNumber())};
+    oInterval = edm::ValidityInterval(first, last);
+  } else {
+    oInterval = edm::ValidityInterval(first, edm::IOVSyncValue::endOfTime());
+  }
+}
+
+std::unique_ptr<JetCorrector> L1TJetCorrectorESSource::produce(L1ScoutingJetCorrectorRcd const& iRecord) {
+  auto const& jecFile = jecFiles_[jecFileIndex(iRecord.validityInterval().first().eventID().run())];
+
+  auto jetCorrector = std::make_unique<JetCorrector>(jecFile.jecFile.fullPath(), formulaType_, true, tabulationTolerance_);
+
+  edm::LogInfo("L1TJetCorrectorESSource")
+      << "jet-energy-scale corrections for runs >= " << jecFile.firstRun << " from " << jecFile.jecFile.relativePath()
+      << ": " << jetCorrector->nBins() << " bins in " << jetCorrector->nEtaBins() << " eta bins";
+
+  if (jetCorrector->tabulated()) {
+    edm::LogInfo("L1TJetCorrectorESSource")
+        << "jet-energy-scale corrections from " << jecFile.jecFile.relativePath() << " tabulated with "
+        << jetCorrector->tableSize() << " points for " << jetCorrector->nBins()
+        << " bins: max relative deviation from the formulas = " << jetCorrector->maxTabulationDeviation()
+        << " (tolerance = " << tabulationTolerance_ << ")";
+  }
+
+  return jetCorrector;
+}
+
+void L1TJetCorrectorESSource::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  edm::ParameterSetDescription jecFileDesc;
+  jecFileDesc.add<unsigned int>("firstRun", 1)->setComment("First run for which the JEC file is valid");
+  jecFileDesc.add<edm::FileInPath>("jecFile")->setComment(
+      "Path to file containing jet-energy-scale corrections (text file, or binary file converted with l1sConvertJEC)");
+
+  desc.addVPSet("jecFiles", jecFileDesc, {})
+      ->setComment(
+          "JEC files, in increasing order of \"firstRun\" "
+          "(every file is valid from its first run until the first run of the next file)");
+  desc.add<std::string>("formulaType")
+      ->setComment(
+          "Meaning of the value of the JEC formulas: \"CorrectionFactor\" (L1TCaloTowerJetCorrectorB) "
+          "or \"CorrectedPt\" (L1TCaloTowerJetCorrectorC)");
+  desc.add<double>("jecTabulationTolerance", 0)
+      ->setComment(
+          "Max relative deviation of the corrections interpolated from tables sampled at construction "
+          "(if not positive, the formulas are evaluated for every jet)");
+  desc.add<std::string>("appendToDataLabel", "")->setComment("Label of the JetCorrector product");
+
+  descriptions.addDefault(desc);
+}
+
+DEFINE_FWK_EVENTSETUP_SOURCE(L1TJetCorrectorESSource);
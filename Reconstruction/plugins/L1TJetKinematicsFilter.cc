@@ -1,65 +1,100 @@
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
 
 #include "DataFormats/L1Trigger/interface/Jet.h"
 #include "FWCore/Framework/interface/global/EDFilter.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
 
-class L1TJetKinematicsFilter : public edm::global::EDFilter<> {
+// T: type of the input jet collection (l1t::JetBxCollection or JetSoABxCollection)
+template <typename T>
+class L1TJetKinematicsFilterT : public edm::global::EDFilter<> {
 public:
-  explicit L1TJetKinematicsFilter(edm::ParameterSet const&);
+  explicit L1TJetKinematicsFilterT(edm::ParameterSet const&);
 
   static void fillDescriptions(edm::ConfigurationDescriptions&);
 
 private:
   bool filter(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
 
-  edm::EDGetTokenT<l1t::JetBxCollection> const srcToken_;
+  // single precision, as the jets of a JetSoABxCollection: same decision for both types of input
+  bool selected(float const pt, float const eta) const {
+    auto const absEta = std::abs(eta);
+    return (absEtaMin_ < 0 or absEta > absEtaMin_) and (absEtaMax_ < 0 or absEta < absEtaMax_) and pt > ptMin_;
+  }
+
+  int countJets(l1t::JetBxCollection const&, int bxMin, int bxMax) const;
+  int countJets(JetSoABxCollection const&, int bxMin, int bxMax) const;
+
+  edm::EDGetTokenT<T> const srcToken_;
   int const bxMin_;
   int const bxMax_;
   int const nMin_;
-  double const ptMin_;
-  double const absEtaMin_;
-  double const absEtaMax_;
+  float const ptMin_;
+  float const absEtaMin_;
+  float const absEtaMax_;
 };
 
-L1TJetKinematicsFilter::L1TJetKinematicsFilter(edm::ParameterSet const& iConfig)
+template <typename T>
+L1TJetKinematicsFilterT<T>::L1TJetKinematicsFilterT(edm::ParameterSet const& iConfig)
     : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
       bxMin_{iConfig.getParameter<int>("bxMin")},
       bxMax_{iConfig.getParameter<int>("bxMax")},
       nMin_{iConfig.getParameter<int>("nMin")},
-      ptMin_{iConfig.getParameter<double>("ptMin")},
-      absEtaMin_{iConfig.getParameter<double>("absEtaMin")},
-      absEtaMax_{iConfig.getParameter<double>("absEtaMax")} {}
+      ptMin_{float(iConfig.getParameter<double>("ptMin"))},
+      absEtaMin_{float(iConfig.getParameter<double>("absEtaMin"))},
+      absEtaMax_{float(iConfig.getParameter<double>("absEtaMax"))} {}
 
-bool L1TJetKinematicsFilter::filter(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
+template <typename T>
+bool L1TJetKinematicsFilterT<T>::filter(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
   auto const& inputs = iEvent.get(srcToken_);
 
   auto const bxMin = std::max(bxMin_, inputs.getFirstBX());
   auto const bxMax = std::min(bxMax_, inputs.getLastBX());
 
+  return (countJets(inputs, bxMin, bxMax) >= nMin_);
+}
+
+template <typename T>
+int L1TJetKinematicsFilterT<T>::countJets(l1t::JetBxCollection const& inputs, int const bxMin, int const bxMax) const {
   int nJets{0};
 
   for (auto bx = bxMin; bx <= bxMax; ++bx) {
     auto const nInputs = inputs.size(bx);
     for (auto idx = 0u; idx < nInputs; ++idx) {
-      auto jet = inputs.at(bx, idx);
-      auto const jetAbsEta = std::abs(jet.eta());
-      if ((absEtaMin_ < 0 or jetAbsEta > absEtaMin_) and
-          (absEtaMax_ < 0 or jetAbsEta < absEtaMax_) and jet.pt() > ptMin_) {
-        ++nJets;
-      }
+      auto const& jet = inputs.at(bx, idx);
+      nJets += selected(jet.pt(), jet.eta());
     }
   }
 
-  return (nJets >= nMin_);
+  return nJets;
 }
 
-void L1TJetKinematicsFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+template <typename T>
+int L1TJetKinematicsFilterT<T>::countJets(JetSoABxCollection const& inputs, int const bxMin, int const bxMax) const {
+  // the jets of the BX range are contiguous in the input arrays
+  auto const pts = inputs.pt(bxMin, bxMax);
+  auto const etas = inputs.eta(bxMin, bxMax);
+
+  int nJets{0};
+  for (auto idx = 0u; idx < pts.size(); ++idx) {
+    nJets += selected(pts[idx], etas[idx]);
+  }
+
+  return nJets;
+}
+
+template <typename T>
+void L1TJetKinematicsFilterT<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
 
-  desc.add<edm::InputTag>("src")->setComment("Input jets (type: l1t::JetBxCollection)");
+  constexpr bool isSoA = std::is_same_v<T, JetSoABxCollection>;
+
+  desc.add<edm::InputTag>("src")->setComment(isSoA ? "Input jets (type: JetSoABxCollection)"
+                                                   : "Input jets (type: l1t::JetBxCollection)");
   desc.add<int>("bxMin", 0)->setComment("Min BX (inclusive)");
   desc.add<int>("bxMax", 0)->setComment("Max BX (inclusive)");
   desc.add<int>("nMin", 0)->setComment("Min number of jets required to pass pT and |eta| selections (inclusive)");
@@ -67,8 +102,12 @@ void L1TJetKinematicsFilter::fillDescriptions(edm::ConfigurationDescriptions& de
   desc.add<double>("absEtaMin", -1)->setComment("Min jet |eta| (ignored if negative)");
   desc.add<double>("absEtaMax", -1)->setComment("Max jet |eta| (ignored if negative)");
 
-  descriptions.add("l1tJetKinematicsFilter", desc);
+  descriptions.add(isSoA ? "l1tJetSoAKinematicsFilter" : "l1tJetKinematicsFilter", desc);
 }
 
+using L1TJetKinematicsFilter = L1TJetKinematicsFilterT<l1t::JetBxCollection>;
+using L1TJetSoAKinematicsFilter = L1TJetKinematicsFilterT<JetSoABxCollection>;
+
 #include "FWCore/Framework/interface/MakerMacros.h"
 DEFINE_FWK_MODULE(L1TJetKinematicsFilter);
+DEFINE_FWK_MODULE(L1TJetSoAKinematicsFilter);
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DataFormats/NanoAOD/interface/FlatTable.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+
+// NanoAOD table of the jets of a JetSoABxCollection in a range of BXs:
+// the columns are filled directly from the (contiguous) arrays of the input collection
+class L1TJetSoAFlatTableProducer : public edm::global::EDProducer<> {
+public:
+  explicit L1TJetSoAFlatTableProducer(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+
+  edm::EDGetTokenT<JetSoABxCollection> const srcToken_;
+  std::string const name_;
+  std::string const doc_;
+  int const minBX_;
+  int const maxBX_;
+  bool const extension_;
+  int const precision_;
+  edm::EDPutTokenT<nanoaod::FlatTable> const putToken_;
+};
+
+L1TJetSoAFlatTableProducer::L1TJetSoAFlatTableProducer(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      name_{iConfig.getParameter<std::string>("name")},
+      doc_{iConfig.getParameter<std::string>("doc")},
+      minBX_{iConfig.getParameter<int>("minBX")},
+      maxBX_{iConfig.getParameter<int>("maxBX")},
+      extension_{iConfig.getParameter<bool>("extension")},
+      precision_{iConfig.getParameter<int>("precision")},
+      putToken_{produces<nanoaod::FlatTable>()} {}
+
+void L1TJetSoAFlatTableProducer::produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& jets = iEvent.get(srcToken_);
+
+  auto const minBX = std::max(minBX_, jets.getFirstBX());
+  auto const maxBX = std::min(maxBX_, jets.getLastBX());
+
+  auto const pts = jets.pt(minBX, maxBX);
+
+  auto table = std::make_unique<nanoaod::FlatTable>(pts.size(), name_, false, extension_);
+  table->setDoc(doc_);
+
+  table->addColumn<float>("pt", pts, "", precision_);
+  table->addColumn<float>("eta", jets.eta(minBX, maxBX), "", precision_);
+  table->addColumn<float>("phi", jets.phi(minBX, maxBX), "", precision_);
+  table->addColumn<float>("mass", jets.mass(minBX, maxBX), "", precision_);
+
+  if (minBX_ != maxBX_) {
+    std::vector<int> bxs;
+    bxs.reserve(pts.size());
+    for (auto bx = minBX; bx <= maxBX; ++bx) {
+      bxs.insert(bxs.end(), jets.size(bx), bx);
+    }
+    table->addColumn<int>("bx", bxs, "BX of the jet");
+  }
+
+  iEvent.put(putToken_, std::move(table));
+}
+
+void L1TJetSoAFlatTableProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input jets (type: JetSoABxCollection)");
+  desc.add<std::string>("name")->setComment("Name of the table");
+  desc.add<std::string>("doc", "")->setComment("Documentation string of the table");
+  desc.add<int>("minBX", 0)->setComment("Min BX (inclusive)");
+  desc.add<int>("maxBX", 0)->setComment("Max BX (inclusive)");
+  desc.add<bool>("extension", false)->setComment("Whether the table is an extension of another table");
+  desc.add<int>("precision", 12)->setComment("Number of mantissa bits of the float columns (pt, eta, phi, mass)");
+
+  descriptions.add("l1tJetSoAFlatTableProducer", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TJetSoAFlatTableProducer);
@@ -0,0 +1,84 @@
+#include <algorithm>
+
+#include "FWCore/Framework/interface/global/EDFilter.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyBxArray.h"
+
+// Selection of events with at least one BX in [bxMin, bxMax] passing all the requirements on the jet topological
+// quantities of a JetTopologyBxArray (e.g. HT, or mjj and |delta-eta| of the leading pair for VBF-like topologies).
+// The values of every BX are read directly from the per-BX arrays of the input product.
+class L1TJetTopologyFilter : public edm::global::EDFilter<> {
+public:
+  explicit L1TJetTopologyFilter(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  bool filter(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+
+  bool selected(JetTopologyBxArray const&, int bx) const;
+
+  edm::EDGetTokenT<JetTopologyBxArray> const srcToken_;
+  int const bxMin_;
+  int const bxMax_;
+  int const nJetsMin_;
+  double const htMin_;
+  double const mhtMin_;
+  double const mjjMin_;
+  double const dEtajjMin_;
+  double const dEtajjMax_;
+};
+
+L1TJetTopologyFilter::L1TJetTopologyFilter(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      bxMin_{iConfig.getParameter<int>("bxMin")},
+      bxMax_{iConfig.getParameter<int>("bxMax")},
+      nJetsMin_{iConfig.getParameter<int>("nJetsMin")},
+      htMin_{iConfig.getParameter<double>("htMin")},
+      mhtMin_{iConfig.getParameter<double>("mhtMin")},
+      mjjMin_{iConfig.getParameter<double>("mjjMin")},
+      dEtajjMin_{iConfig.getParameter<double>("dEtajjMin")},
+      dEtajjMax_{iConfig.getParameter<double>("dEtajjMax")} {}
+
+bool L1TJetTopologyFilter::filter(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& topology = iEvent.get(srcToken_);
+
+  auto const bxMin = std::max(bxMin_, topology.getFirstBX());
+  auto const bxMax = std::min(bxMax_, topology.getLastBX());
+
+  for (auto bx = bxMin; bx <= bxMax; ++bx) {
+    if (selected(topology, bx)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool L1TJetTopologyFilter::selected(JetTopologyBxArray const& topology, int const bx) const {
+  auto const values = topology.values(bx);
+  return values.nJets >= nJetsMin_ and (htMin_ < 0 or values.ht > htMin_) and
+         (mhtMin_ < 0 or topology.mht(bx) > mhtMin_) and (mjjMin_ < 0 or values.mjj > mjjMin_) and
+         (dEtajjMin_ < 0 or values.dEtajj > dEtajjMin_) and (dEtajjMax_ < 0 or values.dEtajj < dEtajjMax_);
+}
+
+void L1TJetTopologyFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input jet topological quantities (type: JetTopologyBxArray)");
+  desc.add<int>("bxMin", 0)->setComment("Min BX (inclusive)");
+  desc.add<int>("bxMax", 0)->setComment("Max BX (inclusive)");
+  desc.add<int>("nJetsMin", 0)->setComment("Min number of jets used for HT, MHT, and the leading pair (inclusive)");
+  desc.add<double>("htMin", -1)->setComment("Min HT (ignored if negative)");
+  desc.add<double>("mhtMin", -1)->setComment("Min MHT (ignored if negative)");
+  desc.add<double>("mjjMin", -1)->setComment("Min invariant mass of the two leading jets (ignored if negative)");
+  desc.add<double>("dEtajjMin", -1)->setComment("Min |delta-eta| of the two leading jets (ignored if negative)");
+  desc.add<double>("dEtajjMax", -1)->setComment("Max |delta-eta| of the two leading jets (ignored if negative)");
+
+  descriptions.add("l1tJetTopologyFilter", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TJetTopologyFilter);
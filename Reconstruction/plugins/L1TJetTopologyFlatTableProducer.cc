@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "DataFormats/NanoAOD/interface/FlatTable.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyBxArray.h"
+
+// NanoAOD table of the jet topological quantities of a JetTopologyBxArray in a range of BXs (one row per BX):
+// the columns are filled directly from the per-BX arrays of the input product
+// (one int column per jet count, named after the label of the jet count)
+class L1TJetTopologyFlatTableProducer : public edm::global::EDProducer<> {
+public:
+  explicit L1TJetTopologyFlatTableProducer(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+
+  edm::EDGetTokenT<JetTopologyBxArray> const srcToken_;
+  std::string const name_;
+  std::string const doc_;
+  int const minBX_;
+  int const maxBX_;
+  bool const extension_;
+  int const precision_;
+  edm::EDPutTokenT<nanoaod::FlatTable> const putToken_;
+};
+
+L1TJetTopologyFlatTableProducer::L1TJetTopologyFlatTableProducer(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      name_{iConfig.getParameter<std::string>("name")},
+      doc_{iConfig.getParameter<std::string>("doc")},
+      minBX_{iConfig.getParameter<int>("minBX")},
+      maxBX_{iConfig.getParameter<int>("maxBX")},
+      extension_{iConfig.getParameter<bool>("extension")},
+      precision_{iConfig.getParameter<int>("precision")},
+      putToken_{produces<nanoaod::FlatTable>()} {}
+
+void L1TJetTopologyFlatTableProducer::produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& topology = iEvent.get(srcToken_);
+
+  auto const minBX = std::max(minBX_, topology.getFirstBX());
+  auto const maxBX = std::min(maxBX_, topology.getLastBX());
+
+  // rows: BXs [minBX, maxBX] (i-th value of the arrays of the input product: BX firstBX + i)
+  unsigned int const nRows = std::max(0, maxBX - minBX + 1);
+  unsigned int const first = (nRows > 0) ? minBX - topology.getFirstBX() : 0;
+
+  auto const rows = [first, nRows](auto const& values) {
+    return std::vector<typename std::decay_t<decltype(values)>::value_type>(values.begin() + first,
+                                                                             values.begin() + first + nRows);
+  };
+
+  std::vector<float> mhts(nRows);
+  std::vector<float> mhtPhis(nRows);
+  for (auto irow = 0u; irow < nRows; ++irow) {
+    mhts[irow] = topology.mht(minBX + irow);
+    mhtPhis[irow] = topology.mhtPhi(minBX + irow);
+  }
+
+  auto table = std::make_unique<nanoaod::FlatTable>(nRows, name_, false, extension_);
+  table->setDoc(doc_);
+
+  table->addColumn<int>("nJets", rows(topology.nJets()), "Number of jets used for HT, MHT, and the leading pair");
+  table->addColumn<float>("ht", rows(topology.ht()), "Scalar sum of the jet pT", precision_);
+  table->addColumn<float>("mht", mhts, "Magnitude of the missing-HT vector", precision_);
+  table->addColumn<float>("mhtPhi", mhtPhis, "Azimuth of the missing-HT vector", precision_);
+  table->addColumn<float>("mjj", rows(topology.mjj()), "Invariant mass of the two leading jets", precision_);
+  table->addColumn<float>("dEtajj", rows(topology.dEtajj()), "|delta-eta| of the two leading jets", precision_);
+  table->addColumn<float>("dPhijj", rows(topology.dPhijj()), "|delta-phi| of the two leading jets", precision_);
+
+  auto const& countLabels = topology.countLabels();
+  for (auto icnt = 0u; icnt < countLabels.size(); ++icnt) {
+    table->addColumn<int>(countLabels[icnt], rows(topology.countArray(icnt)), "Jet count " + countLabels[icnt]);
+  }
+
+  if (minBX_ != maxBX_) {
+    std::vector<int> bxs(nRows);
+    for (auto irow = 0u; irow < nRows; ++irow) {
+      bxs[irow] = minBX + irow;
+    }
+    table->addColumn<int>("bx", bxs, "BX");
+  }
+
+  iEvent.put(putToken_, std::move(table));
+}
+
+void L1TJetTopologyFlatTableProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input jet topological quantities (type: JetTopologyBxArray)");
+  desc.add<std::string>("name")->setComment("Name of the table");
+  desc.add<std::string>("doc", "")->setComment("Documentation string of the table");
+  desc.add<int>("minBX", 0)->setComment("Min BX (inclusive)");
+  desc.add<int>("maxBX", 0)->setComment("Max BX (inclusive)");
+  desc.add<bool>("extension", false)->setComment("Whether the table is an extension of another table");
+  desc.add<int>("precision", 12)->setComment("Number of mantissa bits of the float columns");
+
+  descriptions.add("l1tJetTopologyFlatTableProducer", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TJetTopologyFlatTableProducer);
@@ -0,0 +1,186 @@
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyBxArray.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyCalculator.h"
+
+// Topological quantities of the (corrected) jets of every BX in [bxMin, bxMax] (type: JetTopologyBxArray),
+// computed with JetTopologyCalculator from the jet kinematics of every BX in SoA layout:
+//  - HT jets (pT > ptMin, |eta| in (absEtaMin, absEtaMax), same selection as L1TJetKinematicsFilter):
+//    multiplicity, HT, missing-HT vector, and mjj, |delta-eta|, |delta-phi| of the two leading HT jets,
+//  - multiplicity of the jets passing each of the (pT, |eta|) selections of "counts".
+// BXs without input jets (including the BXs outside the range of the input collection) have all values at zero.
+// T: type of the input jet collection (l1t::JetBxCollection or JetSoABxCollection)
+template <typename T>
+class L1TJetTopologyProducerT : public edm::global::EDProducer<> {
+public:
+  explicit L1TJetTopologyProducerT(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  void produce(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+
+  void fill(l1t::JetBxCollection const&, JetTopologyBxArray&) const;
+  void fill(JetSoABxCollection const&, JetTopologyBxArray&) const;
+
+  static JetTopologyCalculator::Selection selection(edm::ParameterSet const&);
+  static std::vector<std::string> countLabels(edm::ParameterSet const&);
+  static std::vector<JetTopologyCalculator::Selection> countSelections(edm::ParameterSet const&);
+
+  edm::EDGetTokenT<T> const srcToken_;
+  int const bxMin_;
+  int const bxMax_;
+  std::vector<std::string> const countLabels_;
+  JetTopologyCalculator const calculator_;
+
+  edm::EDPutTokenT<JetTopologyBxArray> const putToken_;
+};
+
+template <typename T>
+L1TJetTopologyProducerT<T>::L1TJetTopologyProducerT(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      bxMin_{iConfig.getParameter<int>("bxMin")},
+      bxMax_{iConfig.getParameter<int>("bxMax")},
+      countLabels_{countLabels(iConfig)},
+      calculator_{selection(iConfig), countSelections(iConfig)},
+      putToken_{produces<JetTopologyBxArray>()} {
+  if (bxMin_ > bxMax_) {
+    throw cms::Exception("Configuration")
+        << "invalid values for parameters \"bxMin\" and \"bxMax\" (bxMin must not be larger than bxMax): bxMin="
+        << bxMin_ << ", bxMax=" << bxMax_;
+  }
+}
+
+template <typename T>
+JetTopologyCalculator::Selection L1TJetTopologyProducerT<T>::selection(edm::ParameterSet const& pset) {
+  return JetTopologyCalculator::Selection{pset.getParameter<double>("ptMin"),
+                                          pset.getParameter<double>("absEtaMin"),
+                                          pset.getParameter<double>("absEtaMax")};
+}
+
+template <typename T>
+std::vector<std::string> L1TJetTopologyProducerT<T>::countLabels(edm::ParameterSet const& iConfig) {
+  std::vector<std::string> ret;
+  std::set<std::string> labels;
+  for (auto const& pset : iConfig.getParameterSetVector("counts")) {
+    auto const& label = ret.emplace_back(pset.getParameter<std::string>("label"));
+    if (label.empty() or not labels.insert(label).second) {
+      throw cms::Exception("Configuration")
+          << "invalid value for parameter \"label\" of \"counts\" (must be non-empty and unique): \"" << label << "\"";
+    }
+  }
+  return ret;
+}
+
+template <typename T>
+std::vector<JetTopologyCalculator::Selection> L1TJetTopologyProducerT<T>::countSelections(
+    edm::ParameterSet const& iConfig) {
+  std::vector<JetTopologyCalculator::Selection> ret;
+  for (auto const& pset : iConfig.getParameterSetVector("counts")) {
+    ret.emplace_back(selection(pset));
+  }
+  return ret;
+}
+
+template <typename T>
+void L1TJetTopologyProducerT<T>::produce(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  JetTopologyBxArray topology{bxMin_, bxMax_, countLabels_};
+  fill(inputs, topology);
+
+  LogTrace("L1TJetTopologyProducer") << "[L1TJetTopologyProducer] [" << moduleDescription().moduleLabel()
+                                     << "] BXs [" << bxMin_ << ", " << bxMax_ << "], HT(bx=" << bxMin_
+                                     << ") = " << topology.ht(bxMin_) << ", MHT(bx=" << bxMin_
+                                     << ") = " << topology.mht(bxMin_);
+
+  iEvent.emplace(putToken_, std::move(topology));
+}
+
+template <typename T>
+void L1TJetTopologyProducerT<T>::fill(l1t::JetBxCollection const& inputs, JetTopologyBxArray& topology) const {
+  std::vector<int> counts(countLabels_.size(), 0);
+
+  // kinematics of the jets of one BX in SoA layout (buffers re-used for every BX)
+  std::vector<float> pts;
+  std::vector<float> etas;
+  std::vector<float> phis;
+  std::vector<float> masses;
+
+  for (auto bx = bxMin_; bx <= bxMax_; ++bx) {
+    pts.clear();
+    etas.clear();
+    phis.clear();
+    masses.clear();
+
+    if (bx >= inputs.getFirstBX() and bx <= inputs.getLastBX()) {
+      for (auto it = inputs.begin(bx); it != inputs.end(bx); ++it) {
+        pts.emplace_back(it->pt());
+        etas.emplace_back(it->eta());
+        phis.emplace_back(it->phi());
+        masses.emplace_back(it->mass());
+      }
+    }
+
+    topology.set(bx, calculator_.compute(pts, etas, phis, masses, counts), counts);
+  }
+}
+
+template <typename T>
+void L1TJetTopologyProducerT<T>::fill(JetSoABxCollection const& inputs, JetTopologyBxArray& topology) const {
+  std::vector<int> counts(countLabels_.size(), 0);
+
+  for (auto bx = bxMin_; bx <= bxMax_; ++bx) {
+    // the jets of one BX are contiguous in the input arrays (empty spans for BXs outside the input range)
+    auto const values =
+        calculator_.compute(inputs.pt(bx, bx), inputs.eta(bx, bx), inputs.phi(bx, bx), inputs.mass(bx, bx), counts);
+    topology.set(bx, values, counts);
+  }
+}
+
+template <typename T>
+void L1TJetTopologyProducerT<T>::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  constexpr bool isSoA = std::is_same_v<T, JetSoABxCollection>;
+
+  desc.add<edm::InputTag>("src")->setComment(isSoA ? "Input jets (type: JetSoABxCollection)"
+                                                   : "Input jets (type: l1t::JetBxCollection)");
+  desc.add<int>("bxMin", 0)->setComment("Min BX (inclusive)");
+  desc.add<int>("bxMax", 0)->setComment("Max BX (inclusive)");
+  desc.add<double>("ptMin", 30)->setComment("Min pT of the jets used for HT, MHT, and the leading pair");
+  desc.add<double>("absEtaMin", -1)
+      ->setComment("Min |eta| of the jets used for HT, MHT, and the leading pair (ignored if negative)");
+  desc.add<double>("absEtaMax", 2.4)
+      ->setComment("Max |eta| of the jets used for HT, MHT, and the leading pair (ignored if negative)");
+
+  edm::ParameterSetDescription countDesc;
+  countDesc.add<std::string>("label")->setComment("Label of the jet count");
+  countDesc.add<double>("ptMin", 1)->setComment("Min jet pT");
+  countDesc.add<double>("absEtaMin", -1)->setComment("Min jet |eta| (ignored if negative)");
+  countDesc.add<double>("absEtaMax", -1)->setComment("Max jet |eta| (ignored if negative)");
+
+  desc.addVPSet("counts", countDesc, {})->setComment("Selections of the jet counts (multiplicities) of every BX");
+
+  descriptions.add(isSoA ? "l1tJetSoATopologyProducer" : "l1tJetTopologyProducer", desc);
+}
+
+using L1TJetTopologyProducer = L1TJetTopologyProducerT<l1t::JetBxCollection>;
+using L1TJetSoATopologyProducer = L1TJetTopologyProducerT<JetSoABxCollection>;
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TJetTopologyProducer);
+DEFINE_FWK_MODULE(L1TJetSoATopologyProducer);
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1Scouting/interface/OrbitCollection.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDFilter.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/EDPutToken.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+// Evaluates a list of jet seeds on every BX of an orbit of l1t::Jets, in one pass over the jets of every BX.
+// Every seed is a (nMin, ptMin, |eta|) condition, with the same selection of the jets as L1TJetKinematicsFilter:
+// a seed fires in a BX if at least nMin jets of the BX have pT > ptMin and |eta| in (absEtaMin, absEtaMax).
+// Products:
+//  - "SelBx": BXs in which at least one seed fired, in increasing order (type: std::vector<unsigned>, same as the
+//    SelBx product of the BX selectors of L1TriggerScouting, can be given to FinalBxSelector),
+//  - "SeedMasks": bitmask of the seeds fired in every BX of "SelBx" (bit i: i-th seed; type: std::vector<uint64_t>),
+//  - one SelBx-style product per seed (product instance label: label of the seed), with the BXs in which it fired.
+// The filter passes if at least one seed fired in the orbit.
+// In every BX, a seed is no longer evaluated once it fired, the seeds requiring more jets than the BX has are never
+// evaluated, and the loop over the jets stops once all the seeds have fired (or cannot fire anymore).
+class L1TOrbitJetSeedsFilter : public edm::global::EDFilter<> {
+public:
+  explicit L1TOrbitJetSeedsFilter(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  using Mask = std::uint64_t;
+  static constexpr unsigned int kMaxSeeds = 64;
+
+  struct Seed {
+    std::string label;
+    int nMin;
+    double ptMin;
+    double absEtaMin;
+    double absEtaMax;
+    edm::EDPutTokenT<std::vector<unsigned>> putToken;
+
+    bool selected(double const pt, double const absEta) const {
+      return (absEtaMin < 0 or absEta > absEtaMin) and (absEtaMax < 0 or absEta < absEtaMax) and pt > ptMin;
+    }
+  };
+
+  bool filter(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
+
+  // bitmask of the seeds fired by the jets of one BX
+  Mask firedSeeds(OrbitCollection<l1t::Jet> const&, unsigned int bx, std::vector<int>& counts) const;
+
+  edm::EDGetTokenT<OrbitCollection<l1t::Jet>> const srcToken_;
+
+  std::vector<Seed> seeds_;
+
+  // smallest nMin of all seeds (BXs with fewer jets are skipped)
+  int nMinAllSeeds_;
+
+  edm::EDPutTokenT<std::vector<unsigned>> const selBxPutToken_;
+  edm::EDPutTokenT<std::vector<Mask>> const seedMasksPutToken_;
+};
+
+L1TOrbitJetSeedsFilter::L1TOrbitJetSeedsFilter(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      nMinAllSeeds_{0},
+      selBxPutToken_{produces<std::vector<unsigned>>("SelBx")},
+      seedMasksPutToken_{produces<std::vector<Mask>>("SeedMasks")} {
+  std::set<std::string> labels{"SelBx", "SeedMasks"};
+  for (auto const& pset : iConfig.getParameterSetVector("seeds")) {
+    auto& seed = seeds_.emplace_back(Seed{pset.getParameter<std::string>("label"),
+                                          pset.getParameter<int>("nMin"),
+                                          pset.getParameter<double>("ptMin"),
+                                          pset.getParameter<double>("absEtaMin"),
+                                          pset.getParameter<double>("absEtaMax"),
+                                          {}});
+
+    if (seed.label.empty() or not labels.insert(seed.label).second) {
+      throw cms::Exception("Configuration")
+          << "invalid value for parameter \"label\" of \"seeds\" (must be non-empty, unique, and different from "
+             "\"SelBx\" and \"SeedMasks\"): \""
+          << seed.label << "\"";
+    }
+
+    // a seed with nMin < 1 would fire in every BX of the orbit, including the BXs without jets
+    if (seed.nMin < 1) {
+      throw cms::Exception("Configuration")
+          << "invalid value for parameter \"nMin\" of seed \"" << seed.label << "\" (must be positive): " << seed.nMin;
+    }
+
+    seed.putToken = produces<std::vector<unsigned>>(seed.label);
+  }
+
+  if (seeds_.empty() or seeds_.size() > kMaxSeeds) {
+    throw cms::Exception("Configuration") << "invalid value for parameter \"seeds\" (at least 1, and at most "
+                                          << kMaxSeeds << " seeds): " << seeds_.size() << " seeds";
+  }
+
+  nMinAllSeeds_ = std::min_element(seeds_.begin(), seeds_.end(), [](auto const& a, auto const& b) {
+                    return a.nMin < b.nMin;
+                  })->nMin;
+}
+
+L1TOrbitJetSeedsFilter::Mask L1TOrbitJetSeedsFilter::firedSeeds(OrbitCollection<l1t::Jet> const& inputs,
+                                                                unsigned int const bx,
+                                                                std::vector<int>& counts) const {
+  int const nJets = inputs.getBxSize(bx);
+  if (nJets < nMinAllSeeds_) {
+    return 0;
+  }
+
+  // seeds that can still fire in this BX
+  Mask pending{0};
+  for (auto iseed = 0u; iseed < seeds_.size(); ++iseed) {
+    if (seeds_[iseed].nMin <= nJets) {
+      pending |= Mask(1) << iseed;
+      counts[iseed] = 0;
+    }
+  }
+
+  Mask fired{0};
+  for (auto idx = 0; idx < nJets and pending != 0; ++idx) {
+    auto const& jet = inputs.getBxObject(bx, idx);
+    auto const pt = jet.pt();
+    auto const absEta = std::abs(jet.eta());
+
+    for (auto mask = pending; mask != 0; mask &= mask - 1) {
+      auto const iseed = std::countr_zero(mask);
+      auto const& seed = seeds_[iseed];
+      if (seed.selected(pt, absEta)) {
+        if (++counts[iseed] >= seed.nMin) {
+          fired |= Mask(1) << iseed;
+          pending &= ~(Mask(1) << iseed);
+        }
+      } else if (seed.nMin - counts[iseed] > nJets - idx - 1) {
+        // not enough jets left in the BX
+        pending &= ~(Mask(1) << iseed);
+      }
+    }
+  }
+
+  return fired;
+}
+
+bool L1TOrbitJetSeedsFilter::filter(edm::StreamID, edm::Event& iEvent, edm::EventSetup const&) const {
+  auto const& inputs = iEvent.get(srcToken_);
+
+  std::vector<unsigned> selBxs;
+  std::vector<Mask> seedMasks;
+  std::vector<std::vector<unsigned>> seedBxs(seeds_.size());
+
+  std::vector<int> counts(seeds_.size(), 0);
+
+  for (auto bx = 0u; bx <= unsigned(OrbitCollection<l1t::Jet>::NBX); ++bx) {
+    auto const fired = firedSeeds(inputs, bx, counts);
+    if (fired == 0) {
+      continue;
+    }
+
+    selBxs.emplace_back(bx);
+    seedMasks.emplace_back(fired);
+
+    for (auto mask = fired; mask != 0; mask &= mask - 1) {
+      seedBxs[std::countr_zero(mask)].emplace_back(bx);
+    }
+  }
+
+  for (auto iseed = 0u; iseed < seeds_.size(); ++iseed) {
+    LogTrace("L1TOrbitJetSeedsFilter") << "[L1TOrbitJetSeedsFilter] [" << moduleDescription().moduleLabel() << "] "
+                                       << seeds_[iseed].label << ": " << seedBxs[iseed].size() << " BXs";
+
+    iEvent.emplace(seeds_[iseed].putToken, std::move(seedBxs[iseed]));
+  }
+
+  bool const pass = not selBxs.empty();
+
+  iEvent.emplace(selBxPutToken_, std::move(selBxs));
+  iEvent.emplace(seedMasksPutToken_, std::move(seedMasks));
+
+  return pass;
+}
+
+void L1TOrbitJetSeedsFilter::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input jets (type: OrbitCollection<l1t::Jet>)");
+
+  edm::ParameterSetDescription seedDesc;
+  seedDesc.add<std::string>("label")->setComment(
+      "Product instance label of the BXs in which the seed fired (type: std::vector<unsigned>)");
+  seedDesc.add<int>("nMin", 1)->setComment(
+      "Min number of jets required to pass pT and |eta| selections (inclusive, must be positive)");
+  seedDesc.add<double>("ptMin", 1)->setComment("Min jet pT");
+  seedDesc.add<double>("absEtaMin", -1)->setComment("Min jet |eta| (ignored if negative)");
+  seedDesc.add<double>("absEtaMax", -1)->setComment("Max jet |eta| (ignored if negative)");
+
+  desc.addVPSet("seeds", seedDesc, {})
+      ->setComment(
+          "Jet seeds (at least 1, at most 64; bit i of the \"SeedMasks\" product corresponds to the i-th seed)");
+
+  descriptions.add("l1tOrbitJetSeedsFilter", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TOrbitJetSeedsFilter);
@@ -0,0 +1,14 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TJetCorrectorESSource import L1TJetCorrectorESSource
+
+l1sAK4CTJetCorrectorC = L1TJetCorrectorESSource(
+    jecFiles = [
+        cms.PSet(
+            firstRun = cms.uint32(1),
+            jecFile = cms.FileInPath('L1ScoutingTools/Reconstruction/data/JEC_AK4CaloTowerL1S_Run3Winter25_v2.txt')
+        ),
+    ],
+    formulaType = 'CorrectedPt',
+    appendToDataLabel = 'l1sAK4CTJetCorrectorC'
+)
@@ -0,0 +1,18 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TJetSoATopologyProducer import L1TJetSoATopologyProducer
+
+# HT, MHT, leading-pair and jet-count quantities of the corrected AK4 CaloTower jets
+l1sAK4CTJets0EmuCorrCTopology = L1TJetSoATopologyProducer(
+    src = 'l1sAK4CTJets0EmuCorrC:SoA',
+    bxMin = 0,
+    bxMax = 0,
+    ptMin = 30,
+    absEtaMax = 2.4,
+    counts = cms.VPSet(
+        cms.PSet(label = cms.string('nJetsPt20'), ptMin = cms.double(20)),
+        cms.PSet(label = cms.string('nJetsPt30'), ptMin = cms.double(30)),
+        cms.PSet(label = cms.string('nJetsPt30AbsEta2p4'), ptMin = cms.double(30), absEtaMax = cms.double(2.4)),
+        cms.PSet(label = cms.string('nJetsPt30Forward'), ptMin = cms.double(30), absEtaMin = cms.double(3.)),
+    )
+)
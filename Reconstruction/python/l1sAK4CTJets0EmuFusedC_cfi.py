@@ -0,0 +1,17 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TCaloTowerFusedJetFilter import L1TCaloTowerFusedJetFilter
+
+# same jets as l1sAK4CTJets0Emu -> l1sAK4CTJets0EmuCorrC in one module (every event is accepted unless selection.nMin > 0)
+l1sAK4CTJets0EmuFusedC = L1TCaloTowerFusedJetFilter(
+    src = 'simCaloStage2Layer1Digis',
+    bxMin = 0,
+    bxMax = 0,
+    towerMinHwPt = 1,
+    towerMaxHwPt = -1,
+    rParam = 0.4,
+    jetPtMin = 1,
+    puProxy = 'l1sCTMultAbsIEta4',
+    jetCorrector = cms.ESInputTag('', 'l1sAK4CTJetCorrectorC'),
+    produceSoA = True
+)
@@ -0,0 +1,27 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TCaloTowerMultiAKJetProducer import L1TCaloTowerMultiAKJetProducer
+
+# same jets as l1sAK4CTJets0Emu ('Jets0') and l1sAK4CTJets1Emu ('Jets1'), from one module
+l1sAK4CTJetsEmu = L1TCaloTowerMultiAKJetProducer(
+    src = 'simCaloStage2Layer1Digis',
+    bxMin = -2,
+    bxMax = 2,
+    produceSoA = True,
+    configurations = cms.VPSet(
+        cms.PSet(
+            label = cms.string('Jets0'),
+            rParam = cms.double(0.4),
+            towerMinHwPt = cms.int32(1),
+            towerMaxHwPt = cms.int32(-1),
+            jetPtMin = cms.double(1)
+        ),
+        cms.PSet(
+            label = cms.string('Jets1'),
+            rParam = cms.double(0.4),
+            towerMinHwPt = cms.int32(1),
+            towerMaxHwPt = cms.int32(508),
+            jetPtMin = cms.double(1)
+        ),
+    )
+)
@@ -0,0 +1,15 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TOrbitJetSeedsFilter import L1TOrbitJetSeedsFilter
+
+# jet seeds of the scouting menu, evaluated in one pass on the AK4 CaloTower jets of the orbit
+# (the "SelBx" product can be added to the analysisLabels of FinalBxSelector, as in test/l1sReco_cfg.py)
+l1sAK4CTJetsOrbitSeeds = L1TOrbitJetSeedsFilter(
+    src = 'l1sAK4CTJetsOrbit',
+    seeds = cms.VPSet(
+        cms.PSet(label = cms.string('DijetEt30'), nMin = cms.int32(2), ptMin = cms.double(30)),
+        cms.PSet(label = cms.string('HMJetMult4Et20'), nMin = cms.int32(4), ptMin = cms.double(20)),
+        cms.PSet(label = cms.string('SingleJetEt60'), nMin = cms.int32(1), ptMin = cms.double(60)),
+        cms.PSet(label = cms.string('SingleJetForwardEt30'), nMin = cms.int32(1), ptMin = cms.double(30), absEtaMin = cms.double(3.)),
+    )
+)
@@ -0,0 +1,13 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TCaloTowerOrbitEtSumsProducer import L1TCaloTowerOrbitEtSumsProducer
+
+l1sCTEtSumsOrbit = L1TCaloTowerOrbitEtSumsProducer(
+    src = 'l1ScCaloTowerUnpacker:CaloTower',
+    configs = cms.VPSet(
+        cms.PSet(label = cms.string('All'), towerMinHwPt = cms.int32(1)),
+        cms.PSet(label = cms.string('NoHF'), towerMinHwPt = cms.int32(1), towerMaxAbsHwEta = cms.int32(28)),
+        cms.PSet(label = cms.string('Barrel'), towerMinHwPt = cms.int32(1), towerMaxAbsHwEta = cms.int32(16)),
+        cms.PSet(label = cms.string('NoHFHwPtGe2'), towerMinHwPt = cms.int32(2), towerMaxAbsHwEta = cms.int32(28)),
+    )
+)
@@ -0,0 +1,15 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TCaloTowerEtSumsProducer import L1TCaloTowerEtSumsProducer
+
+l1sCTEtSums = L1TCaloTowerEtSumsProducer(
+    src = 'simCaloStage2Layer1Digis',
+    bxMin = 0,
+    bxMax = 0,
+    configs = cms.VPSet(
+        cms.PSet(label = cms.string('All'), towerMinHwPt = cms.int32(1)),
+        cms.PSet(label = cms.string('NoHF'), towerMinHwPt = cms.int32(1), towerMaxAbsHwEta = cms.int32(28)),
+        cms.PSet(label = cms.string('Barrel'), towerMinHwPt = cms.int32(1), towerMaxAbsHwEta = cms.int32(16)),
+        cms.PSet(label = cms.string('NoHFHwPtGe2'), towerMinHwPt = cms.int32(2), towerMaxAbsHwEta = cms.int32(28)),
+    )
+)
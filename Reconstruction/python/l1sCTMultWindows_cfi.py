@@ -0,0 +1,17 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TCaloTowerMultiWindowMultiplicityProducer import L1TCaloTowerMultiWindowMultiplicityProducer
+
+l1sCTMultWindows = L1TCaloTowerMultiWindowMultiplicityProducer(
+    src = 'simCaloStage2Layer1Digis',
+    bunchCrossing = 0,
+    windows = cms.VPSet(
+        # same as l1sCTMultAbsIEta4
+        cms.PSet(label = cms.string('AbsIEta4'), towerMinHwPt = cms.int32(1), towerMaxAbsHwEta = cms.int32(4)),
+        cms.PSet(label = cms.string('Barrel'), towerMinHwPt = cms.int32(1), towerMaxAbsHwEta = cms.int32(16)),
+        cms.PSet(label = cms.string('Endcap'), towerMinHwPt = cms.int32(1), towerMinAbsHwEta = cms.int32(17), towerMaxAbsHwEta = cms.int32(28)),
+        cms.PSet(label = cms.string('HF'), towerMinHwPt = cms.int32(1), towerMinAbsHwEta = cms.int32(30)),
+        cms.PSet(label = cms.string('HwPtGe2'), towerMinHwPt = cms.int32(2)),
+        cms.PSet(label = cms.string('HwPtGe4'), towerMinHwPt = cms.int32(4)),
+    )
+)
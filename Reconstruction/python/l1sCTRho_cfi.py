@@ -0,0 +1,14 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TCaloTowerRhoProducer import L1TCaloTowerRhoProducer
+
+l1sCTRho = L1TCaloTowerRhoProducer(
+    src = 'simCaloStage2Layer1Digis',
+    bunchCrossing = 0,
+    towerMinHwPt = 1,
+    towerMaxHwPt = -1,
+    patchEtaSize = 1,
+    patchPhiSize = 8,
+    jets = 'l1sAK4CTJetsEmu:Jets0',
+    jetAreaRParam = 0.4
+)
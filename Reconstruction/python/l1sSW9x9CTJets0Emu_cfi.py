@@ -0,0 +1,14 @@
+import FWCore.ParameterSet.Config as cms
+
+from L1ScoutingTools.Reconstruction.L1TCaloTowerSlidingWindowJetProducer import L1TCaloTowerSlidingWindowJetProducer
+
+l1sSW9x9CTJets0Emu = L1TCaloTowerSlidingWindowJetProducer(
+    src = 'simCaloStage2Layer1Digis',
+    bxMin = -2,
+    bxMax = 2,
+    towerMinHwPt = 1,
+    towerMaxHwPt = -1,
+    windowHalfSize = 4,
+    seedMinHwPt = 8,
+    jetPtMin = 1
+)
@@ -0,0 +1,10 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/BxArrayRange.h"
+
+unsigned int BxArrayRange::index(int const bx) const {
+  if (not contains(bx)) {
+    throw cms::Exception("InvalidInput") << "BX value outside the range of the per-BX array [" << firstBX_ << ", "
+                                         << lastBX_ << "]: " << bx;
+  }
+  return bx - firstBX_;
+}
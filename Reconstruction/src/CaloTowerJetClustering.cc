@@ -0,0 +1,119 @@
+#include <algorithm>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+
+#include "fastjet/ClusterSequence.hh"
+
+caloTowerJetClustering::Backend caloTowerJetClustering::backend(std::string const& name) {
+  if (name == "FastJet") {
+    return Backend::FastJet;
+  } else if (name == "Lattice") {
+    return Backend::Lattice;
+  }
+
+  throw cms::Exception("Configuration") << "invalid value for parameter \"backend\" (must be \"FastJet\" or \"Lattice\"): \""
+                                        << name << "\"";
+}
+
+void caloTowerJetClustering::inclusiveJets(fastjet::ClusterSequence const& clusterSeq,
+                                           double const ptMin,
+                                           std::vector<LatticeAntiKtClustering::Jet>& jets) {
+  jets.clear();
+  for (auto const& fjJet : clusterSeq.inclusive_jets(ptMin)) {
+    jets.emplace_back(LatticeAntiKtClustering::Jet{fjJet.px(), fjJet.py(), fjJet.pz(), fjJet.E()});
+  }
+
+  std::sort(jets.begin(), jets.end(), LatticeAntiKtClustering::higherPt);
+}
+
+caloTowerJetClustering::Clustering::Clustering(Backend const backend, double const rParam)
+    : backend_{backend},
+      lut_{CaloTowerLUT::get()},
+      fjJetDefinition_{fastjet::antikt_algorithm, rParam},
+      latticeClustering_{rParam},
+      clusteredOnLattice_{false} {}
+
+void caloTowerJetClustering::Clustering::run(CaloTowerPreSelector const& preSelector,
+                                             l1t::CaloTowerBxCollection const& inputs,
+                                             int const bx) {
+  clear();
+  for (auto const idx : preSelector.indices()) {
+    auto const& input = inputs.at(bx, idx);
+    addTower(input.hwPt(), input.hwEta(), input.hwPhi());
+  }
+  run();
+}
+
+void caloTowerJetClustering::Clustering::run(CaloTowerPreSelector const& preSelector,
+                                             l1ScoutingRun3::CaloTowerOrbitCollection const& inputs,
+                                             unsigned int const bx) {
+  clear();
+  for (auto const idx : preSelector.indices()) {
+    auto const& input = inputs.getBxObject(bx, idx);
+    addTower(input.hwEt(), input.hwEta(), input.hwPhi());
+  }
+  run();
+}
+
+void caloTowerJetClustering::Clustering::clear() {
+  if (backend_ == Backend::FastJet) {
+    fjInputs_.clear();
+  } else {
+    latticeClustering_.clear();
+  }
+  fjJets_.clear();
+  jets_.clear();
+  clusteredOnLattice_ = false;
+}
+
+void caloTowerJetClustering::Clustering::addTower(int const hwPt, int const hwEta, int const hwPhi) {
+  if (backend_ == Backend::FastJet) {
+    fjInputs_.emplace_back(fastJetInput(lut_, hwPt, hwEta, hwPhi));
+  } else {
+    latticeClustering_.addTower(hwPt, hwEta, hwPhi);
+  }
+}
+
+void caloTowerJetClustering::Clustering::addTower(int const hwPt,
+                                                  int const hwEta,
+                                                  int const hwPhi,
+                                                  fastjet::PseudoJet const& fjInput) {
+  if (backend_ == Backend::FastJet) {
+    fjInputs_.emplace_back(fjInput);
+  } else {
+    latticeClustering_.addTower(hwPt, hwEta, hwPhi);
+  }
+}
+
+void caloTowerJetClustering::Clustering::run() {
+  if (backend_ == Backend::FastJet) {
+    // fastjet::ClusterSequence owns its history and cannot be re-used across BXs:
+    // all its inclusive jets are kept, and selected in pT by inclusiveJets
+    // (same jets as fastjet::ClusterSequence::inclusive_jets(ptMin), which requires pT^2 >= ptMin^2)
+    auto const fjClusterSeq = fastjet::ClusterSequence{fjInputs_, fjJetDefinition_};
+    caloTowerJetClustering::inclusiveJets(fjClusterSeq, 0., fjJets_);
+    clusteredOnLattice_ = false;
+  } else {
+    clusteredOnLattice_ = latticeClustering_.run();
+  }
+}
+
+std::vector<LatticeAntiKtClustering::Jet> const& caloTowerJetClustering::Clustering::inclusiveJets(double const ptMin) {
+  if (backend_ == Backend::Lattice) {
+    return latticeClustering_.inclusiveJets(ptMin);
+  }
+
+  auto const pt2Min = ptMin * ptMin;
+  jets_.clear();
+  for (auto const& jet : fjJets_) {
+    if (jet.px * jet.px + jet.py * jet.py >= pt2Min) {
+      jets_.emplace_back(jet);
+    }
+  }
+  return jets_;
+}
+
+std::size_t caloTowerJetClustering::Clustering::bufferCapacity() const {
+  return latticeClustering_.bufferCapacity() + fjInputs_.capacity() + fjJets_.capacity() + jets_.capacity();
+}
@@ -0,0 +1,36 @@
+#include <cmath>
+
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1TriggerScouting/Utilities/interface/conversion.h"
+
+CaloTowerLUT const& CaloTowerLUT::get() {
+  static CaloTowerLUT const lut;
+  return lut;
+}
+
+CaloTowerLUT::CaloTowerLUT() {
+  for (int hwPt = 0; hwPt <= kHwPtMax; ++hwPt) {
+    et_[hwPt] = l1ScoutingRun3::calol1::fEt(hwPt);
+  }
+
+  for (int hwEta = kHwEtaMin; hwEta <= kHwEtaMax; ++hwEta) {
+    auto const idx = hwEta - kHwEtaMin;
+    double const eta = l1ScoutingRun3::calol1::fEta(hwEta);
+    validEta_[idx] = l1ScoutingRun3::calol1::validHwEta(hwEta);
+    eta_[idx] = eta;
+    expEta_[idx] = std::exp(eta);
+    sinhEta_[idx] = std::sinh(eta);
+    coshEta_[idx] = std::cosh(eta);
+  }
+
+  for (int hwPhi = kHwPhiMin; hwPhi <= kHwPhiMax; ++hwPhi) {
+    auto const idx = hwPhi - kHwPhiMin;
+    double const phi = l1ScoutingRun3::calol1::fPhi(hwPhi);
+    validPhi_[idx] = l1ScoutingRun3::calol1::validHwPhi(hwPhi);
+    phi_[idx] = phi;
+    cosPhi_[idx] = std::cos(phi);
+    sinPhi_[idx] = std::sin(phi);
+  }
+}
+
+double CaloTowerLUT::etOutOfRange(int const hwPt) { return l1ScoutingRun3::calol1::fEt(hwPt); }
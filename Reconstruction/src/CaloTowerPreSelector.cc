@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <limits>
+
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerPreSelector.h"
+
+namespace {
+  // classification of the towers without branches (hwEta and hwPhi values outside the 8-bit domains
+  // are clamped to a valid table entry and masked); restrict-qualified arguments, so that the loop can be vectorised
+  void classify(int const* __restrict__ hwPts,
+                int const* __restrict__ hwEtas,
+                int const* __restrict__ hwPhis,
+                unsigned int const nTowers,
+                int const hwPtMin,
+                int const hwPtMax,
+                std::uint32_t const* __restrict__ validHwEta,
+                std::uint32_t const* __restrict__ validHwPhi,
+                std::uint32_t* __restrict__ flags) {
+    for (auto idx = 0u; idx < nTowers; ++idx) {
+      auto const hwPt = hwPts[idx];
+      auto const etaIdx = unsigned(hwEtas[idx] - CaloTowerLUT::kHwEtaMin);
+      auto const phiIdx = unsigned(hwPhis[idx] - CaloTowerLUT::kHwPhiMin);
+
+      std::uint32_t const hwPtOK = (hwPt >= hwPtMin) & (hwPt <= hwPtMax);
+      std::uint32_t const hwEtaOK = validHwEta[std::min(etaIdx, 255u)] & -std::uint32_t(etaIdx < 256u);
+      std::uint32_t const hwPhiOK = validHwPhi[std::min(phiIdx, 255u)] & -std::uint32_t(phiIdx < 256u);
+
+      flags[idx] = hwPtOK | hwEtaOK | hwPhiOK;
+    }
+  }
+}  // namespace
+
+void CaloTowerPreSelector::InvalidTowerCounts::add(InvalidTowerCounts const& other) {
+  nBXs += other.nBXs;
+  nInvalidHwEta += other.nInvalidHwEta;
+  nInvalidHwPhi += other.nInvalidHwPhi;
+  maxInvalidPerBX = std::max(maxInvalidPerBX, other.maxInvalidPerBX);
+}
+
+void CaloTowerPreSelector::InvalidTowerCounts::addBX(unsigned int const nBXInvalidHwEta,
+                                                     unsigned int const nBXInvalidHwPhi) {
+  if (nBXInvalidHwEta + nBXInvalidHwPhi == 0) {
+    return;
+  }
+  ++nBXs;
+  nInvalidHwEta += nBXInvalidHwEta;
+  nInvalidHwPhi += nBXInvalidHwPhi;
+  maxInvalidPerBX = std::max(maxInvalidPerBX, nBXInvalidHwEta + nBXInvalidHwPhi);
+}
+
+void CaloTowerPreSelector::InvalidTowerCounts::take(InvalidTowerCounts& other) {
+  add(other);
+  other = {};
+}
+
+void CaloTowerPreSelector::InvalidTowerCounts::report(std::string const& logCategory,
+                                                      std::string const& moduleLabel,
+                                                      edm::LuminosityBlock const& iLumi,
+                                                      std::string const& usage) const {
+  if (nInvalid() == 0) {
+    return;
+  }
+
+  edm::LogWarning(logCategory) << "[" << moduleLabel << "] Run " << iLumi.run() << ", LS " << iLumi.luminosityBlock()
+                               << ": " << nInvalid() << " CaloTowers with invalid hwEta (" << nInvalidHwEta
+                               << ") or hwPhi (" << nInvalidHwPhi << ") values were not used for " << usage
+                               << " (BXs affected: " << nBXs << ", max per BX: " << maxInvalidPerBX << ")";
+}
+
+CaloTowerPreSelector::CaloTowerPreSelector(int const towerMinHwPt, int const towerMaxHwPt)
+    : hwPtMin_{towerMinHwPt < 0 ? std::numeric_limits<int>::min() : towerMinHwPt},
+      hwPtMax_{towerMaxHwPt < 0 ? std::numeric_limits<int>::max() : towerMaxHwPt},
+      nInvalidHwEta_{0},
+      nInvalidHwPhi_{0} {
+  static_assert(CaloTowerLUT::kHwEtaMax - CaloTowerLUT::kHwEtaMin + 1 == 256);
+  static_assert(CaloTowerLUT::kHwPhiMax - CaloTowerLUT::kHwPhiMin + 1 == 256);
+
+  auto const& lut = CaloTowerLUT::get();
+  for (auto idx = 0; idx < 256; ++idx) {
+    validHwEta_[idx] = lut.validHwEta(idx + CaloTowerLUT::kHwEtaMin) ? kHwEtaOK : 0;
+    validHwPhi_[idx] = lut.validHwPhi(idx + CaloTowerLUT::kHwPhiMin) ? kHwPhiOK : 0;
+  }
+}
+
+void CaloTowerPreSelector::select(l1t::CaloTowerBxCollection const& towers, int const bx) {
+  auto const nTowers = towers.size(bx);
+
+  hwPt_.resize(nTowers);
+  hwEta_.resize(nTowers);
+  hwPhi_.resize(nTowers);
+
+  for (auto idx = 0u; idx < nTowers; ++idx) {
+    auto const& tower = towers.at(bx, idx);
+    hwPt_[idx] = tower.hwPt();
+    hwEta_[idx] = tower.hwEta();
+    hwPhi_[idx] = tower.hwPhi();
+  }
+
+  selectFilledArrays(nTowers);
+}
+
+void CaloTowerPreSelector::select(l1ScoutingRun3::CaloTowerOrbitCollection const& towers, unsigned int const bx) {
+  unsigned int const nTowers = towers.getBxSize(bx);
+
+  hwPt_.resize(nTowers);
+  hwEta_.resize(nTowers);
+  hwPhi_.resize(nTowers);
+
+  for (auto idx = 0u; idx < nTowers; ++idx) {
+    auto const& tower = towers.getBxObject(bx, idx);
+    hwPt_[idx] = tower.hwEt();
+    hwEta_[idx] = tower.hwEta();
+    hwPhi_[idx] = tower.hwPhi();
+  }
+
+  selectFilledArrays(nTowers);
+}
+
+void CaloTowerPreSelector::selectFilledArrays(unsigned int const nTowers) {
+  flags_.resize(nTowers);
+  indices_.resize(nTowers);
+
+  classify(hwPt_.data(),
+           hwEta_.data(),
+           hwPhi_.data(),
+           nTowers,
+           hwPtMin_,
+           hwPtMax_,
+           validHwEta_.data(),
+           validHwPhi_.data(),
+           flags_.data());
+
+  // compaction (indices are always written, the output size only grows for selected towers)
+  unsigned int nSelected{0};
+  unsigned int nInvalidHwEta{0};
+  unsigned int nInvalidHwPhi{0};
+  for (auto idx = 0u; idx < nTowers; ++idx) {
+    auto const flags = flags_[idx];
+    indices_[nSelected] = idx;
+    nSelected += (flags == kSelected);
+    nInvalidHwEta += (flags == kHwPtOK) | (flags == (kHwPtOK | kHwPhiOK));
+    nInvalidHwPhi += (flags == (kHwPtOK | kHwEtaOK));
+  }
+
+  indices_.resize(nSelected);
+  nInvalidHwEta_ = nInvalidHwEta;
+  nInvalidHwPhi_ = nInvalidHwPhi;
+}
+
+std::size_t CaloTowerPreSelector::bufferCapacity() const {
+  return hwPt_.capacity() + hwEta_.capacity() + hwPhi_.capacity() + flags_.capacity() + indices_.capacity();
+}
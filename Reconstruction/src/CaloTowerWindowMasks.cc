@@ -0,0 +1,41 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerWindowMasks.h"
+
+CaloTowerWindowMasks::CaloTowerWindowMasks(std::vector<Window> const& windows) {
+  if (windows.size() > kMaxWindows) {
+    throw cms::Exception("LogicError") << "CaloTowerWindowMasks: too many windows (" << windows.size()
+                                       << ", at most " << kMaxWindows << ")";
+  }
+
+  hwPtMasks_ = masks(windows, &Window::towerMinHwPt, &Window::towerMaxHwPt);
+  absHwEtaMasks_ = masks(windows, &Window::towerMinAbsHwEta, &Window::towerMaxAbsHwEta);
+  lastHwPtIdx_ = hwPtMasks_.size() - 1;
+  lastAbsHwEtaIdx_ = absHwEtaMasks_.size() - 1;
+
+  for (auto iwin = 0u; iwin < windows.size(); ++iwin) {
+    if (windows[iwin].towerMinHwPt < 0) {
+      negativeHwPtMask_ |= Mask(1) << iwin;
+    }
+  }
+}
+
+std::vector<CaloTowerWindowMasks::Mask> CaloTowerWindowMasks::masks(std::vector<Window> const& windows,
+                                                                    int Window::*const min,
+                                                                    int Window::*const max) {
+  int maxEdge{0};
+  for (auto const& window : windows) {
+    maxEdge = std::max({maxEdge, window.*min, window.*max});
+  }
+
+  std::vector<Mask> ret(maxEdge + 2, 0);
+  for (auto value = 0; value < int(ret.size()); ++value) {
+    for (auto iwin = 0u; iwin < windows.size(); ++iwin) {
+      auto const& window = windows[iwin];
+      if ((window.*min < 0 or value >= window.*min) and (window.*max < 0 or value <= window.*max)) {
+        ret[value] |= Mask(1) << iwin;
+      }
+    }
+  }
+
+  return ret;
+}
@@ -0,0 +1,4 @@
+#include "FWCore/Utilities/interface/typelookup.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+
+TYPELOOKUP_DATA_REG(JetCorrector);
@@ -0,0 +1,23 @@
+#include <cmath>
+
+#include "L1ScoutingTools/Reconstruction/interface/EtSumBxArray.h"
+
+EtSumBxArray::EtSumBxArray(int const firstBX, int const lastBX)
+    : BxArrayRange{firstBX, lastBX}, et_(nBXs(), 0), metX_(nBXs(), 0), metY_(nBXs(), 0) {}
+
+void EtSumBxArray::set(int const bx, float const et, float const metX, float const metY) {
+  auto const idx = index(bx);
+  et_[idx] = et;
+  metX_[idx] = metX;
+  metY_[idx] = metY;
+}
+
+float EtSumBxArray::met(int const bx) const {
+  auto const idx = index(bx);
+  return std::hypot(metX_[idx], metY_[idx]);
+}
+
+float EtSumBxArray::metPhi(int const bx) const {
+  auto const idx = index(bx);
+  return std::atan2(metY_[idx], metX_[idx]);
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cmath>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/GridRhoEstimator.h"
+
+namespace {
+  constexpr double kPi = 3.141592653589793238462643383279502884197;
+  constexpr double kTwoPi = 6.283185307179586476925286766559005768394;
+}  // namespace
+
+GridRhoEstimator::GridRhoEstimator(int const patchEtaSize, int const patchPhiSize)
+    : lut_{CaloTowerLUT::get()}, patchEtaSize_{patchEtaSize}, patchPhiSize_{patchPhiSize}, rho_{0} {
+  if (patchEtaSize_ <= 0 or patchPhiSize_ <= 0) {
+    throw cms::Exception("InvalidInput") << "invalid patch size (must be greater than zero): patchEtaSize="
+                                         << patchEtaSize_ << ", patchPhiSize=" << patchPhiSize_;
+  }
+
+  // lattice coordinates
+  etaIndex_.fill(-1);
+  for (int hwEta = -kHwEtaOffset; hwEta < kHwRange - kHwEtaOffset; ++hwEta) {
+    if (lut_.validHwEta(hwEta)) {
+      etaIndex_[hwEta + kHwEtaOffset] = cellEta_.size();
+      cellEta_.emplace_back(lut_.eta(hwEta));
+    }
+  }
+
+  phiIndex_.fill(-1);
+  for (int hwPhi = 0; hwPhi < kHwRange; ++hwPhi) {
+    if (lut_.validHwPhi(hwPhi)) {
+      phiIndex_[hwPhi] = cellPhi_.size();
+      cellPhi_.emplace_back(lut_.phi(hwPhi));
+    }
+  }
+
+  nEta_ = cellEta_.size();
+  nPhi_ = cellPhi_.size();
+
+  if (nEta_ < 2 or nPhi_ == 0) {
+    throw cms::Exception("LogicError") << "invalid CaloTower lattice (nEta=" << nEta_ << ", nPhi=" << nPhi_ << ")";
+  }
+
+  // tower sizes (eta boundaries half-way between neighbouring centres)
+  cellEtaWidth_.resize(nEta_);
+  for (auto ie = 0; ie < nEta_; ++ie) {
+    auto const etaLow = (ie > 0) ? 0.5 * (cellEta_[ie - 1] + cellEta_[ie])
+                                 : cellEta_[ie] - 0.5 * (cellEta_[ie + 1] - cellEta_[ie]);
+    auto const etaHigh = (ie < nEta_ - 1) ? 0.5 * (cellEta_[ie] + cellEta_[ie + 1])
+                                          : cellEta_[ie] + 0.5 * (cellEta_[ie] - cellEta_[ie - 1]);
+    cellEtaWidth_[ie] = etaHigh - etaLow;
+  }
+  cellPhiWidth_ = kTwoPi / nPhi_;
+
+  phiOrder_.resize(nPhi_);
+  for (auto ip = 0; ip < nPhi_; ++ip) {
+    phiOrder_[ip] = ip;
+  }
+  std::sort(phiOrder_.begin(), phiOrder_.end(), [this](int const ip1, int const ip2) {
+    return cellPhi_[ip1] < cellPhi_[ip2];
+  });
+  sortedCellPhi_.resize(nPhi_);
+  for (auto ip = 0; ip < nPhi_; ++ip) {
+    sortedCellPhi_[ip] = cellPhi_[phiOrder_[ip]];
+  }
+
+  // patches
+  nPatchesEta_ = (nEta_ + patchEtaSize_ - 1) / patchEtaSize_;
+  nPatchesPhi_ = (nPhi_ + patchPhiSize_ - 1) / patchPhiSize_;
+
+  patchArea_.assign(nPatchesEta_ * nPatchesPhi_, 0.);
+  for (auto ie = 0; ie < nEta_; ++ie) {
+    for (auto ip = 0; ip < nPhi_; ++ip) {
+      patchArea_[(ie / patchEtaSize_) * nPatchesPhi_ + ip / patchPhiSize_] += cellEtaWidth_[ie] * cellPhiWidth_;
+    }
+  }
+
+  ringEtaRanges_.resize(nPatchesEta_);
+  for (auto ipe = 0; ipe < nPatchesEta_; ++ipe) {
+    auto const ieFirst = ipe * patchEtaSize_;
+    auto const ieLast = std::min(nEta_, ieFirst + patchEtaSize_) - 1;
+    ringEtaRanges_[ipe] = {{cellEta_[ieFirst] - 0.5 * cellEtaWidth_[ieFirst],
+                            cellEta_[ieLast] + 0.5 * cellEtaWidth_[ieLast]}};
+  }
+
+  patchEt_.assign(patchArea_.size(), 0.);
+  patchDensities_.reserve(patchArea_.size());
+  ringRhos_.assign(nPatchesEta_, 0.);
+}
+
+void GridRhoEstimator::clear() {
+  std::fill(patchEt_.begin(), patchEt_.end(), 0.);
+  std::fill(ringRhos_.begin(), ringRhos_.end(), 0.);
+  rho_ = 0;
+}
+
+void GridRhoEstimator::addTower(int const hwPt, int const hwEta, int const hwPhi) {
+  auto const etaIdx = (hwEta >= -kHwEtaOffset and hwEta < kHwRange - kHwEtaOffset) ? etaIndex_[hwEta + kHwEtaOffset] : -1;
+  auto const phiIdx = (hwPhi >= 0 and hwPhi < kHwRange) ? phiIndex_[hwPhi] : -1;
+
+  if (etaIdx < 0 or phiIdx < 0) {
+    throw cms::Exception("InvalidInput") << "CaloTower with invalid lattice coordinates (hwEta=" << hwEta
+                                         << ", hwPhi=" << hwPhi << ")";
+  }
+
+  patchEt_[(etaIdx / patchEtaSize_) * nPatchesPhi_ + phiIdx / patchPhiSize_] += lut_.et(hwPt);
+}
+
+double GridRhoEstimator::median(std::vector<double>& values, unsigned int const begin, unsigned int const end) {
+  auto const size = end - begin;
+  if (size == 0) {
+    return 0.;
+  }
+
+  auto const first = values.begin() + begin;
+  auto const last = values.begin() + end;
+  auto const mid = first + size / 2;
+  std::nth_element(first, mid, last);
+  if (size % 2) {
+    return *mid;
+  }
+  return 0.5 * (*mid + *std::max_element(first, mid));
+}
+
+void GridRhoEstimator::run() {
+  patchDensities_.resize(patchEt_.size());
+  for (auto ipatch = 0u; ipatch < patchEt_.size(); ++ipatch) {
+    patchDensities_[ipatch] = patchEt_[ipatch] / patchArea_[ipatch];
+  }
+
+  // rho per eta ring (the patches of one ring are contiguous)
+  for (auto ipe = 0; ipe < nPatchesEta_; ++ipe) {
+    ringRhos_[ipe] = median(patchDensities_, ipe * nPatchesPhi_, (ipe + 1) * nPatchesPhi_);
+  }
+
+  rho_ = median(patchDensities_, 0, patchDensities_.size());
+}
+
+double GridRhoEstimator::jetArea(double const eta, double const phi, double const rParam) const {
+  auto const r2 = rParam * rParam;
+
+  // eta rings with |deta| < R (cellEta_ is sorted), with one more ring on each side against rounding
+  auto const etaBegin = std::max(
+      0, int(std::upper_bound(cellEta_.begin(), cellEta_.end(), eta - rParam) - cellEta_.begin()) - 1);
+  auto const etaEnd =
+      std::min(nEta_, int(std::lower_bound(cellEta_.begin(), cellEta_.end(), eta + rParam) - cellEta_.begin()) + 1);
+
+  // phi columns with |dphi| < R: the columns (equally spaced) within ceil(R / width) + 1 positions of the column
+  // closest to phi in the sorted phi values, or all columns if the window covers the whole circle
+  auto const phiHalfWidth = int(std::ceil(rParam / cellPhiWidth_)) + 1;
+  auto const nPhiWindow = std::min(nPhi_, 2 * phiHalfWidth + 1);
+  auto phiFirst = 0;
+  if (nPhiWindow < nPhi_) {
+    auto const phiInRange =
+        sortedCellPhi_.front() + std::fmod(std::fmod(phi - sortedCellPhi_.front(), kTwoPi) + kTwoPi, kTwoPi);
+    int const centre =
+        std::lower_bound(sortedCellPhi_.begin(), sortedCellPhi_.end(), phiInRange) - sortedCellPhi_.begin();
+    phiFirst = ((centre - phiHalfWidth) % nPhi_ + nPhi_) % nPhi_;
+  }
+
+  double area{0};
+  for (auto ie = etaBegin; ie < etaEnd; ++ie) {
+    auto const deta = cellEta_[ie] - eta;
+    if (std::abs(deta) >= rParam) {
+      continue;
+    }
+    for (auto iw = 0; iw < nPhiWindow; ++iw) {
+      auto const ip = phiOrder_[(phiFirst + iw) % nPhi_];
+      auto dphi = std::abs(cellPhi_[ip] - phi);
+      if (dphi > kPi) {
+        dphi = kTwoPi - std::fmod(dphi, kTwoPi);
+      }
+      if (deta * deta + dphi * dphi < r2) {
+        area += cellEtaWidth_[ie] * cellPhiWidth_;
+      }
+    }
+  }
+
+  return area;
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetBxCorrection.h"
+
+JetBxCorrection::JetBxCorrection(std::string logCategory, int const maxJetsPerBx)
+    : logCategory_{std::move(logCategory)}, maxJetsPerBx_{maxJetsPerBx} {}
+
+void JetBxCorrection::setInputs(l1t::JetBxCollection const& inputs,
+                                int const bxMin,
+                                int const bxMax,
+                                int const puProxy) {
+  inputs_ = &inputs;
+  bxMin_ = bxMin;
+  bxMax_ = bxMax;
+
+  puProxies_.assign(std::max(0, bxMax - bxMin + 1), puProxy);
+
+  gatherInputs();
+}
+
+void JetBxCorrection::setInputs(l1t::JetBxCollection const& inputs,
+                                int const bxMin,
+                                int const bxMax,
+                                PUProxyBxArray const& puProxyPerBx) {
+  inputs_ = &inputs;
+  bxMin_ = bxMin;
+  bxMax_ = bxMax;
+
+  puProxies_.clear();
+  for (auto bx = bxMin; bx <= bxMax; ++bx) {
+    puProxies_.emplace_back(puProxyPerBx.at(bx));
+  }
+
+  gatherInputs();
+}
+
+void JetBxCorrection::gatherInputs() {
+  auto const& inputs = *inputs_;
+
+  binnedCorrector_ = nullptr;
+
+  pts_.clear();
+  etas_.clear();
+  bxOffsets_.clear();
+  for (auto bx = bxMin_; bx <= bxMax_; ++bx) {
+    bxOffsets_.emplace_back(pts_.size());
+    auto const nInputs = inputs.size(bx);
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& jet = inputs.at(bx, idx);
+      pts_.emplace_back(jet.pt());
+      etas_.emplace_back(jet.eta());
+    }
+  }
+
+  bxOffsets_.emplace_back(pts_.size());
+}
+
+void JetBxCorrection::findBins(JetCorrector const& jetCorrector) {
+  bins_.resize(pts_.size());
+  jetCorrector.bins(etas_, puProxies_, bxOffsets_, bins_, jetCorrectorWorkspace_);
+  binnedCorrector_ = &jetCorrector;
+}
+
+void JetBxCorrection::corrections(JetCorrector const& jetCorrector, std::vector<double>& corrections) {
+  corrections.resize(pts_.size());
+
+  if (binnedCorrector_ != nullptr and jetCorrector.sameBinning(*binnedCorrector_)) {
+    jetCorrector.corrections(bins_, pts_, corrections, jetCorrectorWorkspace_);
+  } else {
+    jetCorrector.corrections(pts_, etas_, puProxies_, bxOffsets_, corrections, jetCorrectorWorkspace_);
+  }
+}
+
+void JetBxCorrection::correctedJets(std::span<double const> const corrections,
+                                    l1t::JetBxCollection& output,
+                                    JetSoABxCollection* const soaOutput,
+                                    std::string const& label) {
+  if (corrections.size() != pts_.size()) {
+    throw cms::Exception("LogicError") << "JetBxCorrection::correctedJets: inconsistent number of corrections ("
+                                       << corrections.size() << ", jets: " << pts_.size() << ")";
+  }
+
+  auto const& inputs = *inputs_;
+
+  output = l1t::JetBxCollection(0, bxMin_, bxMax_);
+  if (soaOutput != nullptr) {
+    *soaOutput = JetSoABxCollection(bxMin_, bxMax_);
+  }
+
+  // corrected pT and index of the jets of one BX, in order of decreasing corrected pT (ties: increasing index)
+  auto const byDecreasingPt = [](auto const& key1, auto const& key2) {
+    return key1.first > key2.first or (key1.first == key2.first and key1.second < key2.second);
+  };
+
+  for (auto bx = bxMin_; bx <= bxMax_; ++bx) {
+    auto const nInputs = inputs.size(bx);
+    auto const puProxy = puProxies_[bx - bxMin_];
+    auto const bxCorrections = corrections.subspan(bxOffsets_[bx - bxMin_], nInputs);
+
+    sortKeys_.clear();
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& jet = inputs.at(bx, idx);
+      auto const corr = bxCorrections[idx];
+
+      LogTrace(logCategory_) << "[" << logCategory_ << "] Jet(bx=" << bx << ", index=" << idx
+                             << ") (PU proxy = " << puProxy << ", corrections = \"" << label << "\")";
+
+      LogTrace(logCategory_) << "[" << logCategory_ << "]    Pre -JESC: eta=" << jet.eta() << " phi=" << jet.phi()
+                             << " pT(uncorrected)=" << jet.pt() << " JESC=" << corr;
+
+      if (corr > 0) {
+        sortKeys_.emplace_back((jet.p4() * corr).pt(), idx);
+      }
+    }
+
+    // leading maxJetsPerBx jets (all jets, if maxJetsPerBx is negative)
+    auto const nOutputs =
+        (maxJetsPerBx_ < 0) ? sortKeys_.size() : std::min(sortKeys_.size(), std::size_t(maxJetsPerBx_));
+    auto const sortKeysEnd = sortKeys_.begin() + nOutputs;
+    if (sortKeysEnd != sortKeys_.end()) {
+      std::nth_element(sortKeys_.begin(), sortKeysEnd, sortKeys_.end(), byDecreasingPt);
+    }
+    std::sort(sortKeys_.begin(), sortKeysEnd, byDecreasingPt);
+
+    for (auto key = sortKeys_.begin(); key != sortKeysEnd; ++key) {
+      auto const& input = inputs.at(bx, key->second);
+
+      l1t::Jet jet{input};
+      jet.setP4(input.p4() * bxCorrections[key->second]);
+
+      LogTrace(logCategory_) << "[" << logCategory_ << "]    Post-JESC: eta=" << jet.eta() << " phi=" << jet.phi()
+                             << " pT(corrected)=" << jet.pt();
+
+      if (soaOutput != nullptr) {
+        soaOutput->push_back(bx, jet.pt(), jet.eta(), jet.phi(), jet.mass());
+      }
+
+      output.push_back(bx, std::move(jet));
+    }
+  }
+
+  if (soaOutput != nullptr) {
+    soaOutput->finalize();
+  }
+}
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrectionPayload.h"
+
+static_assert(sizeof(JetCorrectionPayload::Header) == 32);
+static_assert(sizeof(JetCorrectionPayload::Bin) == 40);
+static_assert(sizeof(JetCorrectionPayload::Header) % alignof(double) == 0);
+static_assert(sizeof(JetCorrectionPayload::Bin) % alignof(double) == 0);
+
+JetCorrectionPayload::Kernel JetCorrectionPayload::kernel(std::string_view const formula,
+                                                          unsigned int const nParameters) {
+  if (nParameters == 4) {
+    if (formula == "[0]+[1]*x+[2]*x^2+[3]*log(x)") {
+      return Kernel::PolyLog;
+    } else if (formula == "[0]+[1]*(x/1000)+[2]*(x/1000)^2+[3]*log(x)") {
+      return Kernel::ScaledPolyLog;
+    }
+  }
+  return Kernel::Generic;
+}
+
+JetCorrectionPayload::JetCorrectionPayload(std::string const& filePath) {
+  std::ifstream infile(filePath, std::ios::binary);
+  if (not infile) {
+    throw cms::Exception("InvalidInput") << "failed to open input file: \"" << filePath << "\"";
+  }
+
+  char fileMagic[sizeof(magic)]{};
+  infile.read(fileMagic, sizeof(fileMagic));
+  bool const binary = (infile.gcount() == sizeof(magic) and std::equal(fileMagic, fileMagic + sizeof(magic), magic));
+  infile.close();
+
+  if (binary) {
+    mapBinary(filePath);
+  } else {
+    readText(filePath);
+  }
+}
+
+JetCorrectionPayload::~JetCorrectionPayload() {
+  if (mappedData_ != nullptr) {
+    ::munmap(mappedData_, mappedSize_);
+  }
+}
+
+JetCorrectionPayload::JetCorrectionPayload(JetCorrectionPayload&& other) noexcept
+    : buffer_{std::move(other.buffer_)},
+      mappedData_{std::exchange(other.mappedData_, nullptr)},
+      mappedSize_{std::exchange(other.mappedSize_, 0)},
+      data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      bins_{std::exchange(other.bins_, {})},
+      parameters_{std::exchange(other.parameters_, {})},
+      formulas_{std::exchange(other.formulas_, {})} {}
+
+JetCorrectionPayload& JetCorrectionPayload::operator=(JetCorrectionPayload&& other) noexcept {
+  if (this != &other) {
+    if (mappedData_ != nullptr) {
+      ::munmap(mappedData_, mappedSize_);
+    }
+    buffer_ = std::move(other.buffer_);
+    mappedData_ = std::exchange(other.mappedData_, nullptr);
+    mappedSize_ = std::exchange(other.mappedSize_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    bins_ = std::exchange(other.bins_, {});
+    parameters_ = std::exchange(other.parameters_, {});
+    formulas_ = std::exchange(other.formulas_, {});
+  }
+  return *this;
+}
+
+void JetCorrectionPayload::readText(std::string const& filePath) {
+  std::ifstream infile(filePath);
+  if (not infile) {
+    throw cms::Exception("InvalidInput") << "failed to open input file: \"" << filePath << "\"";
+  }
+
+  std::vector<Bin> bins;
+  std::vector<double> parameters;
+  std::string formulas;
+  std::map<std::string, std::uint32_t> formulaOffsets;
+
+  std::string line{};
+  while (std::getline(infile, line)) {
+    std::istringstream iss(line);
+
+    Bin bin{0.f, 0.f, 0.f, 0.f, 0, 0, Kernel::Generic, 0, 0, 0};
+    int formNParams{0};
+    std::string formEvalStr{""};
+
+    if (!(iss >> bin.ptMin >> bin.ptMax >> bin.etaMin >> bin.etaMax >> bin.puProxyMin >> bin.puProxyMax >>
+          formEvalStr >> formNParams)) {
+      throw cms::Exception("InvalidInput") << "failed to read line from input file (invalid format): \"" << line
+                                           << "\"";
+    }
+
+    if (formNParams <= 0) {
+      throw cms::Exception("InvalidInput")
+          << "invalid value for parameter \"formNParams\" (must be greater than zero): " << formNParams;
+    }
+
+    bin.kernel = kernel(formEvalStr, formNParams);
+    bin.parameterOffset = parameters.size();
+    bin.nParameters = formNParams;
+
+    parameters.resize(parameters.size() + formNParams);
+    for (auto idx = 0; idx < formNParams; ++idx) {
+      if (!(iss >> parameters[bin.parameterOffset + idx])) {
+        throw cms::Exception("InvalidInput")
+            << "failed to read line from input file (invalid format, formula parameter #" << idx << "): \"" << line
+            << "\"";
+      }
+    }
+
+    auto const [formulaIt, newFormula] = formulaOffsets.try_emplace(formEvalStr, formulas.size());
+    if (newFormula) {
+      formulas.append(formEvalStr);
+      formulas.push_back('\0');
+    }
+    bin.formulaOffset = formulaIt->second;
+
+    bins.emplace_back(bin);
+  }
+
+  Header const header{{magic[0], magic[1], magic[2], magic[3], magic[4], magic[5], magic[6], magic[7]},
+                      version,
+                      byteOrderMark,
+                      std::uint32_t(bins.size()),
+                      std::uint32_t(parameters.size()),
+                      std::uint32_t(formulas.size()),
+                      0};
+
+  auto const binsSize = bins.size() * sizeof(Bin);
+  auto const parametersSize = parameters.size() * sizeof(double);
+
+  buffer_.resize(sizeof(Header) + binsSize + parametersSize + formulas.size());
+  auto* out = buffer_.data();
+  std::memcpy(out, &header, sizeof(Header));
+  std::memcpy(out += sizeof(Header), bins.data(), binsSize);
+  std::memcpy(out += binsSize, parameters.data(), parametersSize);
+  std::memcpy(out += parametersSize, formulas.data(), formulas.size());
+
+  setViews(buffer_.data(), buffer_.size(), filePath);
+}
+
+void JetCorrectionPayload::mapBinary(std::string const& filePath) {
+  int const fd = ::open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw cms::Exception("InvalidInput") << "failed to open input file: \"" << filePath
+                                         << "\" (" << std::strerror(errno) << ")";
+  }
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0 or fileStat.st_size <= 0) {
+    ::close(fd);
+    throw cms::Exception("InvalidInput") << "failed to read the size of input file: \"" << filePath << "\"";
+  }
+
+  auto const size = std::size_t(fileStat.st_size);
+  void* const data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+
+  if (data == MAP_FAILED) {
+    throw cms::Exception("InvalidInput") << "failed to map input file into memory: \"" << filePath << "\" ("
+                                         << std::strerror(errno) << ")";
+  }
+
+  mappedData_ = data;
+  mappedSize_ = size;
+
+  setViews(static_cast<std::byte const*>(data), size, filePath);
+}
+
+void JetCorrectionPayload::setViews(std::byte const* const data, std::size_t const size, std::string const& filePath) {
+  if (size < sizeof(Header)) {
+    throw cms::Exception("InvalidInput") << "invalid binary JEC file (too small for the header): \"" << filePath
+                                         << "\"";
+  }
+
+  auto const* header = reinterpret_cast<Header const*>(data);
+
+  if (not std::equal(header->magic, header->magic + sizeof(magic), magic)) {
+    throw cms::Exception("InvalidInput") << "invalid binary JEC file (wrong magic bytes): \"" << filePath << "\"";
+  }
+
+  if (header->byteOrderMark != byteOrderMark) {
+    throw cms::Exception("InvalidInput") << "invalid binary JEC file (written on a machine with a different byte "
+                                            "order): \""
+                                         << filePath << "\"";
+  }
+
+  if (header->version != version) {
+    throw cms::Exception("InvalidInput") << "unsupported version of binary JEC file: \"" << filePath
+                                         << "\" (version " << header->version << ", supported version " << version
+                                         << ")";
+  }
+
+  auto const binsSize = std::size_t(header->nBins) * sizeof(Bin);
+  auto const parametersSize = std::size_t(header->nParameters) * sizeof(double);
+  if (size != sizeof(Header) + binsSize + parametersSize + header->formulasSize) {
+    throw cms::Exception("InvalidInput") << "invalid binary JEC file (size " << size
+                                         << " inconsistent with the header): \"" << filePath << "\"";
+  }
+
+  data_ = data;
+  size_ = size;
+
+  bins_ = {reinterpret_cast<Bin const*>(data + sizeof(Header)), header->nBins};
+  parameters_ = {reinterpret_cast<double const*>(data + sizeof(Header) + binsSize), header->nParameters};
+  formulas_ = {reinterpret_cast<char const*>(data + sizeof(Header) + binsSize + parametersSize), header->formulasSize};
+
+  if (not formulas_.empty() and formulas_.back() != '\0') {
+    throw cms::Exception("InvalidInput") << "invalid binary JEC file (formula strings not null-terminated): \""
+                                         << filePath << "\"";
+  }
+
+  for (auto const& bin : bins_) {
+    if (bin.formulaOffset >= formulas_.size() or bin.parameterOffset > parameters_.size() or
+        bin.nParameters > parameters_.size() - bin.parameterOffset) {
+      throw cms::Exception("InvalidInput") << "invalid binary JEC file (offsets of a bin outside the payload): \""
+                                           << filePath << "\"";
+    }
+
+    // NaN edges would pass all the consistency checks of the bins (comparisons with NaN are false)
+    if (not(std::isfinite(bin.ptMin) and std::isfinite(bin.ptMax) and std::isfinite(bin.etaMin) and
+            std::isfinite(bin.etaMax))) {
+      throw cms::Exception("InvalidInput") << "invalid JEC file (non-finite bin edge: ptMin=" << bin.ptMin
+                                           << " ptMax=" << bin.ptMax << " etaMin=" << bin.etaMin
+                                           << " etaMax=" << bin.etaMax << "): \"" << filePath << "\"";
+    }
+  }
+}
+
+void JetCorrectionPayload::writeBinary(std::string const& filePath) const {
+  std::ofstream outfile(filePath, std::ios::binary | std::ios::trunc);
+  outfile.write(reinterpret_cast<char const*>(data_), size_);
+  outfile.close();
+  if (not outfile) {
+    throw cms::Exception("FileWriteError") << "failed to write binary JEC file: \"" << filePath << "\"";
+  }
+}
@@ -0,0 +1,618 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+
+namespace {
+  // same operations, in the same order, as reco::FormulaEvaluator for the corresponding formulas
+  inline double polyLog(double const x, double const* p) {
+    return p[0] + p[1] * x + p[2] * std::pow(x, 2) + p[3] * std::log(x);
+  }
+
+  inline double scaledPolyLog(double const x, double const* p) {
+    return p[0] + p[1] * (x / 1000) + p[2] * std::pow(x / 1000, 2) + p[3] * std::log(x);
+  }
+
+  // batches with fewer jets (or fewer jets than bins) are evaluated jet by jet (the grouping by bin does not pay off)
+  constexpr std::size_t kMinJetsPerGroupedBatch = 32;
+
+  // values of a kernel for n pt values (clamped to [ptMin, ptMax]), divided by the clamped pt if correctedPt:
+  // straight-line loop without branches or calls other than the math functions, so that it can be vectorised
+  template <double (*kernel)(double, double const*)>
+  void evaluateKernel(double const* __restrict__ p,
+                      float const ptMin,
+                      float const ptMax,
+                      bool const correctedPt,
+                      float const* __restrict__ pts,
+                      double* __restrict__ values,
+                      std::size_t const n) {
+    for (std::size_t idx = 0; idx < n; ++idx) {
+      // same as std::clamp, on values instead of references
+      auto const pt = pts[idx];
+      double const x = (pt < ptMin) ? ptMin : ((ptMax < pt) ? ptMax : pt);
+      values[idx] = kernel(x, p) / (correctedPt ? x : 1.);
+    }
+  }
+
+  // same as evaluateKernel, with the values of the kernel from the interpolation table of the bin
+  // (same operations as JetCorrector::interpolate)
+  void interpolateTable(double const* __restrict__ table,
+                        std::uint32_t const tableFirstPoint,
+                        unsigned int const tableShift,
+                        float const ptMin,
+                        float const ptMax,
+                        bool const correctedPt,
+                        float const* __restrict__ pts,
+                        double* __restrict__ values,
+                        std::size_t const n) {
+    std::uint32_t const mask = (1u << tableShift) - 1;
+    double const spacing = double(1u << tableShift);
+    for (std::size_t idx = 0; idx < n; ++idx) {
+      auto const pt = pts[idx];
+      float const x = (pt < ptMin) ? ptMin : ((ptMax < pt) ? ptMax : pt);
+      // NaN values are replaced by ptMin for the table lookup (overwritten by the caller)
+      auto const bits = std::bit_cast<std::uint32_t>((x == x) ? x : ptMin);
+      auto const point = (bits >> tableShift) - tableFirstPoint;
+      double const t = double(bits & mask) / spacing;
+      values[idx] = (table[point] + t * (table[point + 1] - table[point])) / (correctedPt ? double(x) : 1.);
+    }
+  }
+
+  // call batch(puProxy, first, nJets) for every run of consecutive groups of jets with the same PU proxy
+  template <typename F>
+  void forEachBatch(std::span<int const> const puProxies,
+                    std::span<unsigned int const> const groupOffsets,
+                    std::size_t const nJets,
+                    F&& batch) {
+    if (groupOffsets.size() != puProxies.size() + 1 or groupOffsets.front() != 0 or groupOffsets.back() != nJets or
+        not std::is_sorted(groupOffsets.begin(), groupOffsets.end())) {
+      throw cms::Exception("LogicError") << "JetCorrector: inconsistent offsets of the groups of jets ("
+                                         << groupOffsets.size() << " offsets for " << puProxies.size()
+                                         << " groups and " << nJets << " jets)";
+    }
+
+    auto group = 0u;
+    while (group < puProxies.size()) {
+      auto const puProxy = puProxies[group];
+      auto const first = groupOffsets[group];
+      while (group < puProxies.size() and puProxies[group] == puProxy) {
+        ++group;
+      }
+      batch(puProxy, first, groupOffsets[group] - first);
+    }
+  }
+}  // namespace
+
+JetCorrector::JetCorrector(std::string const& filePath,
+                           FormulaType const formulaType,
+                           bool const useKernels,
+                           double const tabulationTolerance)
+    : formulaType_{formulaType},
+      payload_{filePath},
+      parameters_{payload_.parameters().data()},
+      tabulated_{tabulationTolerance > 0},
+      maxTabulationDeviation_{0} {
+  for (auto const& bin : payload_.bins()) {
+    auto const ptMin = bin.ptMin;
+    auto const ptMax = bin.ptMax;
+    auto const etaMin = bin.etaMin;
+    auto const etaMax = bin.etaMax;
+    auto const puProxyMin = bin.puProxyMin;
+    auto const puProxyMax = bin.puProxyMax;
+
+    if (ptMin <= 0) {
+      throw cms::Exception("InvalidInput")
+          << "invalid value for parameter \"ptMin\" (must be greater than zero): " << ptMin;
+    }
+
+    if (ptMax <= 0) {
+      throw cms::Exception("InvalidInput")
+          << "invalid value for parameter \"ptMax\" (must be greater than zero): " << ptMax;
+    }
+
+    if (ptMin >= ptMax) {
+      throw cms::Exception("InvalidInput") << "inconsistent values for parameters \"ptMin\" and \"ptMax\" (the latter "
+                                              "must be greater than the former): ptMin="
+                                           << ptMin << " ptMax=" << ptMax;
+    }
+
+    if (etaMin >= etaMax) {
+      throw cms::Exception("InvalidInput") << "inconsistent values for parameters \"etaMin\" and \"etaMax\" (the "
+                                              "latter must be greater than the former): etaMin="
+                                           << etaMin << " etaMax=" << etaMax;
+    }
+
+    if (puProxyMin > 0 and puProxyMax > 0 and puProxyMin >= puProxyMax) {
+      throw cms::Exception("InvalidInput")
+          << "inconsistent values for parameters \"puProxyMin\" and \"puProxyMax\" (if both are greater than zero, "
+             "the latter must be greater than the former): puProxyMin="
+          << puProxyMin << " puProxyMax=" << puProxyMax;
+    }
+
+    if (bin.nParameters == 0) {
+      throw cms::Exception("InvalidInput")
+          << "invalid value for parameter \"formNParams\" (must be greater than zero): " << bin.nParameters;
+    }
+
+    // kernel IDs of binary files are checked against their formulas
+    auto const formula = payload_.formula(bin);
+    if (bin.kernel != JetCorrectionPayload::kernel(formula, bin.nParameters)) {
+      throw cms::Exception("InvalidInput") << "kernel ID " << std::uint32_t(bin.kernel)
+                                           << " inconsistent with formula \"" << formula << "\" ("
+                                           << bin.nParameters << " parameters)";
+    }
+
+    auto const entryKernel = useKernels ? bin.kernel : Kernel::Generic;
+
+    if (entryKernel == Kernel::Generic) {
+      auto const formParams = payload_.parameters(bin);
+      entries_.emplace_back(Entry{
+          ptMin, ptMax, etaMin, etaMax, puProxyMin, puProxyMax, entryKernel, unsigned(genericFormulas_.size()), 0, 0, 0});
+      genericFormulas_.emplace_back(GenericFormula{reco::FormulaEvaluator{std::string(formula)},
+                                                   std::vector<double>(formParams.begin(), formParams.end())});
+    } else {
+      entries_.emplace_back(Entry{
+          ptMin, ptMax, etaMin, etaMax, puProxyMin, puProxyMax, entryKernel, bin.parameterOffset, 0, 0, 0});
+    }
+  }
+
+  if (tabulated_) {
+    for (auto& entry : entries_) {
+      maxTabulationDeviation_ = std::max(maxTabulationDeviation_, tabulate(entry, tabulationTolerance));
+    }
+  }
+
+  buildIndex();
+}
+
+double JetCorrector::tabulate(Entry& entry, double const tolerance) {
+  // finest grid: 2^kMax points per factor 2 in pt
+  constexpr int kMax = 12;
+  // points between two grid points at which the deviation is checked
+  constexpr int nChecks = 8;
+
+  auto const bitsMin = std::bit_cast<std::uint32_t>(entry.ptMin);
+  auto const bitsMax = std::bit_cast<std::uint32_t>(entry.ptMax);
+
+  auto const relDeviation = [this, &entry](double const value, double const x) {
+    auto const exact = formula(entry, x);
+    return std::abs(value - exact) / std::max(std::abs(exact), std::numeric_limits<double>::min());
+  };
+
+  auto const tableOffset = table_.size();
+  double maxDeviation{0};
+
+  for (int k = 1; k <= kMax; ++k) {
+    table_.resize(tableOffset);
+
+    // grid points: float values with the lowest (23 - k) mantissa bits set to zero, from ptMin (rounded down) to
+    // ptMax (rounded up); their bit patterns are consecutive multiples of 2^(23 - k)
+    unsigned int const shift = 23 - k;
+    std::uint32_t const firstPoint = bitsMin >> shift;
+    std::uint32_t const lastPoint = (bitsMax >> shift) + 1;
+
+    for (auto point = firstPoint; point <= lastPoint; ++point) {
+      table_.emplace_back(formula(entry, std::bit_cast<float>(point << shift)));
+    }
+
+    entry.tableOffset = tableOffset;
+    entry.tableFirstPoint = firstPoint;
+    entry.tableShift = shift;
+
+    // deviation from the formula between grid points, and at the edges of the bin
+    maxDeviation = std::max(relDeviation(interpolate(entry, entry.ptMin), entry.ptMin),
+                            relDeviation(interpolate(entry, entry.ptMax), entry.ptMax));
+    for (auto point = firstPoint; point < lastPoint; ++point) {
+      auto const x0 = double(std::bit_cast<float>(point << shift));
+      auto const x1 = double(std::bit_cast<float>((point + 1) << shift));
+      for (int ichk = 1; ichk < nChecks; ++ichk) {
+        auto const x = float(x0 + (x1 - x0) * ichk / nChecks);
+        if (x > entry.ptMin and x < entry.ptMax) {
+          maxDeviation = std::max(maxDeviation, relDeviation(interpolate(entry, x), x));
+        }
+      }
+    }
+
+    if (maxDeviation <= tolerance) {
+      return maxDeviation;
+    }
+  }
+
+  throw cms::Exception("Configuration") << "failed to tabulate the jet-energy-scale correction of bin eta=["
+                                        << entry.etaMin << ", " << entry.etaMax << ") puProxy=[" << entry.puProxyMin
+                                        << ", " << entry.puProxyMax << ") with relative tolerance " << tolerance
+                                        << " (relative deviation with the finest grid: " << maxDeviation << ")";
+}
+
+void JetCorrector::buildIndex() {
+  constexpr int kNoLowEdge = std::numeric_limits<int>::min();
+  constexpr int kNoHighEdge = std::numeric_limits<int>::max();
+
+  auto const lowEdge = [](Entry const& entry) { return entry.puProxyMin < 0 ? kNoLowEdge : entry.puProxyMin; };
+  auto const highEdge = [](Entry const& entry) { return entry.puProxyMax < 0 ? kNoHighEdge : entry.puProxyMax; };
+
+  std::stable_sort(entries_.begin(), entries_.end(), [&lowEdge](Entry const& e1, Entry const& e2) {
+    if (e1.etaMin != e2.etaMin) {
+      return e1.etaMin < e2.etaMin;
+    }
+    if (e1.etaMax != e2.etaMax) {
+      return e1.etaMax < e2.etaMax;
+    }
+    return lowEdge(e1) < lowEdge(e2);
+  });
+
+  etaEdges_.clear();
+  etaBinOffsets_.clear();
+  puProxyLowEdges_.clear();
+  puProxyHighEdges_.clear();
+
+  for (auto idx = 0u; idx < entries_.size(); ++idx) {
+    auto const& entry = entries_[idx];
+
+    // first entry of a new eta bin
+    if (idx == 0 or entry.etaMin != entries_[idx - 1].etaMin or entry.etaMax != entries_[idx - 1].etaMax) {
+      if (idx > 0) {
+        auto const prevEtaMax = entries_[idx - 1].etaMax;
+        if (entry.etaMin < prevEtaMax) {
+          throw cms::Exception("InvalidInput")
+              << "overlapping eta bins in input file: [" << entries_[idx - 1].etaMin << ", " << prevEtaMax << ") and ["
+              << entry.etaMin << ", " << entry.etaMax << ")";
+        } else if (entry.etaMin > prevEtaMax) {
+          throw cms::Exception("InvalidInput")
+              << "missing eta bin in input file: no bin for [" << prevEtaMax << ", " << entry.etaMin << ")";
+        }
+      }
+      etaEdges_.emplace_back(entry.etaMin);
+      etaBinOffsets_.emplace_back(idx);
+    } else {
+      // next PU-proxy bin of the same eta bin
+      auto const& prev = entries_[idx - 1];
+      if (lowEdge(entry) < highEdge(prev)) {
+        throw cms::Exception("InvalidInput")
+            << "overlapping PU-proxy bins in input file for eta bin [" << entry.etaMin << ", " << entry.etaMax
+            << "): [" << prev.puProxyMin << ", " << prev.puProxyMax << ") and [" << entry.puProxyMin << ", "
+            << entry.puProxyMax << ")";
+      } else if (lowEdge(entry) > highEdge(prev)) {
+        throw cms::Exception("InvalidInput")
+            << "missing PU-proxy bin in input file for eta bin [" << entry.etaMin << ", " << entry.etaMax
+            << "): no bin for [" << prev.puProxyMax << ", " << entry.puProxyMin << ")";
+      }
+    }
+
+    puProxyLowEdges_.emplace_back(lowEdge(entry));
+    puProxyHighEdges_.emplace_back(highEdge(entry));
+  }
+
+  if (not entries_.empty()) {
+    etaEdges_.emplace_back(entries_.back().etaMax);
+  }
+  etaBinOffsets_.emplace_back(entries_.size());
+}
+
+int JetCorrector::findEntry(float const eta, int const puProxy) const {
+  // eta bin: last lower edge <= eta (eta values at or above the upper edge of the last bin, and NaN, give end())
+  auto const etaEdge = std::upper_bound(etaEdges_.begin(), etaEdges_.end(), eta);
+  if (etaEdge == etaEdges_.begin() or etaEdge == etaEdges_.end()) {
+    return -1;
+  }
+  auto const etaBin = etaEdge - etaEdges_.begin() - 1;
+
+  return findEntryInEtaBin(etaBin, puProxy);
+}
+
+int JetCorrector::findEntryInEtaBin(int const etaBin, int const puProxy) const {
+  // PU-proxy bin: last lower edge <= puProxy in the eta bin
+  auto const first = puProxyLowEdges_.begin() + etaBinOffsets_[etaBin];
+  auto const last = puProxyLowEdges_.begin() + etaBinOffsets_[etaBin + 1];
+  auto const puEdge = std::upper_bound(first, last, puProxy);
+  if (puEdge == first) {
+    return -1;
+  }
+
+  int const idx = puEdge - puProxyLowEdges_.begin() - 1;
+  return (entries_[idx].puProxyMax < 0 or puProxy < puProxyHighEdges_[idx]) ? idx : -1;
+}
+
+void JetCorrector::findEtaBinEntries(std::size_t const nJets,
+                                     int const puProxy,
+                                     std::vector<int>& etaBinEntries) const {
+  // batches larger than the number of eta bins: bin of puProxy in every eta bin, resolved once
+  etaBinEntries.clear();
+  if (nJets > nEtaBins()) {
+    etaBinEntries.resize(nEtaBins());
+    for (auto etaBin = 0u; etaBin < etaBinEntries.size(); ++etaBin) {
+      etaBinEntries[etaBin] = findEntryInEtaBin(etaBin, puProxy);
+    }
+  }
+}
+
+int JetCorrector::findEtaBin(float const eta) const {
+  if (etaEdges_.size() < 2) {
+    return -1;
+  }
+
+  // last lower edge <= eta (or the first edge, if eta is below it), with a fixed number of steps
+  auto const* edge = etaEdges_.data();
+  for (auto n = etaEdges_.size(); n > 1;) {
+    auto const half = n / 2;
+    edge = (edge[half] <= eta) ? edge + half : edge;
+    n -= half;
+  }
+
+  // eta values below the first edge, at or above the last edge, and NaN, are not in any bin
+  bool const inRange = (etaEdges_.front() <= eta) and (eta < etaEdges_.back());
+  return inRange ? int(edge - etaEdges_.data()) : -1;
+}
+
+double JetCorrector::interpolate(Entry const& entry, float const x) const {
+  // within one grid interval the float values are equally spaced, so the position in the interval
+  // is given by the mantissa bits below the grid spacing
+  auto const bits = std::bit_cast<std::uint32_t>(x);
+  auto const* values = table_.data() + entry.tableOffset + ((bits >> entry.tableShift) - entry.tableFirstPoint);
+  double const t = double(bits & ((1u << entry.tableShift) - 1)) / double(1u << entry.tableShift);
+  return values[0] + t * (values[1] - values[0]);
+}
+
+double JetCorrector::formula(Entry const& entry, double const x) const {
+  switch (entry.kernel) {
+    case Kernel::PolyLog:
+      return polyLog(x, parameters_ + entry.index);
+    case Kernel::ScaledPolyLog:
+      return scaledPolyLog(x, parameters_ + entry.index);
+    case Kernel::Generic:
+      break;
+  }
+
+  auto const& genericFormula = genericFormulas_[entry.index];
+  std::array<double, 1> const vars{{x}};
+  return genericFormula.formulaEvaluator.evaluate(vars, genericFormula.formulaParameters);
+}
+
+double JetCorrector::correction(float const pt, float const eta, int const puProxy) const {
+  auto const idx = findEntry(eta, puProxy);
+  return (idx < 0) ? 0 : correction(entries_[idx], pt);
+}
+
+void JetCorrector::corrections(std::span<float const> const pts,
+                               std::span<float const> const etas,
+                               int const puProxy,
+                               std::span<double> const corrections,
+                               Workspace& workspace) const {
+  if (pts.size() != etas.size() or pts.size() != corrections.size()) {
+    throw cms::Exception("LogicError") << "JetCorrector::corrections: inconsistent sizes of the arrays (pt: "
+                                       << pts.size() << ", eta: " << etas.size()
+                                       << ", corrections: " << corrections.size() << ")";
+  }
+
+  auto const nJets = pts.size();
+
+  // large batches: bins of all jets, then evaluation bin by bin
+  if (groupedEvaluation(nJets)) {
+    auto& jetBins = workspace.bins;
+    jetBins.resize(nJets);
+    bins(etas, puProxy, jetBins, workspace);
+    evaluate(jetBins, pts, corrections, workspace);
+    return;
+  }
+
+  auto& etaBinEntries = workspace.etaBinEntries;
+  findEtaBinEntries(nJets, puProxy, etaBinEntries);
+
+  for (auto ijet = 0u; ijet < nJets; ++ijet) {
+    auto const etaBin = findEtaBin(etas[ijet]);
+    auto const idx =
+        (etaBin < 0) ? -1 : (etaBinEntries.empty() ? findEntryInEtaBin(etaBin, puProxy) : etaBinEntries[etaBin]);
+    corrections[ijet] = (idx < 0) ? 0 : correction(entries_[idx], pts[ijet]);
+  }
+}
+
+void JetCorrector::corrections(std::span<float const> const pts,
+                               std::span<float const> const etas,
+                               std::span<int const> const puProxies,
+                               std::span<unsigned int const> const groupOffsets,
+                               std::span<double> const corrections,
+                               Workspace& workspace) const {
+  if (pts.size() != etas.size() or pts.size() != corrections.size()) {
+    throw cms::Exception("LogicError") << "JetCorrector::corrections: inconsistent sizes of the arrays (pt: "
+                                       << pts.size() << ", eta: " << etas.size()
+                                       << ", corrections: " << corrections.size() << ")";
+  }
+
+  // large batches: bins of all groups first, so that the jets of all groups are evaluated together bin by bin
+  if (groupedEvaluation(pts.size())) {
+    auto& jetBins = workspace.bins;
+    jetBins.resize(pts.size());
+    bins(etas, puProxies, groupOffsets, jetBins, workspace);
+    evaluate(jetBins, pts, corrections, workspace);
+    return;
+  }
+
+  auto const batch = [&](int const puProxy, unsigned int const first, unsigned int const nJets) {
+    this->corrections(pts.subspan(first, nJets),
+                      etas.subspan(first, nJets),
+                      puProxy,
+                      corrections.subspan(first, nJets),
+                      workspace);
+  };
+  forEachBatch(puProxies, groupOffsets, pts.size(), batch);
+}
+
+void JetCorrector::bins(std::span<float const> const etas,
+                        int const puProxy,
+                        std::span<int> const bins,
+                        Workspace& workspace) const {
+  if (etas.size() != bins.size()) {
+    throw cms::Exception("LogicError") << "JetCorrector::bins: inconsistent sizes of the arrays (eta: " << etas.size()
+                                       << ", bins: " << bins.size() << ")";
+  }
+
+  auto const nJets = etas.size();
+
+  auto& etaBinEntries = workspace.etaBinEntries;
+  findEtaBinEntries(nJets, puProxy, etaBinEntries);
+
+  for (auto ijet = 0u; ijet < nJets; ++ijet) {
+    auto const etaBin = findEtaBin(etas[ijet]);
+    bins[ijet] =
+        (etaBin < 0) ? -1 : (etaBinEntries.empty() ? findEntryInEtaBin(etaBin, puProxy) : etaBinEntries[etaBin]);
+  }
+}
+
+void JetCorrector::bins(std::span<float const> const etas,
+                        std::span<int const> const puProxies,
+                        std::span<unsigned int const> const groupOffsets,
+                        std::span<int> const bins,
+                        Workspace& workspace) const {
+  if (etas.size() != bins.size()) {
+    throw cms::Exception("LogicError") << "JetCorrector::bins: inconsistent sizes of the arrays (eta: " << etas.size()
+                                       << ", bins: " << bins.size() << ")";
+  }
+
+  auto const batch = [&](int const puProxy, unsigned int const first, unsigned int const nJets) {
+    this->bins(etas.subspan(first, nJets), puProxy, bins.subspan(first, nJets), workspace);
+  };
+  forEachBatch(puProxies, groupOffsets, etas.size(), batch);
+}
+
+void JetCorrector::corrections(std::span<int const> const bins,
+                               std::span<float const> const pts,
+                               std::span<double> const corrections,
+                               Workspace& workspace) const {
+  if (bins.size() != pts.size() or bins.size() != corrections.size()) {
+    throw cms::Exception("LogicError") << "JetCorrector::corrections: inconsistent sizes of the arrays (bins: "
+                                       << bins.size() << ", pt: " << pts.size()
+                                       << ", corrections: " << corrections.size() << ")";
+  }
+
+  auto const nEntries = int(entries_.size());
+  for (auto const idx : bins) {
+    if (idx >= nEntries) {
+      throw cms::Exception("LogicError") << "JetCorrector::corrections: invalid bin index " << idx << " (" << nEntries
+                                         << " bins)";
+    }
+  }
+
+  evaluate(bins, pts, corrections, workspace);
+}
+
+bool JetCorrector::groupedEvaluation(std::size_t const nJets) const {
+  return nJets >= std::max(kMinJetsPerGroupedBatch, entries_.size());
+}
+
+void JetCorrector::evaluate(std::span<int const> const bins,
+                            std::span<float const> const pts,
+                            std::span<double> const corrections,
+                            Workspace& workspace) const {
+  auto const nJets = bins.size();
+  auto const nEntries = entries_.size();
+
+  if (not groupedEvaluation(nJets)) {
+    for (auto ijet = 0u; ijet < nJets; ++ijet) {
+      corrections[ijet] = (bins[ijet] < 0) ? 0 : correction(entries_[bins[ijet]], pts[ijet]);
+    }
+    return;
+  }
+
+  // jets ordered by bin with a counting sort (slot 0: jets outside all bins, slot idx + 1: jets of bin idx)
+  auto& binOffsets = workspace.binOffsets;
+  binOffsets.assign(nEntries + 2, 0);
+  for (auto const idx : bins) {
+    ++binOffsets[idx + 2];
+  }
+  for (auto slot = 2u; slot < binOffsets.size(); ++slot) {
+    binOffsets[slot] += binOffsets[slot - 1];
+  }
+
+  // gather the pt values of the jets of every bin in contiguous ranges (binOffsets[idx + 1]: first jet of bin idx)
+  auto& order = workspace.order;
+  auto& sortedPts = workspace.sortedPts;
+  order.resize(nJets);
+  sortedPts.resize(nJets);
+  for (auto ijet = 0u; ijet < nJets; ++ijet) {
+    auto const pos = binOffsets[bins[ijet] + 1]++;
+    order[pos] = ijet;
+    sortedPts[pos] = pts[ijet];
+  }
+
+  // after the gather, binOffsets[idx + 1] is the end of the range of bin idx (and the start of the next one)
+  auto& sortedCorrections = workspace.sortedCorrections;
+  sortedCorrections.assign(nJets, 0);
+  for (auto idx = 0u; idx < nEntries; ++idx) {
+    auto const first = binOffsets[idx];
+    auto const count = binOffsets[idx + 1] - first;
+    if (count > 0) {
+      evaluateBin(entries_[idx],
+                  std::span<float const>(sortedPts).subspan(first, count),
+                  std::span<double>(sortedCorrections).subspan(first, count));
+    }
+  }
+
+  // scatter
+  for (auto pos = 0u; pos < nJets; ++pos) {
+    corrections[order[pos]] = sortedCorrections[pos];
+  }
+}
+
+void JetCorrector::evaluateBin(Entry const& entry,
+                               std::span<float const> const pts,
+                               std::span<double> const corrections) const {
+  auto const nJets = pts.size();
+  bool const correctedPt = (formulaType_ == FormulaType::CorrectedPt);
+
+  if (tabulated_) {
+    interpolateTable(table_.data() + entry.tableOffset,
+                     entry.tableFirstPoint,
+                     entry.tableShift,
+                     entry.ptMin,
+                     entry.ptMax,
+                     correctedPt,
+                     pts.data(),
+                     corrections.data(),
+                     nJets);
+
+    // NaN pt values are not clamped, and are evaluated with the formula (as in correction())
+    for (auto ijet = 0u; ijet < nJets; ++ijet) {
+      if (std::isnan(pts[ijet])) {
+        corrections[ijet] = correction(entry, pts[ijet]);
+      }
+    }
+    return;
+  }
+
+  switch (entry.kernel) {
+    case Kernel::PolyLog:
+      evaluateKernel<polyLog>(
+          parameters_ + entry.index, entry.ptMin, entry.ptMax, correctedPt, pts.data(), corrections.data(), nJets);
+      return;
+    case Kernel::ScaledPolyLog:
+      evaluateKernel<scaledPolyLog>(
+          parameters_ + entry.index, entry.ptMin, entry.ptMax, correctedPt, pts.data(), corrections.data(), nJets);
+      return;
+    case Kernel::Generic:
+      break;
+  }
+
+  for (auto ijet = 0u; ijet < nJets; ++ijet) {
+    corrections[ijet] = correction(entry, pts[ijet]);
+  }
+}
+
+bool JetCorrector::sameBinning(JetCorrector const& other) const {
+  return etaEdges_ == other.etaEdges_ and etaBinOffsets_ == other.etaBinOffsets_ and
+         puProxyLowEdges_ == other.puProxyLowEdges_ and puProxyHighEdges_ == other.puProxyHighEdges_;
+}
+
+double JetCorrector::correction(Entry const& entry, float const pt) const {
+  auto const x = std::clamp(pt, entry.ptMin, entry.ptMax);
+
+  // NaN pt values are not clamped, and are passed to the formula
+  double const value = (tabulated_ and not std::isnan(x)) ? interpolate(entry, x) : formula(entry, x);
+
+  return (formulaType_ == FormulaType::CorrectedPt) ? (value / double(x)) : value;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+
+JetSoABxCollection::JetSoABxCollection(int const firstBX, int const lastBX)
+    : firstBX_{firstBX}, lastBX_{lastBX}, bxOffsets_(std::max(0, lastBX - firstBX + 1) + 1, 0), openBXIdx_{0} {}
+
+void JetSoABxCollection::reserve(unsigned int const nJets) {
+  pt_.reserve(nJets);
+  eta_.reserve(nJets);
+  phi_.reserve(nJets);
+  mass_.reserve(nJets);
+}
+
+void JetSoABxCollection::push_back(int const bx, float const pt, float const eta, float const phi, float const mass) {
+  if (bx < firstBX_ or bx > lastBX_) {
+    throw cms::Exception("InvalidInput") << "BX value outside the range of the collection [" << firstBX_ << ", "
+                                         << lastBX_ << "]: " << bx;
+  }
+
+  if (finalized()) {
+    throw cms::Exception("LogicError") << "jet added to a finalized JetSoABxCollection (BX=" << bx << ")";
+  }
+
+  int const bxIdx = bx - firstBX_;
+
+  if (bxIdx < openBXIdx_) {
+    throw cms::Exception("InvalidInput") << "jets must be added in non-decreasing order of BX (BX=" << bx << ")";
+  }
+
+  // the BXs from the open BX to bx end before the new jet (only the BXs skipped since the last jet are written)
+  for (; openBXIdx_ < bxIdx; ++openBXIdx_) {
+    bxOffsets_[openBXIdx_ + 1] = pt_.size();
+  }
+
+  pt_.emplace_back(pt);
+  eta_.emplace_back(eta);
+  phi_.emplace_back(phi);
+  mass_.emplace_back(mass);
+}
+
+void JetSoABxCollection::finalize() {
+  if (finalized()) {
+    return;
+  }
+
+  // the open BX ends after the last jet, and the BXs after it are empty
+  std::fill(bxOffsets_.begin() + openBXIdx_ + 1, bxOffsets_.end(), pt_.size());
+  openBXIdx_ = -1;
+}
+
+unsigned int JetSoABxCollection::size(int const bx) const { return end(bx) - begin(bx); }
+
+unsigned int JetSoABxCollection::begin(int const bx) const {
+  checkFinalized();
+  int const nBXs = bxOffsets_.size() - 1;
+  return bxOffsets_[std::clamp(bx - firstBX_, 0, nBXs)];
+}
+
+unsigned int JetSoABxCollection::end(int const bx) const {
+  checkFinalized();
+  int const nBXs = bxOffsets_.size() - 1;
+  return bxOffsets_[std::clamp(bx - firstBX_ + 1, 0, nBXs)];
+}
+
+std::span<float const> JetSoABxCollection::range(std::vector<float> const& values,
+                                                 int const bxMin,
+                                                 int const bxMax) const {
+  auto const first = begin(bxMin);
+  auto const last = std::max(first, end(bxMax));
+  return std::span<float const>(values.data() + first, last - first);
+}
+
+void JetSoABxCollection::checkFinalized() const {
+  if (not finalized()) {
+    throw cms::Exception("LogicError") << "JetSoABxCollection read before the call to finalize()";
+  }
+}
@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyBxArray.h"
+
+JetTopologyBxArray::JetTopologyBxArray(int const firstBX, int const lastBX, std::vector<std::string> countLabels)
+    : BxArrayRange{firstBX, lastBX}, countLabels_{std::move(countLabels)} {
+  nJets_.assign(nBXs(), 0);
+  ht_.assign(nBXs(), 0);
+  mhtX_.assign(nBXs(), 0);
+  mhtY_.assign(nBXs(), 0);
+  mjj_.assign(nBXs(), 0);
+  dEtajj_.assign(nBXs(), 0);
+  dPhijj_.assign(nBXs(), 0);
+  counts_.assign(nBXs() * countLabels_.size(), 0);
+}
+
+void JetTopologyBxArray::set(int const bx, Values const& values, std::span<int const> const counts) {
+  if (counts.size() != countLabels_.size()) {
+    throw cms::Exception("LogicError") << "JetTopologyBxArray::set: invalid number of jet counts (" << counts.size()
+                                       << ", expected " << countLabels_.size() << ")";
+  }
+
+  auto const idx = index(bx);
+  nJets_[idx] = values.nJets;
+  ht_[idx] = values.ht;
+  mhtX_[idx] = values.mhtX;
+  mhtY_[idx] = values.mhtY;
+  mjj_[idx] = values.mjj;
+  dEtajj_[idx] = values.dEtajj;
+  dPhijj_[idx] = values.dPhijj;
+  std::copy(counts.begin(), counts.end(), counts_.begin() + idx * countLabels_.size());
+}
+
+JetTopologyBxArray::Values JetTopologyBxArray::values(int const bx) const {
+  auto const idx = index(bx);
+  return Values{nJets_[idx], ht_[idx], mhtX_[idx], mhtY_[idx], mjj_[idx], dEtajj_[idx], dPhijj_[idx]};
+}
+
+float JetTopologyBxArray::mht(int const bx) const {
+  auto const idx = index(bx);
+  return std::hypot(mhtX_[idx], mhtY_[idx]);
+}
+
+float JetTopologyBxArray::mhtPhi(int const bx) const {
+  auto const idx = index(bx);
+  return std::atan2(mhtY_[idx], mhtX_[idx]);
+}
+
+std::span<int const> JetTopologyBxArray::counts(int const bx) const {
+  auto const nCounts = countLabels_.size();
+  return std::span<int const>(counts_.data() + index(bx) * nCounts, nCounts);
+}
+
+int JetTopologyBxArray::countIndex(std::string const& label) const {
+  auto const it = std::find(countLabels_.begin(), countLabels_.end(), label);
+  return (it == countLabels_.end()) ? -1 : int(it - countLabels_.begin());
+}
+
+std::vector<int> JetTopologyBxArray::countArray(unsigned int const countIdx) const {
+  auto const nCounts = countLabels_.size();
+  if (countIdx >= nCounts) {
+    throw cms::Exception("InvalidInput") << "invalid index of jet count (" << countIdx << ", number of jet counts is "
+                                         << nCounts << ")";
+  }
+
+  std::vector<int> ret(ht_.size());
+  for (auto idx = 0u; idx < ret.size(); ++idx) {
+    ret[idx] = counts_[idx * nCounts + countIdx];
+  }
+  return ret;
+}
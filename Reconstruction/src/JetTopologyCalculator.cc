@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyCalculator.h"
+
+JetTopologyCalculator::JetTopologyCalculator(Selection const& htSelection, std::vector<Selection> countSelections)
+    : htSelection_{htSelection}, countSelections_{std::move(countSelections)} {}
+
+JetTopologyBxArray::Values JetTopologyCalculator::compute(std::span<float const> const pts,
+                                                          std::span<float const> const etas,
+                                                          std::span<float const> const phis,
+                                                          std::span<float const> const masses,
+                                                          std::span<int> const counts) const {
+  auto const nJets = pts.size();
+  if (etas.size() != nJets or phis.size() != nJets or masses.size() != nJets or counts.size() != nCounts()) {
+    throw cms::Exception("LogicError") << "JetTopologyCalculator::compute: inconsistent array sizes (pt: " << nJets
+                                       << ", eta: " << etas.size() << ", phi: " << phis.size()
+                                       << ", mass: " << masses.size() << ", counts: " << counts.size() << ", expected "
+                                       << nCounts() << ")";
+  }
+
+  JetTopologyBxArray::Values ret;
+
+  // HT jets: the jets outside the HT selection contribute zero
+  int nHtJets{0};
+  double ht{0};
+  double mhtX{0};
+  double mhtY{0};
+  for (auto idx = 0u; idx < nJets; ++idx) {
+    auto const pt = pts[idx];
+    bool const sel = htSelection_.selected(pt, std::abs(etas[idx]));
+    nHtJets += sel;
+    ht += sel ? pt : 0.f;
+    mhtX -= sel ? pt * std::cos(phis[idx]) : 0.f;
+    mhtY -= sel ? pt * std::sin(phis[idx]) : 0.f;
+  }
+
+  ret.nJets = nHtJets;
+  ret.ht = ht;
+  ret.mhtX = mhtX;
+  ret.mhtY = mhtY;
+
+  for (auto icnt = 0u; icnt < countSelections_.size(); ++icnt) {
+    auto const& selection = countSelections_[icnt];
+    int count{0};
+    for (auto idx = 0u; idx < nJets; ++idx) {
+      count += selection.selected(pts[idx], std::abs(etas[idx]));
+    }
+    counts[icnt] = count;
+  }
+
+  if (nHtJets < 2) {
+    return ret;
+  }
+
+  // two leading HT jets (indices)
+  auto lead1 = nJets;
+  auto lead2 = nJets;
+  for (auto idx = 0u; idx < nJets; ++idx) {
+    if (not htSelection_.selected(pts[idx], std::abs(etas[idx]))) {
+      continue;
+    }
+    if (lead1 == nJets or pts[idx] > pts[lead1]) {
+      lead2 = lead1;
+      lead1 = idx;
+    } else if (lead2 == nJets or pts[idx] > pts[lead2]) {
+      lead2 = idx;
+    }
+  }
+
+  auto const dEta = etas[lead1] - etas[lead2];
+  auto dPhi = std::abs(phis[lead1] - phis[lead2]);
+  if (dPhi > float(M_PI)) {
+    dPhi = float(2 * M_PI) - dPhi;
+  }
+
+  // m^2 = m1^2 + m2^2 + 2 * (E1 * E2 - pT1 * pT2 * (cos(dphi) + sinh(eta1) * sinh(eta2))),
+  // with E = sqrt(m^2 + (pT * cosh(eta))^2)
+  auto const energy = [&](unsigned int const idx) {
+    return std::sqrt(double(masses[idx]) * masses[idx] + std::pow(pts[idx] * std::cosh(double(etas[idx])), 2));
+  };
+  double const mjjSq = double(masses[lead1]) * masses[lead1] + double(masses[lead2]) * masses[lead2] +
+                       2 * (energy(lead1) * energy(lead2) -
+                            double(pts[lead1]) * pts[lead2] *
+                                (std::cos(dPhi) + std::sinh(double(etas[lead1])) * std::sinh(double(etas[lead2]))));
+
+  ret.mjj = std::sqrt(std::max(0., mjjSq));
+  ret.dEtajj = std::abs(dEta);
+  ret.dPhijj = dPhi;
+
+  return ret;
+}
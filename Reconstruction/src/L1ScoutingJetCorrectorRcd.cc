@@ -0,0 +1,4 @@
+#include "FWCore/Framework/interface/eventsetuprecord_registration_macro.h"
+#include "L1ScoutingTools/Reconstruction/interface/L1ScoutingJetCorrectorRcd.h"
+
+EVENTSETUP_RECORD_REG(L1ScoutingJetCorrectorRcd);
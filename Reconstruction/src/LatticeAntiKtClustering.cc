@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/LatticeAntiKtClustering.h"
+
+#include "fastjet/ClusterSequence.hh"
+
+namespace {
+  // same values as fastjet::pi, fastjet::twopi and fastjet::MaxRap
+  constexpr double kPi = 3.141592653589793238462643383279502884197;
+  constexpr double kTwoPi = 6.283185307179586476925286766559005768394;
+  constexpr double kMaxRap = 1e5;
+
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+  // see fastjet::PseudoJet::set_cached_rap_phi
+  double cachedPhi(double phi) {
+    if (phi >= kTwoPi) {
+      phi -= kTwoPi;
+    }
+    if (phi < 0) {
+      phi += kTwoPi;
+    }
+    return phi;
+  }
+
+  // see fastjet::JetDefinition::DefaultRecombiner (anti-kT)
+  double antiKtMomentumFactor(double const kt2) { return kt2 > 1e-300 ? 1.0 / kt2 : 1e300; }
+}  // namespace
+
+LatticeAntiKtClustering::LatticeAntiKtClustering(double const rParam)
+    : lut_{CaloTowerLUT::get()},
+      rParam_{rParam},
+      r2_{rParam * rParam},
+      fjJetDefinition_{fastjet::antikt_algorithm, rParam},
+      tileMarkCounter_{0},
+      treeLeaves_{0},
+      usedFastJet_{false} {
+  if (rParam_ <= 0) {
+    throw cms::Exception("InvalidInput") << "invalid value for R parameter (must be greater than zero): " << rParam_;
+  }
+
+  // lattice coordinates
+  etaIndex_.fill(-1);
+  for (int hwEta = -kHwEtaOffset; hwEta < kHwRange - kHwEtaOffset; ++hwEta) {
+    if (lut_.validHwEta(hwEta)) {
+      etaIndex_[hwEta + kHwEtaOffset] = latticeEta_.size();
+      latticeEta_.emplace_back(lut_.eta(hwEta));
+    }
+  }
+
+  phiIndex_.fill(-1);
+  for (int hwPhi = 0; hwPhi < kHwRange; ++hwPhi) {
+    if (lut_.validHwPhi(hwPhi)) {
+      phiIndex_[hwPhi] = latticePhi_.size();
+      latticePhi_.emplace_back(cachedPhi(lut_.phi(hwPhi)));
+    }
+  }
+
+  auto const nEta = latticeEta_.size();
+  auto const nPhi = latticePhi_.size();
+
+  if (nEta == 0 or nPhi == 0) {
+    throw cms::Exception("LogicError") << "empty CaloTower lattice (nEta=" << nEta << ", nPhi=" << nPhi << ")";
+  }
+
+  // squared distances between lattice points (same arithmetic as in distance())
+  latticeDEta2_.resize(nEta * nEta);
+  for (auto ie1 = 0u; ie1 < nEta; ++ie1) {
+    for (auto ie2 = 0u; ie2 < nEta; ++ie2) {
+      double const deta = latticeEta_[ie1] - latticeEta_[ie2];
+      latticeDEta2_[ie1 * nEta + ie2] = deta * deta;
+    }
+  }
+
+  latticeDPhi2_.resize(nPhi * nPhi);
+  for (auto ip1 = 0u; ip1 < nPhi; ++ip1) {
+    for (auto ip2 = 0u; ip2 < nPhi; ++ip2) {
+      double dphi = std::abs(latticePhi_[ip1] - latticePhi_[ip2]);
+      if (dphi > kPi) {
+        dphi = kTwoPi - dphi;
+      }
+      latticeDPhi2_[ip1 * nPhi + ip2] = dphi * dphi;
+    }
+  }
+
+  // tiles of size >= R in both rapidity and phi
+  auto const [etaMinIt, etaMaxIt] = std::minmax_element(latticeEta_.begin(), latticeEta_.end());
+  auto const etaSpan = *etaMaxIt - *etaMinIt;
+  tileEtaMin_ = *etaMinIt;
+  nTilesEta_ = std::max(1, int(etaSpan / rParam_));
+  tileEtaSize_ = (etaSpan > 0) ? (etaSpan / nTilesEta_) : rParam_;
+  nTilesPhi_ = std::max(1, int(kTwoPi / rParam_));
+  tilePhiSize_ = kTwoPi / nTilesPhi_;
+
+  auto const nTiles = nTilesEta_ * nTilesPhi_;
+  tileNeighbours_.resize(nTiles);
+  for (auto ie = 0; ie < nTilesEta_; ++ie) {
+    for (auto ip = 0; ip < nTilesPhi_; ++ip) {
+      auto& neighbours = tileNeighbours_[ie * nTilesPhi_ + ip];
+      for (auto ie2 = std::max(0, ie - 1); ie2 <= std::min(nTilesEta_ - 1, ie + 1); ++ie2) {
+        for (auto dp = -1; dp <= 1; ++dp) {
+          auto const tile = ie2 * nTilesPhi_ + (ip + dp + nTilesPhi_) % nTilesPhi_;
+          if (std::find(neighbours.begin(), neighbours.end(), tile) == neighbours.end()) {
+            neighbours.emplace_back(tile);
+          }
+        }
+      }
+    }
+  }
+
+  tileHead_.assign(nTiles, -1);
+  tileMark_.assign(nTiles, 0);
+
+  latticeTile_.resize(nEta * nPhi);
+  for (auto ie = 0u; ie < nEta; ++ie) {
+    for (auto ip = 0u; ip < nPhi; ++ip) {
+      latticeTile_[ie * nPhi + ip] = tileIndex(latticeEta_[ie], latticePhi_[ip]);
+    }
+  }
+}
+
+void LatticeAntiKtClustering::clear() {
+  px_.clear();
+  py_.clear();
+  pz_.clear();
+  E_.clear();
+  rap_.clear();
+  phi_.clear();
+  momFactor_.clear();
+  cellEta_.clear();
+  cellPhi_.clear();
+  towerHwPt_.clear();
+  towerHwEta_.clear();
+  towerHwPhi_.clear();
+  usedFastJet_ = false;
+  beamJets_.clear();
+  fjJets_.clear();
+  jets_.clear();
+}
+
+void LatticeAntiKtClustering::addTower(int const hwPt, int const hwEta, int const hwPhi) {
+  auto const etaIdx = (hwEta >= -kHwEtaOffset and hwEta < kHwRange - kHwEtaOffset) ? etaIndex_[hwEta + kHwEtaOffset] : -1;
+  auto const phiIdx = (hwPhi >= 0 and hwPhi < kHwRange) ? phiIndex_[hwPhi] : -1;
+
+  if (etaIdx < 0 or phiIdx < 0) {
+    throw cms::Exception("InvalidInput") << "CaloTower with invalid lattice coordinates (hwEta=" << hwEta
+                                         << ", hwPhi=" << hwPhi << ")";
+  }
+
+  // same arithmetic as fastjet::PtYPhiM(pt, eta, phi, 0)
+  double const pt = lut_.et(hwPt);
+  double const exprap = lut_.expEta(hwEta);
+  double const pminus = pt / exprap;
+  double const pplus = pt * exprap;
+
+  px_.emplace_back(pt * lut_.cosPhi(hwPhi));
+  py_.emplace_back(pt * lut_.sinPhi(hwPhi));
+  pz_.emplace_back(0.5 * (pplus - pminus));
+  E_.emplace_back(0.5 * (pplus + pminus));
+  rap_.emplace_back(latticeEta_[etaIdx]);
+  phi_.emplace_back(latticePhi_[phiIdx]);
+  momFactor_.emplace_back(antiKtMomentumFactor(px_.back() * px_.back() + py_.back() * py_.back()));
+  cellEta_.emplace_back(etaIdx);
+  cellPhi_.emplace_back(phiIdx);
+
+  towerHwPt_.emplace_back(hwPt);
+  towerHwEta_.emplace_back(hwEta);
+  towerHwPhi_.emplace_back(hwPhi);
+}
+
+bool LatticeAntiKtClustering::run() {
+  int const nJets = px_.size();
+
+  usedFastJet_ = false;
+  fjJets_.clear();
+
+  nn_.resize(nJets);
+  nnTie_.resize(nJets);
+  nnDist_.resize(nJets);
+  diJ_.resize(nJets);
+  tile_.resize(nJets);
+  tileNext_.resize(nJets);
+  tilePrev_.resize(nJets);
+  beamJets_.clear();
+
+  std::fill(tileHead_.begin(), tileHead_.end(), -1);
+
+  auto const nPhi = latticePhi_.size();
+  for (auto slot = 0; slot < nJets; ++slot) {
+    tile_[slot] = latticeTile_[cellEta_[slot] * nPhi + cellPhi_[slot]];
+    insertInTile(slot);
+  }
+
+  for (auto slot = 0; slot < nJets; ++slot) {
+    setNearestNeighbour(slot);
+  }
+
+  for (auto slot = 0; slot < nJets; ++slot) {
+    setDiJ(slot);
+  }
+
+  // build the tournament tree
+  treeLeaves_ = 1;
+  while (treeLeaves_ < unsigned(nJets)) {
+    treeLeaves_ *= 2;
+  }
+  tree_.resize(2 * treeLeaves_);
+  for (auto idx = 0u; idx < treeLeaves_; ++idx) {
+    tree_[treeLeaves_ + idx] = (idx < unsigned(nJets)) ? int(idx) : -1;
+  }
+  for (auto node = treeLeaves_ - 1; node > 0; --node) {
+    auto const left = tree_[2 * node];
+    auto const right = tree_[2 * node + 1];
+    tree_[node] = (right >= 0 and (left < 0 or diJ_[right] < diJ_[left])) ? right : left;
+  }
+
+  for (auto step = 0; step < nJets; ++step) {
+    auto const jetA = tree_[1];
+    auto const jetB = nn_[jetA];
+
+    // the recombination must not depend on how FastJet resolves ties (otherwise, FastJet clusters the towers)
+    if (not unambiguous(jetA)) {
+      runFastJet();
+      return false;
+    }
+
+    ++tileMarkCounter_;
+    touchedTiles_.clear();
+    auto const markNeighbourTiles = [this](int const tile) {
+      for (auto const neighbour : tileNeighbours_[tile]) {
+        if (tileMark_[neighbour] != tileMarkCounter_) {
+          tileMark_[neighbour] = tileMarkCounter_;
+          touchedTiles_.emplace_back(neighbour);
+        }
+      }
+    };
+
+    if (jetB < 0) {
+      // recombination with the beam
+      beamJets_.emplace_back(jetA);
+      removeFromTile(jetA);
+      diJ_[jetA] = kInfinity;
+      updateTree(jetA);
+
+      markNeighbourTiles(tile_[jetA]);
+      for (auto const tile : touchedTiles_) {
+        for (auto slot = tileHead_[tile]; slot >= 0; slot = tileNext_[slot]) {
+          if (nn_[slot] == jetA or nnTie_[slot]) {
+            setNearestNeighbour(slot);
+            setDiJ(slot);
+            updateTree(slot);
+          }
+        }
+      }
+    } else {
+      // recombination of two jets (E-scheme), the new jet takes the lower slot
+      auto const newJet = std::min(jetA, jetB);
+      auto const oldJet = std::max(jetA, jetB);
+
+      removeFromTile(jetA);
+      removeFromTile(jetB);
+      markNeighbourTiles(tile_[jetA]);
+      markNeighbourTiles(tile_[jetB]);
+
+      px_[newJet] = px_[jetA] + px_[jetB];
+      py_[newJet] = py_[jetA] + py_[jetB];
+      pz_[newJet] = pz_[jetA] + pz_[jetB];
+      E_[newJet] = E_[jetA] + E_[jetB];
+      cellEta_[newJet] = -1;
+      cellPhi_[newJet] = -1;
+      setKinematics(newJet);
+
+      diJ_[oldJet] = kInfinity;
+      updateTree(oldJet);
+
+      tile_[newJet] = tileIndex(rap_[newJet], phi_[newJet]);
+      insertInTile(newJet);
+      markNeighbourTiles(tile_[newJet]);
+
+      setNearestNeighbour(newJet);
+
+      for (auto const tile : touchedTiles_) {
+        for (auto slot = tileHead_[tile]; slot >= 0; slot = tileNext_[slot]) {
+          if (slot == newJet) {
+            continue;
+          }
+
+          // (the candidates of a tied nearest neighbour may include jetA or jetB)
+          if (nn_[slot] == jetA or nn_[slot] == jetB or nnTie_[slot]) {
+            setNearestNeighbour(slot);
+          } else {
+            auto const dist = distance(slot, newJet);
+            if (dist < nnDist_[slot]) {
+              nnDist_[slot] = dist;
+              nn_[slot] = newJet;
+            } else if (dist == nnDist_[slot] and nn_[slot] >= 0) {
+              nnTie_[slot] = true;
+              if (momFactor_[newJet] < momFactor_[nn_[slot]]) {
+                nn_[slot] = newJet;
+              }
+            } else {
+              continue;
+            }
+          }
+
+          setDiJ(slot);
+          updateTree(slot);
+        }
+      }
+
+      setDiJ(newJet);
+      updateTree(newJet);
+    }
+  }
+
+  return true;
+}
+
+std::vector<LatticeAntiKtClustering::Jet> const& LatticeAntiKtClustering::inclusiveJets(double const ptMin) {
+  // same selection as fastjet::ClusterSequence::inclusive_jets(ptMin)
+  double const ptMin2 = ptMin * ptMin;
+
+  jets_.clear();
+
+  auto const addJet = [this, ptMin2](Jet const& jet) {
+    if (jet.px * jet.px + jet.py * jet.py >= ptMin2) {
+      jets_.emplace_back(jet);
+    }
+  };
+
+  if (usedFastJet_) {
+    for (auto const& jet : fjJets_) {
+      addJet(jet);
+    }
+  } else {
+    for (auto const slot : beamJets_) {
+      addJet(Jet{px_[slot], py_[slot], pz_[slot], E_[slot]});
+    }
+  }
+
+  std::sort(jets_.begin(), jets_.end(), higherPt);
+
+  return jets_;
+}
+
+bool LatticeAntiKtClustering::higherPt(Jet const& jet1, Jet const& jet2) {
+  double const kt2_1 = jet1.px * jet1.px + jet1.py * jet1.py;
+  double const kt2_2 = jet2.px * jet2.px + jet2.py * jet2.py;
+  return std::tie(kt2_1, jet1.E, jet1.pz, jet1.px, jet1.py) > std::tie(kt2_2, jet2.E, jet2.pz, jet2.px, jet2.py);
+}
+
+std::size_t LatticeAntiKtClustering::bufferCapacity() const {
+  return px_.capacity() + py_.capacity() + pz_.capacity() + E_.capacity() + rap_.capacity() + phi_.capacity() +
+         momFactor_.capacity() + nnDist_.capacity() + diJ_.capacity() + nn_.capacity() + nnTie_.capacity() +
+         cellEta_.capacity() + cellPhi_.capacity() + tile_.capacity() + tileNext_.capacity() + tilePrev_.capacity() +
+         tree_.capacity() + treeStack_.capacity() + touchedTiles_.capacity() + towerHwPt_.capacity() +
+         towerHwEta_.capacity() + towerHwPhi_.capacity() + fjInputs_.capacity() + fjJets_.capacity() +
+         beamJets_.capacity() + jets_.capacity();
+}
+
+void LatticeAntiKtClustering::insertInTile(int const slot) {
+  auto const tile = tile_[slot];
+  auto const head = tileHead_[tile];
+  tilePrev_[slot] = -1;
+  tileNext_[slot] = head;
+  if (head >= 0) {
+    tilePrev_[head] = slot;
+  }
+  tileHead_[tile] = slot;
+}
+
+void LatticeAntiKtClustering::removeFromTile(int const slot) {
+  auto const prev = tilePrev_[slot];
+  auto const next = tileNext_[slot];
+  if (prev >= 0) {
+    tileNext_[prev] = next;
+  } else {
+    tileHead_[tile_[slot]] = next;
+  }
+  if (next >= 0) {
+    tilePrev_[next] = prev;
+  }
+}
+
+double LatticeAntiKtClustering::distance(int const slot1, int const slot2) const {
+  if (cellEta_[slot1] >= 0 and cellEta_[slot2] >= 0) {
+    return latticeDPhi2_[cellPhi_[slot1] * latticePhi_.size() + cellPhi_[slot2]] +
+           latticeDEta2_[cellEta_[slot1] * latticeEta_.size() + cellEta_[slot2]];
+  }
+
+  // see fastjet::ClusterSequence::_bj_dist
+  double dphi = std::abs(phi_[slot1] - phi_[slot2]);
+  double const deta = rap_[slot1] - rap_[slot2];
+  if (dphi > kPi) {
+    dphi = kTwoPi - dphi;
+  }
+  return dphi * dphi + deta * deta;
+}
+
+void LatticeAntiKtClustering::setNearestNeighbour(int const slot) {
+  // as in FastJet, a jet at a distance of exactly R is not a nearest neighbour;
+  // for tied candidates, the one with the smallest momentum factor gives the smallest d_ij any resolution can give
+  nnDist_[slot] = r2_;
+  nn_[slot] = -1;
+  nnTie_[slot] = false;
+  for (auto const tile : tileNeighbours_[tile_[slot]]) {
+    for (auto other = tileHead_[tile]; other >= 0; other = tileNext_[other]) {
+      if (other == slot) {
+        continue;
+      }
+      auto const dist = distance(slot, other);
+      if (dist < nnDist_[slot]) {
+        nnDist_[slot] = dist;
+        nn_[slot] = other;
+        nnTie_[slot] = false;
+      } else if (dist == nnDist_[slot] and nn_[slot] >= 0) {
+        nnTie_[slot] = true;
+        if (momFactor_[other] < momFactor_[nn_[slot]]) {
+          nn_[slot] = other;
+        }
+      }
+    }
+  }
+}
+
+void LatticeAntiKtClustering::setDiJ(int const slot) {
+  // see fastjet::ClusterSequence::_bj_diJ
+  auto momFactor = momFactor_[slot];
+  auto const nn = nn_[slot];
+  if (nn >= 0 and momFactor_[nn] < momFactor) {
+    momFactor = momFactor_[nn];
+  }
+  diJ_[slot] = nnDist_[slot] * momFactor;
+}
+
+void LatticeAntiKtClustering::updateTree(int const slot) {
+  for (auto node = (treeLeaves_ + slot) / 2; node > 0; node /= 2) {
+    auto const left = tree_[2 * node];
+    auto const right = tree_[2 * node + 1];
+    tree_[node] = (right >= 0 and (left < 0 or diJ_[right] < diJ_[left])) ? right : left;
+  }
+}
+
+bool LatticeAntiKtClustering::unambiguous(int const jetA) {
+  // a tied nearest neighbour of jetA gives a different recombination for another resolution of the tie
+  if (nnTie_[jetA]) {
+    return false;
+  }
+
+  auto const diJMin = diJ_[jetA];
+  auto const jetB = nn_[jetA];
+
+  // depth-first search of all the leaves with the minimum d_ij (the winner of a node has the minimum of its subtree)
+  treeStack_.clear();
+  treeStack_.emplace_back(1);
+  while (not treeStack_.empty()) {
+    auto const node = treeStack_.back();
+    treeStack_.pop_back();
+
+    if (node >= treeLeaves_) {
+      auto const slot = tree_[node];
+      // jetB has the same d_ij as jetA if jetA is its only nearest neighbour (same recombination)
+      auto const samePair = (slot == jetB and nn_[jetB] == jetA and not nnTie_[jetB]);
+      // jets without neighbours within R are recombined with the beam in any order
+      auto const beams = (jetB < 0 and nn_[slot] < 0);
+      if (slot != jetA and not samePair and not beams) {
+        return false;
+      }
+      continue;
+    }
+
+    for (auto const child : {2 * node, 2 * node + 1}) {
+      auto const slot = tree_[child];
+      if (slot >= 0 and diJ_[slot] == diJMin) {
+        treeStack_.emplace_back(child);
+      }
+    }
+  }
+
+  return true;
+}
+
+void LatticeAntiKtClustering::runFastJet() {
+  // same inputs as the FastJet backend of the modules
+  fjInputs_.clear();
+  for (auto idx = 0u; idx < towerHwPt_.size(); ++idx) {
+    fjInputs_.emplace_back(
+        caloTowerJetClustering::fastJetInput(lut_, towerHwPt_[idx], towerHwEta_[idx], towerHwPhi_[idx]));
+  }
+
+  // fastjet::ClusterSequence owns its history and cannot be re-used across BXs
+  auto const fjClusterSeq = fastjet::ClusterSequence{fjInputs_, fjJetDefinition_};
+
+  fjJets_.clear();
+  for (auto const& fjJet : fjClusterSeq.inclusive_jets()) {
+    fjJets_.emplace_back(Jet{fjJet.px(), fjJet.py(), fjJet.pz(), fjJet.E()});
+  }
+
+  usedFastJet_ = true;
+}
+
+void LatticeAntiKtClustering::setKinematics(int const slot) {
+  // see fastjet::PseudoJet::_finish_init and fastjet::PseudoJet::_set_rap_phi
+  double const kt2 = px_[slot] * px_[slot] + py_[slot] * py_[slot];
+
+  double phi = (kt2 == 0.0) ? 0.0 : std::atan2(py_[slot], px_[slot]);
+  if (phi < 0.0) {
+    phi += kTwoPi;
+  }
+  if (phi >= kTwoPi) {
+    phi -= kTwoPi;
+  }
+
+  double rap{0.};
+  auto const E = E_[slot];
+  auto const pz = pz_[slot];
+  if (E == std::abs(pz) and kt2 == 0) {
+    double const maxRapHere = kMaxRap + std::abs(pz);
+    rap = (pz >= 0.0) ? maxRapHere : -maxRapHere;
+  } else {
+    double const effectiveM2 = std::max(0.0, (E + pz) * (E - pz) - kt2);
+    double const EPlusPz = E + std::abs(pz);
+    rap = 0.5 * std::log((kt2 + effectiveM2) / (EPlusPz * EPlusPz));
+    if (pz > 0) {
+      rap = -rap;
+    }
+  }
+
+  rap_[slot] = rap;
+  phi_[slot] = phi;
+  momFactor_[slot] = antiKtMomentumFactor(kt2);
+}
+
+int LatticeAntiKtClustering::tileIndex(double const rap, double const phi) const {
+  auto const ieta = std::clamp(int(std::floor((rap - tileEtaMin_) / tileEtaSize_)), 0, nTilesEta_ - 1);
+  auto const iphi = std::clamp(int(phi / tilePhiSize_), 0, nTilesPhi_ - 1);
+  return ieta * nTilesPhi_ + iphi;
+}
@@ -0,0 +1,4 @@
+#include "L1ScoutingTools/Reconstruction/interface/PUProxyBxArray.h"
+
+PUProxyBxArray::PUProxyBxArray(int const firstBX, int const lastBX)
+    : BxArrayRange{firstBX, lastBX}, values_(nBXs(), 0) {}
@@ -0,0 +1,177 @@
+#include <algorithm>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/SlidingWindowJetFinder.h"
+
+SlidingWindowJetFinder::SlidingWindowJetFinder(int const windowHalfSize, int const seedMinHwPt)
+    : lut_{CaloTowerLUT::get()}, windowHalfSize_{windowHalfSize}, seedMinHwPt_{seedMinHwPt}, nInputs_{0} {
+  if (windowHalfSize_ < 0) {
+    throw cms::Exception("InvalidInput") << "invalid value for window half-size (must not be negative): "
+                                         << windowHalfSize_;
+  }
+
+  // lattice coordinates
+  etaIndex_.fill(-1);
+  for (int hwEta = -kHwEtaOffset; hwEta < kHwRange - kHwEtaOffset; ++hwEta) {
+    if (lut_.validHwEta(hwEta)) {
+      etaIndex_[hwEta + kHwEtaOffset] = sinhEta_.size();
+      sinhEta_.emplace_back(lut_.sinhEta(hwEta));
+      coshEta_.emplace_back(lut_.coshEta(hwEta));
+    }
+  }
+
+  phiIndex_.fill(-1);
+  for (int hwPhi = 0; hwPhi < kHwRange; ++hwPhi) {
+    if (lut_.validHwPhi(hwPhi)) {
+      phiIndex_[hwPhi] = cosPhi_.size();
+      cosPhi_.emplace_back(lut_.cosPhi(hwPhi));
+      sinPhi_.emplace_back(lut_.sinPhi(hwPhi));
+    }
+  }
+
+  nEta_ = sinhEta_.size();
+  nPhi_ = cosPhi_.size();
+
+  if (nEta_ == 0 or nPhi_ == 0) {
+    throw cms::Exception("LogicError") << "empty CaloTower lattice (nEta=" << nEta_ << ", nPhi=" << nPhi_ << ")";
+  }
+
+  if (2 * windowHalfSize_ + 1 > nPhi_) {
+    throw cms::Exception("InvalidInput") << "invalid value for window half-size (window larger than the number of "
+                                         << "phi positions, " << nPhi_ << "): " << windowHalfSize_;
+  }
+
+  cellHwPt_.assign(nEta_ * nPhi_, 0);
+}
+
+void SlidingWindowJetFinder::clear() {
+  for (auto const cell : filledCells_) {
+    cellHwPt_[cell] = 0;
+  }
+  filledCells_.clear();
+  nInputs_ = 0;
+  allJets_.clear();
+  seedCells_.clear();
+  jets_.clear();
+}
+
+void SlidingWindowJetFinder::addTower(int const hwPt, int const hwEta, int const hwPhi) {
+  auto const etaIdx = (hwEta >= -kHwEtaOffset and hwEta < kHwRange - kHwEtaOffset) ? etaIndex_[hwEta + kHwEtaOffset] : -1;
+  auto const phiIdx = (hwPhi >= 0 and hwPhi < kHwRange) ? phiIndex_[hwPhi] : -1;
+
+  if (etaIdx < 0 or phiIdx < 0) {
+    throw cms::Exception("InvalidInput") << "CaloTower with invalid lattice coordinates (hwEta=" << hwEta
+                                         << ", hwPhi=" << hwPhi << ")";
+  }
+
+  ++nInputs_;
+
+  if (hwPt <= 0) {
+    return;
+  }
+
+  auto const cell = etaIdx * nPhi_ + phiIdx;
+  if (cellHwPt_[cell] == 0) {
+    filledCells_.emplace_back(cell);
+  }
+  cellHwPt_[cell] += hwPt;
+}
+
+bool SlidingWindowJetFinder::isSeed(int const cell) const {
+  auto const seedHwPt = cellHwPt_[cell];
+  if (seedHwPt < seedMinHwPt_) {
+    return false;
+  }
+
+  auto const ie0 = cell / nPhi_;
+  auto const ip0 = cell % nPhi_;
+
+  for (auto de = -windowHalfSize_; de <= windowHalfSize_; ++de) {
+    auto const ie = ie0 + de;
+    if (ie < 0 or ie >= nEta_) {
+      continue;
+    }
+    for (auto dp = -windowHalfSize_; dp <= windowHalfSize_; ++dp) {
+      if (de == 0 and dp == 0) {
+        continue;
+      }
+      auto const hwPt = cellHwPt_[ie * nPhi_ + (ip0 + dp + nPhi_) % nPhi_];
+      auto const strict = (de > 0 or (de == 0 and dp > 0));
+      if (strict ? (hwPt >= seedHwPt) : (hwPt > seedHwPt)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void SlidingWindowJetFinder::run() {
+  allJets_.clear();
+  seedCells_.clear();
+  jets_.clear();
+
+  for (auto const cell : filledCells_) {
+    if (not isSeed(cell)) {
+      continue;
+    }
+
+    auto const ie0 = cell / nPhi_;
+    auto const ip0 = cell % nPhi_;
+
+    Jet jet{0., 0., 0., 0.};
+    for (auto ie = std::max(0, ie0 - windowHalfSize_); ie <= std::min(nEta_ - 1, ie0 + windowHalfSize_); ++ie) {
+      for (auto dp = -windowHalfSize_; dp <= windowHalfSize_; ++dp) {
+        auto const ip = (ip0 + dp + nPhi_) % nPhi_;
+        auto const hwPt = cellHwPt_[ie * nPhi_ + ip];
+        if (hwPt == 0) {
+          continue;
+        }
+        auto const et = lut_.et(hwPt);
+        jet.px += et * cosPhi_[ip];
+        jet.py += et * sinPhi_[ip];
+        jet.pz += et * sinhEta_[ie];
+        jet.E += et * coshEta_[ie];
+      }
+    }
+
+    allJets_.emplace_back(jet);
+    seedCells_.emplace_back(cell);
+  }
+}
+
+std::vector<SlidingWindowJetFinder::Jet> const& SlidingWindowJetFinder::jets(double const ptMin) {
+  jets_.clear();
+  sortValues_.resize(allJets_.size());
+  sortIndices_.clear();
+
+  auto const pt2Min = (ptMin > 0) ? ptMin * ptMin : 0.;
+  for (auto idx = 0u; idx < allJets_.size(); ++idx) {
+    auto const& jet = allJets_[idx];
+    auto const pt2 = jet.px * jet.px + jet.py * jet.py;
+    sortValues_[idx] = -pt2;
+    if (pt2 >= pt2Min) {
+      sortIndices_.emplace_back(idx);
+    }
+  }
+
+  // jets with equal pT are ordered by the lattice position of their seed,
+  // so that the output does not depend on the order of the inputs
+  std::sort(sortIndices_.begin(), sortIndices_.end(), [this](int const idx1, int const idx2) {
+    auto const val1 = sortValues_[idx1];
+    auto const val2 = sortValues_[idx2];
+    return (val1 < val2) or (val1 == val2 and seedCells_[idx1] < seedCells_[idx2]);
+  });
+
+  for (auto const idx : sortIndices_) {
+    jets_.emplace_back(allJets_[idx]);
+  }
+
+  return jets_;
+}
+
+std::size_t SlidingWindowJetFinder::bufferCapacity() const {
+  return cellHwPt_.capacity() + filledCells_.capacity() + allJets_.capacity() + seedCells_.capacity() +
+         jets_.capacity() + sortValues_.capacity() + sortIndices_.capacity();
+}
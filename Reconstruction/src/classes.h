@@ -0,0 +1,8 @@
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "DataFormats/L1Scouting/interface/OrbitCollection.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "L1ScoutingTools/Reconstruction/interface/BxArrayRange.h"
+#include "L1ScoutingTools/Reconstruction/interface/EtSumBxArray.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyBxArray.h"
+#include "L1ScoutingTools/Reconstruction/interface/PUProxyBxArray.h"
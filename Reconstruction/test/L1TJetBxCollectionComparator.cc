@@ -0,0 +1,87 @@
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+// Test module: compares the jets of two l1t::JetBxCollections in the BXs [bxMin, bxMax] (same jets in the same order,
+// bitwise-identical four-momenta), and throws an exception at the first difference
+class L1TJetBxCollectionComparator : public edm::global::EDAnalyzer<> {
+public:
+  explicit L1TJetBxCollectionComparator(edm::ParameterSet const&);
+
+  static void fillDescriptions(edm::ConfigurationDescriptions&);
+
+private:
+  void analyze(edm::StreamID, edm::Event const&, edm::EventSetup const&) const override;
+
+  edm::EDGetTokenT<l1t::JetBxCollection> const srcToken_;
+  edm::EDGetTokenT<l1t::JetBxCollection> const referenceToken_;
+  int const bxMin_;
+  int const bxMax_;
+};
+
+L1TJetBxCollectionComparator::L1TJetBxCollectionComparator(edm::ParameterSet const& iConfig)
+    : srcToken_{consumes(iConfig.getParameter<edm::InputTag>("src"))},
+      referenceToken_{consumes(iConfig.getParameter<edm::InputTag>("reference"))},
+      bxMin_{iConfig.getParameter<int>("bxMin")},
+      bxMax_{iConfig.getParameter<int>("bxMax")} {}
+
+void L1TJetBxCollectionComparator::analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const {
+  auto const& jets = iEvent.get(srcToken_);
+  auto const& refJets = iEvent.get(referenceToken_);
+
+  auto const containsBXs = [this](l1t::JetBxCollection const& coll) {
+    return coll.getFirstBX() <= bxMin_ and coll.getLastBX() >= bxMax_;
+  };
+
+  if (not(containsBXs(jets) and containsBXs(refJets))) {
+    throw cms::Exception("LogicError") << "[" << moduleDescription().moduleLabel() << "] " << iEvent.id()
+                                       << ": BXs [" << bxMin_ << ", " << bxMax_ << "] not in the BX ranges of the inputs (["
+                                       << jets.getFirstBX() << ", " << jets.getLastBX() << "], reference: ["
+                                       << refJets.getFirstBX() << ", " << refJets.getLastBX() << "])";
+  }
+
+  unsigned int nJets{0};
+  for (auto bx = bxMin_; bx <= bxMax_; ++bx) {
+    if (jets.size(bx) != refJets.size(bx)) {
+      throw cms::Exception("LogicError") << "[" << moduleDescription().moduleLabel() << "] " << iEvent.id()
+                                         << ": different number of jets in BX=" << bx << " (" << jets.size(bx)
+                                         << ", reference: " << refJets.size(bx) << ")";
+    }
+
+    for (auto idx = 0u; idx < jets.size(bx); ++idx) {
+      auto const& jet = jets.at(bx, idx);
+      auto const& refJet = refJets.at(bx, idx);
+      if (jet.px() != refJet.px() or jet.py() != refJet.py() or jet.pz() != refJet.pz() or
+          jet.energy() != refJet.energy()) {
+        throw cms::Exception("LogicError")
+            << "[" << moduleDescription().moduleLabel() << "] " << iEvent.id() << ": different jet #" << idx
+            << " in BX=" << bx << " (pt=" << jet.pt() << ", eta=" << jet.eta() << ", phi=" << jet.phi()
+            << ", mass=" << jet.mass() << "; reference: pt=" << refJet.pt() << ", eta=" << refJet.eta()
+            << ", phi=" << refJet.phi() << ", mass=" << refJet.mass() << ")";
+      }
+    }
+
+    nJets += jets.size(bx);
+  }
+
+  LogTrace("L1TJetBxCollectionComparator") << "[L1TJetBxCollectionComparator] [" << moduleDescription().moduleLabel()
+                                           << "] " << iEvent.id() << ": " << nJets << " identical jets";
+}
+
+void L1TJetBxCollectionComparator::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+
+  desc.add<edm::InputTag>("src")->setComment("Input jets (type: l1t::JetBxCollection)");
+  desc.add<edm::InputTag>("reference")->setComment("Reference jets (type: l1t::JetBxCollection)");
+  desc.add<int>("bxMin", 0)->setComment("Min BX (inclusive)");
+  desc.add<int>("bxMax", 0)->setComment("Max BX (inclusive)");
+
+  descriptions.add("l1tJetBxCollectionComparator", desc);
+}
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+DEFINE_FWK_MODULE(L1TJetBxCollectionComparator);
@@ -104,6 +104,18 @@ process.l1ScAK4CaloTowerJets = ScoutingJetProducer(
     ptMin = 0.5
 )
 
+from L1ScoutingTools.Reconstruction.L1TCaloTowerOrbitAKJetProducer import L1TCaloTowerOrbitAKJetProducer
+process.l1sAK4CTJetsOrbit = L1TCaloTowerOrbitAKJetProducer(
+    src = 'l1ScCaloTowerUnpacker:CaloTower',
+    rParam = 0.4,
+    jetPtMin = 0.5,
+    concurrentBXs = True
+)
+
+# jet seeds evaluated on the orbit AK4 CaloTower jets (BXs selected by any seed are kept by FinalBxSelector)
+from L1ScoutingTools.Reconstruction.l1sAK4CTJetsOrbitSeeds_cfi import l1sAK4CTJetsOrbitSeeds as _l1sAK4CTJetsOrbitSeeds
+process.l1sAK4CTJetsOrbitSeeds = _l1sAK4CTJetsOrbitSeeds.clone()
+
 process.L1SUnpackingSequence = cms.Sequence(
     process.l1ScGmtUnpacker
   + process.l1ScCaloUnpacker
@@ -182,7 +194,8 @@ process.FinalBxSelector = cms.EDFilter("FinalBxSelector",
         cms.InputTag("DoubleMuPt0Qual8", "SelBx"),
         cms.InputTag("HMJetMult4Et20", "SelBx"),
         cms.InputTag("MuTagJetEt30Dr0p4", "SelBx"),
-        cms.InputTag("Stubs3BxWindowWheelCond", "SelBx")
+        cms.InputTag("Stubs3BxWindowWheelCond", "SelBx"),
+        cms.InputTag("l1sAK4CTJetsOrbitSeeds", "SelBx")
     ),
 )
 
@@ -241,7 +254,9 @@ process.bxSelectors = cms.Sequence(
     process.SingleMuPt0BMTF +
     process.DoubleMuPt0Qual8 +
     process.MuTagJetEt30Dr0p4 +
-    process.Stubs3BxWindowWheelCond
+    process.Stubs3BxWindowWheelCond +
+    process.l1sAK4CTJetsOrbit +
+    cms.ignore(process.l1sAK4CTJetsOrbitSeeds)
 )
 process.MaskedCollections = cms.Sequence(
     process.FinalBxSelectorMuon +
@@ -289,6 +304,7 @@ if args.outputFileNamePrefix:
             'keep *_DoubleMuPt0Qual8_*_*',
             'keep *_MuTagJetEt30Dr0p4_*_*',
             'keep *_Stubs3BxWindowWheelCond_*_*',
+            'keep *_l1sAK4CTJetsOrbitSeeds_*_*',
             'keep *_FinalBxSelector*_*_*',
         ]
     )
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <string>
+
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/LatticeAntiKtClustering.h"
+#include "L1TriggerScouting/Utilities/interface/conversion.h"
+
+#include "fastjet/PseudoJet.hh"
+
+// Exactness of CaloTowerLUT: for every hwPt of the 9-bit domain and every valid (hwEta, hwPhi) cell, the tower
+// four-momentum built from the lookup tables must be identical (px, py, pz, E, rapidity and phi) to
+// fastjet::PtYPhiM(fEt, fEta, fPhi, 0) of the l1ScoutingRun3::calol1 values (the valid values of hwEta and hwPhi
+// must be the ones of l1ScoutingRun3::calol1::validHwEta/validHwPhi):
+//  - caloTowerJetClustering::fastJetInput (input of the FastJet backend),
+//  - the single-tower jet of LatticeAntiKtClustering (input of the Lattice backend).
+// The ET values outside the 9-bit domain must be the ones of l1ScoutingRun3::calol1::fEt.
+int main() {
+  namespace calol1 = l1ScoutingRun3::calol1;
+
+  std::string const delimiter = "================================================";
+
+  auto const& lut = CaloTowerLUT::get();
+
+  LatticeAntiKtClustering latticeClustering{0.4};
+
+  // validity of the lattice coordinates
+  unsigned int nValidHwEta{0};
+  unsigned int nValidHwPhi{0};
+  unsigned int nDifferentValidity{0};
+  for (auto hwEta = CaloTowerLUT::kHwEtaMin; hwEta <= CaloTowerLUT::kHwEtaMax; ++hwEta) {
+    nValidHwEta += lut.validHwEta(hwEta);
+    nDifferentValidity += (lut.validHwEta(hwEta) != calol1::validHwEta(hwEta));
+  }
+  for (auto hwPhi = CaloTowerLUT::kHwPhiMin; hwPhi <= CaloTowerLUT::kHwPhiMax; ++hwPhi) {
+    nValidHwPhi += lut.validHwPhi(hwPhi);
+    nDifferentValidity += (lut.validHwPhi(hwPhi) != calol1::validHwPhi(hwPhi));
+  }
+
+  unsigned long nTowers{0};
+  unsigned long nDifferentFastJet{0};
+  unsigned long nDifferentLattice{0};
+
+  for (auto hwEta = CaloTowerLUT::kHwEtaMin; hwEta <= CaloTowerLUT::kHwEtaMax; ++hwEta) {
+    if (not lut.validHwEta(hwEta)) {
+      continue;
+    }
+
+    for (auto hwPhi = CaloTowerLUT::kHwPhiMin; hwPhi <= CaloTowerLUT::kHwPhiMax; ++hwPhi) {
+      if (not lut.validHwPhi(hwPhi)) {
+        continue;
+      }
+
+      for (auto hwPt = 0; hwPt <= CaloTowerLUT::kHwPtMax; ++hwPt) {
+        ++nTowers;
+
+        auto const ref = fastjet::PtYPhiM(calol1::fEt(hwPt), calol1::fEta(hwEta), calol1::fPhi(hwPhi), 0);
+
+        auto const fjInput = caloTowerJetClustering::fastJetInput(lut, hwPt, hwEta, hwPhi);
+        if (fjInput.px() != ref.px() or fjInput.py() != ref.py() or fjInput.pz() != ref.pz() or
+            fjInput.E() != ref.E() or fjInput.rap() != ref.rap() or fjInput.phi() != ref.phi()) {
+          ++nDifferentFastJet;
+        }
+
+        latticeClustering.clear();
+        latticeClustering.addTower(hwPt, hwEta, hwPhi);
+        latticeClustering.run();
+        auto const& jets = latticeClustering.inclusiveJets(0);
+        if (jets.size() != 1 or jets[0].px != ref.px() or jets[0].py != ref.py() or jets[0].pz != ref.pz() or
+            jets[0].E != ref.E()) {
+          ++nDifferentLattice;
+        }
+      }
+    }
+  }
+
+  // ET outside the 9-bit domain
+  unsigned int nDifferentEtOutOfRange{0};
+  for (auto const hwPt : {-1, CaloTowerLUT::kHwPtMax + 1, 2 * CaloTowerLUT::kHwPtMax, 4096}) {
+    nDifferentEtOutOfRange += (lut.et(hwPt) != double(calol1::fEt(hwPt)));
+  }
+
+  bool const success = (nTowers > 0 and nDifferentValidity == 0 and nDifferentFastJet == 0 and
+                        nDifferentLattice == 0 and nDifferentEtOutOfRange == 0);
+
+  std::cout << "valid hwEta values = " << nValidHwEta << ", valid hwPhi values = " << nValidHwPhi
+            << ", values with a validity different from calol1::validHwEta/validHwPhi = " << nDifferentValidity
+            << std::endl;
+  std::cout << "towers = " << nTowers << std::endl;
+  std::cout << "towers different from fastjet::PtYPhiM: fastJetInput = " << nDifferentFastJet
+            << ", LatticeAntiKtClustering = " << nDifferentLattice << std::endl;
+  std::cout << "ET values outside the 9-bit domain different from fEt = " << nDifferentEtOutOfRange << std::endl;
+  std::cout << delimiter << std::endl;
+
+  std::cout << (success ? "SUCCESS" : "FAILURE") << " (no difference allowed)" << std::endl;
+
+  return success ? 0 : 1;
+}
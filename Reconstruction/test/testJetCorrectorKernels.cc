@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/FileInPath.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+
+// Exactness of the JetCorrector kernels: corrections with the kernels vs corrections with reco::FormulaEvaluator,
+// on a grid of (pt, eta, PU proxy) covering the full pt range of the bins (including the clamped values).
+// Exactness of the batch interfaces: corrections of groups of jets with one PU proxy per group (e.g. per BX)
+// vs correction() of every jet, with and without interpolation tables.
+// Variations of the corrections (as in L1TCaloTowerJetCorrectorC): bins found with one JetCorrector and re-used by
+// another with the same binning vs an independent lookup, scaled nominal corrections, and sameBinning() of JetCorrectors
+// with different bins.
+int main() {
+  std::vector<std::string> const jecFiles{"L1ScoutingTools/Reconstruction/data/JEC_AK4CaloTowerL1S_Run3Winter25_v1.txt",
+                                          "L1ScoutingTools/Reconstruction/data/JEC_AK4CaloTowerL1S_Run3Winter25_v2.txt"};
+
+  unsigned int const nPtValues = 2000;
+  double const ptGridMin = 0.5;
+  double const ptGridMax = 5000.;
+  double const maxRelDiffAllowed = 1e-12;
+
+  std::string const delimiter = "================================================";
+
+  bool success{true};
+
+  // buffers of the batch interface, shared by all the JetCorrectors
+  JetCorrector::Workspace workspace;
+
+  for (auto const& jecFile : jecFiles) {
+    auto const jecFilePath = edm::FileInPath(jecFile).fullPath();
+
+    for (auto const formulaType : {JetCorrector::FormulaType::CorrectionFactor, JetCorrector::FormulaType::CorrectedPt}) {
+      JetCorrector const kernelCorrector{jecFilePath, formulaType, true};
+      JetCorrector const genericCorrector{jecFilePath, formulaType, false};
+
+      unsigned long nValues{0};
+      unsigned long nDifferent{0};
+      double maxRelDiff{0};
+
+      for (auto ieta = 0; ieta <= 104; ++ieta) {
+        float const eta = -5.2f + 0.1f * ieta;
+        for (auto puProxy = 0; puProxy <= 150; puProxy += 5) {
+          for (auto ipt = 0u; ipt < nPtValues; ++ipt) {
+            float const pt = ptGridMin * std::pow(ptGridMax / ptGridMin, double(ipt) / (nPtValues - 1));
+
+            auto const corr = kernelCorrector.correction(pt, eta, puProxy);
+            auto const refCorr = genericCorrector.correction(pt, eta, puProxy);
+
+            ++nValues;
+            if (corr != refCorr) {
+              ++nDifferent;
+              maxRelDiff = std::max(maxRelDiff, std::abs(corr - refCorr) / std::max(std::abs(refCorr), 1e-300));
+            }
+          }
+        }
+      }
+
+      success &= (maxRelDiff <= maxRelDiffAllowed);
+
+      std::cout << jecFile << " ("
+                << (formulaType == JetCorrector::FormulaType::CorrectedPt ? "CorrectedPt" : "CorrectionFactor")
+                << "): bins with kernels = " << (kernelCorrector.nBins() - kernelCorrector.nGenericBins()) << "/"
+                << kernelCorrector.nBins() << ", values = " << nValues << ", different values = " << nDifferent
+                << ", max relative difference = " << maxRelDiff << std::endl;
+      std::cout << delimiter << std::endl;
+    }
+  }
+
+  // random jets in groups (BXs) with one PU proxy per group: empty groups, runs of groups with the same PU proxy,
+  // and enough jets in total for the evaluation bin by bin
+  std::vector<unsigned int> const groupSizes{0, 7, 300, 300, 40, 2000, 0, 1};
+  std::vector<int> const puProxies{12, 12, 47, 47, 130, 5, 5, 250};
+
+  std::vector<unsigned int> groupOffsets{0};
+  for (auto const groupSize : groupSizes) {
+    groupOffsets.emplace_back(groupOffsets.back() + groupSize);
+  }
+
+  auto const nJets = groupOffsets.back();
+  std::vector<float> pts(nJets);
+  std::vector<float> etas(nJets);
+
+  std::mt19937 rng{20251017};
+  std::uniform_real_distribution<double> logPtDist{std::log(ptGridMin), std::log(ptGridMax)};
+  std::uniform_real_distribution<float> etaDist{-5.5f, 5.5f};
+  for (auto ijet = 0u; ijet < nJets; ++ijet) {
+    pts[ijet] = std::exp(logPtDist(rng));
+    etas[ijet] = etaDist(rng);
+  }
+
+  for (auto const& jecFile : jecFiles) {
+    auto const jecFilePath = edm::FileInPath(jecFile).fullPath();
+
+    for (auto const tabulationTolerance : {0., 1e-4}) {
+      JetCorrector const jetCorrector{jecFilePath, JetCorrector::FormulaType::CorrectedPt, true, tabulationTolerance};
+
+      std::vector<double> corrs(nJets);
+      jetCorrector.corrections(pts, etas, puProxies, groupOffsets, corrs, workspace);
+
+      unsigned long nDifferent{0};
+      for (auto igrp = 0u; igrp < groupSizes.size(); ++igrp) {
+        for (auto ijet = groupOffsets[igrp]; ijet < groupOffsets[igrp + 1]; ++ijet) {
+          nDifferent += (corrs[ijet] != jetCorrector.correction(pts[ijet], etas[ijet], puProxies[igrp]));
+        }
+      }
+
+      success &= (nDifferent == 0);
+
+      std::cout << jecFile << " (grouped corrections, tabulation tolerance = " << tabulationTolerance
+                << "): groups = " << groupSizes.size() << ", values = " << nJets
+                << ", values different from correction() = " << nDifferent << std::endl;
+      std::cout << delimiter << std::endl;
+    }
+  }
+
+  // variations: nominal corrections from the second file, shifted corrections from the first file (same bins)
+  {
+    JetCorrector const nominal{edm::FileInPath(jecFiles[1]).fullPath(), JetCorrector::FormulaType::CorrectedPt};
+    JetCorrector const shifted{edm::FileInPath(jecFiles[0]).fullPath(), JetCorrector::FormulaType::CorrectedPt};
+
+    std::vector<int> bins(nJets);
+    nominal.bins(etas, puProxies, groupOffsets, bins, workspace);
+
+    // shared binning: bins of the nominal JetCorrector vs independent lookup
+    std::vector<double> corrs(nJets);
+    std::vector<double> refCorrs(nJets);
+    shifted.corrections(bins, pts, corrs, workspace);
+    shifted.corrections(pts, etas, puProxies, groupOffsets, refCorrs, workspace);
+
+    unsigned long nDifferentShared{0};
+    for (auto ijet = 0u; ijet < nJets; ++ijet) {
+      nDifferentShared += (corrs[ijet] != refCorrs[ijet]);
+    }
+
+    auto const sameBinning = shifted.sameBinning(nominal);
+    success &= (sameBinning and nDifferentShared == 0);
+
+    std::cout << "variation with shared bins: sameBinning = " << sameBinning << ", values = " << nJets
+              << ", values different from the independent lookup = " << nDifferentShared << std::endl;
+    std::cout << delimiter << std::endl;
+
+    // scale-only variation: nominal corrections from the shared bins, scaled
+    double const scale = 1.02;
+    nominal.corrections(bins, pts, corrs, workspace);
+    for (auto& corr : corrs) {
+      corr *= scale;
+    }
+
+    unsigned long nDifferentScaled{0};
+    for (auto igrp = 0u; igrp < groupSizes.size(); ++igrp) {
+      for (auto ijet = groupOffsets[igrp]; ijet < groupOffsets[igrp + 1]; ++ijet) {
+        nDifferentScaled += (corrs[ijet] != scale * nominal.correction(pts[ijet], etas[ijet], puProxies[igrp]));
+      }
+    }
+
+    success &= (nDifferentScaled == 0);
+
+    std::cout << "scale-only variation (scale = " << scale << "): values = " << nJets
+              << ", values different from the scaled correction() = " << nDifferentScaled << std::endl;
+    std::cout << delimiter << std::endl;
+
+    // different binning: bins of the first eta bin only
+    auto const partialFilePath =
+        (std::filesystem::temp_directory_path() / "testJetCorrectorKernels_partialJEC.txt").string();
+    {
+      std::ifstream input{edm::FileInPath(jecFiles[1]).fullPath()};
+      std::ofstream output{partialFilePath};
+      float firstEtaMin{0};
+      bool first{true};
+      for (std::string line; std::getline(input, line);) {
+        float ptMin, ptMax, etaMin;
+        if (not(std::istringstream{line} >> ptMin >> ptMax >> etaMin)) {
+          continue;
+        }
+        if (first) {
+          firstEtaMin = etaMin;
+          first = false;
+        }
+        if (etaMin == firstEtaMin) {
+          output << line << "\n";
+        }
+      }
+    }
+
+    JetCorrector const partial{partialFilePath, JetCorrector::FormulaType::CorrectedPt};
+    std::remove(partialFilePath.c_str());
+
+    auto const differentBinning = not(partial.sameBinning(nominal) or nominal.sameBinning(partial));
+    success &= (differentBinning and partial.sameBinning(partial) and partial.nBins() < nominal.nBins());
+
+    std::cout << "variation with different bins (" << partial.nBins() << "/" << nominal.nBins()
+              << " bins): sameBinning = " << not differentBinning << std::endl;
+    std::cout << delimiter << std::endl;
+  }
+
+  std::cout << (success ? "SUCCESS" : "FAILURE") << " (max relative difference allowed: " << maxRelDiffAllowed
+            << ", no difference allowed for the batch interfaces)" << std::endl;
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "L1ScoutingTools/Reconstruction/interface/JetTopologyCalculator.h"
+
+// Exactness of JetTopologyCalculator: values of one BX vs a brute-force reference (HT jets sorted in pT with a
+// stable sort, four-vectors of the leading pair summed in Cartesian coordinates, delta-phi from std::remainder),
+// on BXs with fixed configurations (leading pair across phi = +-pi, equal pT, one HT jet, jets outside the HT
+// selection) and on random BXs (pT rounded to 0.5 GeV to have equal pT values, phi values close to +-pi).
+namespace {
+
+  struct Jet {
+    float pt;
+    float eta;
+    float phi;
+    float mass;
+  };
+
+  struct Reference {
+    JetTopologyBxArray::Values values;
+    std::vector<int> counts;
+  };
+
+  Reference reference(std::vector<Jet> const& jets,
+                      JetTopologyCalculator::Selection const& htSelection,
+                      std::vector<JetTopologyCalculator::Selection> const& countSelections) {
+    Reference ret;
+    ret.counts.assign(countSelections.size(), 0);
+
+    double ht{0};
+    double mhtX{0};
+    double mhtY{0};
+    std::vector<unsigned int> htJets;
+    for (auto idx = 0u; idx < jets.size(); ++idx) {
+      auto const& jet = jets[idx];
+      for (auto icnt = 0u; icnt < countSelections.size(); ++icnt) {
+        if (countSelections[icnt].selected(jet.pt, std::abs(jet.eta))) {
+          ++ret.counts[icnt];
+        }
+      }
+      if (htSelection.selected(jet.pt, std::abs(jet.eta))) {
+        htJets.emplace_back(idx);
+        ht += jet.pt;
+        mhtX -= jet.pt * std::cos(jet.phi);
+        mhtY -= jet.pt * std::sin(jet.phi);
+      }
+    }
+
+    ret.values.nJets = htJets.size();
+    ret.values.ht = ht;
+    ret.values.mhtX = mhtX;
+    ret.values.mhtY = mhtY;
+
+    if (htJets.size() >= 2) {
+      std::stable_sort(htJets.begin(), htJets.end(), [&jets](auto const idx1, auto const idx2) {
+        return jets[idx1].pt > jets[idx2].pt;
+      });
+
+      double px{0}, py{0}, pz{0}, energy{0};
+      for (auto const idx : {htJets[0], htJets[1]}) {
+        auto const& jet = jets[idx];
+        px += jet.pt * std::cos(double(jet.phi));
+        py += jet.pt * std::sin(double(jet.phi));
+        pz += jet.pt * std::sinh(double(jet.eta));
+        energy += std::sqrt(double(jet.mass) * jet.mass + std::pow(jet.pt * std::cosh(double(jet.eta)), 2));
+      }
+
+      auto const& lead1 = jets[htJets[0]];
+      auto const& lead2 = jets[htJets[1]];
+      ret.values.mjj = std::sqrt(std::max(0., energy * energy - px * px - py * py - pz * pz));
+      ret.values.dEtajj = std::abs(double(lead1.eta) - lead2.eta);
+      ret.values.dPhijj = std::abs(std::remainder(double(lead1.phi) - lead2.phi, 2 * M_PI));
+    }
+
+    return ret;
+  }
+
+}  // namespace
+
+int main() {
+  JetTopologyCalculator::Selection const htSelection{30, -1, 2.4};
+  std::vector<JetTopologyCalculator::Selection> const countSelections{
+      {20, -1, -1}, {30, -1, 2.4}, {30, 3., -1}, {50, 1.5, 3.}};
+  JetTopologyCalculator const calculator{htSelection, countSelections};
+
+  // mjj: difference relative to max(mjj, 1 GeV); delta-eta, delta-phi: absolute difference
+  double const maxRelDiffMjjAllowed = 1e-4;
+  double const maxDiffAngleAllowed = 1e-5;
+
+  std::string const delimiter = "================================================";
+
+  std::vector<std::vector<Jet>> bxs{
+      // leading pair across phi = +-pi (|delta-phi| = 0.0832), and massless jets back-to-back at eta = 0 (mjj = 200)
+      {{80.f, 0.5f, 3.1f, 5.f}, {20.f, 0.f, 0.f, 0.f}, {60.f, -1.2f, -3.1f, 8.f}},
+      {{100.f, 0.f, 0.5f, 0.f}, {100.f, 0.f, 0.5f - float(M_PI), 0.f}},
+      // leading pair at phi = +pi and phi = -pi (|delta-phi| = 0)
+      {{45.f, 1.f, float(M_PI), 4.f}, {40.f, -1.f, -float(M_PI), 4.f}},
+      // equal pT (the first jet in input order leads), and jets outside the HT selection with higher pT
+      {{200.f, 3.5f, 0.f, 10.f},
+       {50.f, 0.1f, -2.9f, 6.f},
+       {50.f, -2.f, 2.9f, 7.f},
+       {50.f, 2.3f, 0.3f, 3.f},
+       {300.f, -2.6f, 1.f, 20.f}},
+      // one HT jet, and no jets
+      {{35.f, 0.2f, -0.4f, 4.f}, {25.f, 0.1f, 1.7f, 2.f}},
+      {},
+  };
+
+  std::mt19937 rng{20251017};
+  std::uniform_int_distribution<int> nJetsDist{0, 12};
+  std::uniform_real_distribution<float> ptDist{0, 250};
+  std::uniform_real_distribution<float> etaDist{-5, 5};
+  std::uniform_real_distribution<float> phiDist{-float(M_PI), float(M_PI)};
+  std::uniform_real_distribution<float> phiEdgeDist{float(M_PI) - 0.2f, float(M_PI)};
+  std::uniform_real_distribution<float> massDist{0, 30};
+  for (auto ibx = 0; ibx < 20000; ++ibx) {
+    auto& jets = bxs.emplace_back(nJetsDist(rng));
+    bool const phiEdge = (ibx % 4 == 0);
+    for (auto& jet : jets) {
+      jet.pt = std::round(2 * ptDist(rng)) / 2;
+      jet.eta = etaDist(rng);
+      jet.phi = phiEdge ? (rng() % 2 ? 1 : -1) * phiEdgeDist(rng) : phiDist(rng);
+      jet.mass = massDist(rng);
+    }
+  }
+
+  unsigned long nDifferent{0};
+  unsigned long nPairs{0};
+  double maxRelDiffMjj{0};
+  double maxDiffDEta{0};
+  double maxDiffDPhi{0};
+
+  std::vector<float> pts, etas, phis, masses;
+  std::vector<int> counts(calculator.nCounts());
+
+  for (auto const& jets : bxs) {
+    pts.clear();
+    etas.clear();
+    phis.clear();
+    masses.clear();
+    for (auto const& jet : jets) {
+      pts.emplace_back(jet.pt);
+      etas.emplace_back(jet.eta);
+      phis.emplace_back(jet.phi);
+      masses.emplace_back(jet.mass);
+    }
+
+    auto const values = calculator.compute(pts, etas, phis, masses, counts);
+    auto const ref = reference(jets, htSelection, countSelections);
+
+    // nJets, HT, missing-HT vector and jet counts: same sums in the same order
+    if (values.nJets != ref.values.nJets or values.ht != ref.values.ht or values.mhtX != ref.values.mhtX or
+        values.mhtY != ref.values.mhtY or counts != ref.counts) {
+      ++nDifferent;
+    }
+
+    if (ref.values.nJets < 2) {
+      if (values.mjj != 0 or values.dEtajj != 0 or values.dPhijj != 0) {
+        ++nDifferent;
+      }
+      continue;
+    }
+
+    ++nPairs;
+    maxRelDiffMjj =
+        std::max(maxRelDiffMjj, std::abs(double(values.mjj) - ref.values.mjj) / std::max(ref.values.mjj, 1.f));
+    maxDiffDEta = std::max(maxDiffDEta, std::abs(double(values.dEtajj) - ref.values.dEtajj));
+    maxDiffDPhi = std::max(maxDiffDPhi, std::abs(double(values.dPhijj) - ref.values.dPhijj));
+  }
+
+  bool const success = (nDifferent == 0 and maxRelDiffMjj <= maxRelDiffMjjAllowed and
+                        maxDiffDEta <= maxDiffAngleAllowed and maxDiffDPhi <= maxDiffAngleAllowed);
+
+  std::cout << "BXs = " << bxs.size() << ", BXs with a leading pair = " << nPairs
+            << ", BXs with different nJets/HT/MHT/counts = " << nDifferent << std::endl;
+  std::cout << "max relative difference of mjj = " << maxRelDiffMjj
+            << ", max difference of |delta-eta| = " << maxDiffDEta << ", max difference of |delta-phi| = " << maxDiffDPhi
+            << std::endl;
+  std::cout << delimiter << std::endl;
+
+  std::cout << (success ? "SUCCESS" : "FAILURE") << " (max relative difference of mjj allowed: "
+            << maxRelDiffMjjAllowed << ", max difference of |delta-eta| and |delta-phi| allowed: "
+            << maxDiffAngleAllowed << ")" << std::endl;
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerJetClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/LatticeAntiKtClustering.h"
+
+#include "fastjet/ClusterSequence.hh"
+#include "fastjet/JetDefinition.hh"
+#include "fastjet/PseudoJet.hh"
+
+// Exactness of LatticeAntiKtClustering: jets of every BX vs fastjet::ClusterSequence (same inputs, jet selection and
+// order as the FastJet backend of L1TCaloTowerAKJetProducer), required to be identical jet by jet (px, py, pz and E).
+// BX samples:
+//  - ties: towers with equal hwPt at symmetric positions around seeds (equal distances and equal d_ij),
+//    and blocks of towers with equal hwPt,
+//  - real-like: PU-like towers (multiplicity from a Gaussian distribution, hwPt from an exponential distribution)
+//    with hard jets spread over the neighbouring towers, at most one tower per (hwEta, hwPhi) cell,
+//    with a low and a high tower multiplicity.
+// BXs with an ambiguous recombination are clustered with FastJet by LatticeAntiKtClustering; the number of BXs
+// clustered on the lattice is reported, and must not be zero for the low-multiplicity BXs. The jets of the BXs
+// clustered on the lattice must also be identical to the ones of FastJet with the towers in reverse order
+// (i.e. they do not depend on how FastJet resolves ties).
+namespace {
+
+  struct Tower {
+    int hwPt;
+    int hwEta;
+    int hwPhi;
+  };
+
+  struct Sample {
+    std::string label;
+    std::vector<std::vector<Tower>> bxs;
+    bool latticeBXsRequired;
+  };
+
+  using Jets = std::vector<LatticeAntiKtClustering::Jet>;
+
+  // same as the FastJet backend of L1TCaloTowerAKJetProducer
+  Jets fastJetJets(std::vector<Tower> const& towers, fastjet::JetDefinition const& jetDefinition, double const ptMin) {
+    auto const& lut = CaloTowerLUT::get();
+
+    std::vector<fastjet::PseudoJet> fjInputs;
+    fjInputs.reserve(towers.size());
+    for (auto const& tower : towers) {
+      fjInputs.emplace_back(caloTowerJetClustering::fastJetInput(lut, tower.hwPt, tower.hwEta, tower.hwPhi));
+    }
+
+    auto const fjClusterSeq = fastjet::ClusterSequence{fjInputs, jetDefinition};
+
+    Jets ret;
+    caloTowerJetClustering::inclusiveJets(fjClusterSeq, ptMin, ret);
+    return ret;
+  }
+
+  bool identical(Jets const& jets1, Jets const& jets2) {
+    return std::equal(jets1.begin(), jets1.end(), jets2.begin(), jets2.end(), [](auto const& j1, auto const& j2) {
+      return j1.px == j2.px and j1.py == j2.py and j1.pz == j2.pz and j1.E == j2.E;
+    });
+  }
+
+  // valid (hwEta, hwPhi) cells of the lattice
+  std::vector<Tower> latticeCells() {
+    auto const& lut = CaloTowerLUT::get();
+
+    std::vector<Tower> cells;
+    for (auto hwEta = CaloTowerLUT::kHwEtaMin; hwEta <= CaloTowerLUT::kHwEtaMax; ++hwEta) {
+      for (auto hwPhi = CaloTowerLUT::kHwPhiMin; hwPhi <= CaloTowerLUT::kHwPhiMax; ++hwPhi) {
+        if (lut.validHwEta(hwEta) and lut.validHwPhi(hwPhi)) {
+          cells.emplace_back(Tower{0, hwEta, hwPhi});
+        }
+      }
+    }
+    return cells;
+  }
+
+  // towers of one BX from a map of hwPt values (index: cell index), in random order
+  std::vector<Tower> towersFromMap(std::vector<Tower> const& cells, std::vector<int> const& hwPts, std::mt19937& gen) {
+    std::vector<Tower> ret;
+    for (auto icell = 0u; icell < cells.size(); ++icell) {
+      if (hwPts[icell] > 0) {
+        ret.emplace_back(Tower{std::min(hwPts[icell], CaloTowerLUT::kHwPtMax), cells[icell].hwEta, cells[icell].hwPhi});
+      }
+    }
+    std::shuffle(ret.begin(), ret.end(), gen);
+    return ret;
+  }
+
+  // index of the cell (hwEta, hwPhi) in the cells of latticeCells(), or -1 if the cell is not valid
+  int cellIndex(std::vector<Tower> const& cells, int const hwEta, int const hwPhi) {
+    auto const it = std::find_if(
+        cells.begin(), cells.end(), [=](auto const& cell) { return cell.hwEta == hwEta and cell.hwPhi == hwPhi; });
+    return (it == cells.end()) ? -1 : int(it - cells.begin());
+  }
+
+  // hwPhi after a shift of dPhi cells (hwPhi in [1, 72])
+  int shiftedHwPhi(int const hwPhi, int const dPhi) { return (hwPhi - 1 + dPhi + 72 * 4) % 72 + 1; }
+
+  Sample tieSample(std::vector<Tower> const& cells, unsigned int const nBXs, std::mt19937& gen) {
+    Sample ret{"ties", {}, false};
+
+    std::uniform_int_distribution<int> hwEtaDistrib{-36, 36};
+    std::uniform_int_distribution<int> hwPhiDistrib{1, 72};
+    std::uniform_int_distribution<int> nSeedsDistrib{1, 6};
+    std::uniform_int_distribution<int> seedHwPtDistrib{20, 400};
+    std::uniform_int_distribution<int> ringHwPtDistrib{1, 12};
+    std::uniform_int_distribution<int> sizeDistrib{1, 4};
+
+    std::vector<int> hwPts(cells.size());
+    for (auto ibx = 0u; ibx < nBXs; ++ibx) {
+      std::fill(hwPts.begin(), hwPts.end(), 0);
+
+      auto const setHwPt = [&](int const hwEta, int const hwPhi, int const hwPt) {
+        auto const icell = cellIndex(cells, hwEta, hwPhi);
+        if (icell >= 0) {
+          hwPts[icell] = hwPt;
+        }
+      };
+
+      auto const nSeeds = nSeedsDistrib(gen);
+      for (auto iseed = 0; iseed < nSeeds; ++iseed) {
+        auto const hwEta = hwEtaDistrib(gen);
+        auto const hwPhi = hwPhiDistrib(gen);
+        auto const size = sizeDistrib(gen);
+
+        if (iseed % 2 == 0) {
+          // seed with rings of towers of equal hwPt (one hwPt per ring)
+          for (auto ring = size; ring >= 1; --ring) {
+            auto const ringHwPt = ringHwPtDistrib(gen);
+            for (auto dEta = -ring; dEta <= ring; ++dEta) {
+              for (auto dPhi = -ring; dPhi <= ring; ++dPhi) {
+                if (std::max(std::abs(dEta), std::abs(dPhi)) == ring) {
+                  setHwPt(hwEta + dEta, shiftedHwPhi(hwPhi, dPhi), ringHwPt);
+                }
+              }
+            }
+          }
+          setHwPt(hwEta, hwPhi, seedHwPtDistrib(gen));
+        } else {
+          // block of towers with the same hwPt
+          auto const blockHwPt = ringHwPtDistrib(gen);
+          for (auto dEta = 0; dEta <= size; ++dEta) {
+            for (auto dPhi = 0; dPhi <= size; ++dPhi) {
+              setHwPt(hwEta + dEta, shiftedHwPhi(hwPhi, dPhi), blockHwPt);
+            }
+          }
+        }
+      }
+
+      ret.bxs.emplace_back(towersFromMap(cells, hwPts, gen));
+    }
+
+    return ret;
+  }
+
+  Sample realLikeSample(std::string const& label,
+                        double const nTowersMean,
+                        bool const latticeBXsRequired,
+                        std::vector<Tower> const& cells,
+                        unsigned int const nBXs,
+                        std::mt19937& gen) {
+    Sample ret{label, {}, latticeBXsRequired};
+
+    // PU-like towers (the high multiplicity is a rough approximation of the one observed in ZeroBias data)
+    std::normal_distribution nTowersDistrib{nTowersMean, 0.4 * nTowersMean};
+    std::exponential_distribution hwPtDistrib{0.5};
+
+    // hard jets: pT from a falling spectrum, energy shared among the towers around the jet axis
+    std::uniform_int_distribution<int> nJetsDistrib{0, 4};
+    std::exponential_distribution jetHwPtDistrib{1. / 80.};
+    std::uniform_int_distribution<int> hwEtaDistrib{-40, 40};
+    std::uniform_int_distribution<int> hwPhiDistrib{1, 72};
+    std::uniform_real_distribution<double> shareDistrib{0.5, 1.5};
+
+    std::vector<int> hwPts(cells.size());
+    std::vector<unsigned int> cellIndices(cells.size());
+    for (auto icell = 0u; icell < cells.size(); ++icell) {
+      cellIndices[icell] = icell;
+    }
+
+    for (auto ibx = 0u; ibx < nBXs; ++ibx) {
+      std::fill(hwPts.begin(), hwPts.end(), 0);
+
+      auto const nTowers = std::min(long(cells.size()), std::max(1l, std::lround(nTowersDistrib(gen))));
+      std::shuffle(cellIndices.begin(), cellIndices.end(), gen);
+      for (auto itow = 0; itow < nTowers; ++itow) {
+        hwPts[cellIndices[itow]] = 1 + std::lround(hwPtDistrib(gen));
+      }
+
+      auto const nJets = nJetsDistrib(gen);
+      for (auto ijet = 0; ijet < nJets; ++ijet) {
+        auto const jetHwPt = 40. + jetHwPtDistrib(gen);
+        auto const hwEta = hwEtaDistrib(gen);
+        auto const hwPhi = hwPhiDistrib(gen);
+        for (auto dEta = -2; dEta <= 2; ++dEta) {
+          for (auto dPhi = -2; dPhi <= 2; ++dPhi) {
+            auto const icell = cellIndex(cells, hwEta + dEta, shiftedHwPhi(hwPhi, dPhi));
+            if (icell < 0) {
+              continue;
+            }
+            auto const weight = std::exp(-double(dEta * dEta + dPhi * dPhi)) * shareDistrib(gen);
+            hwPts[icell] += std::lround(0.4 * jetHwPt * weight);
+          }
+        }
+      }
+
+      ret.bxs.emplace_back(towersFromMap(cells, hwPts, gen));
+    }
+
+    return ret;
+  }
+
+}  // namespace
+
+int main() {
+  unsigned int const nBXsPerSample = 1000;
+
+  std::string const delimiter = "================================================";
+
+  std::mt19937 gen(20251017);
+  auto const cells = latticeCells();
+
+  std::vector<Sample> const samples{tieSample(cells, nBXsPerSample, gen),
+                                    realLikeSample("real-like, low multiplicity", 150., true, cells, nBXsPerSample, gen),
+                                    realLikeSample("real-like, high multiplicity", 1500., false, cells, nBXsPerSample, gen)};
+
+  bool success{true};
+  unsigned int test_idx = 0;
+
+  for (auto const rParam : {0.4, 0.8}) {
+    fastjet::JetDefinition const fjJetDefinition{fastjet::antikt_algorithm, rParam};
+    LatticeAntiKtClustering clustering{rParam};
+
+    for (auto const ptMin : {0., 20.}) {
+      for (auto const& sample : samples) {
+        unsigned int nLatticeBXs{0};
+        unsigned int nDifferentBXs{0};
+
+        for (auto const& towers : sample.bxs) {
+          clustering.clear();
+          for (auto const& tower : towers) {
+            clustering.addTower(tower.hwPt, tower.hwEta, tower.hwPhi);
+          }
+          auto const onLattice = clustering.run();
+          nLatticeBXs += onLattice;
+
+          auto const& jets = clustering.inclusiveJets(ptMin);
+          if (not identical(jets, fastJetJets(towers, fjJetDefinition, ptMin))) {
+            ++nDifferentBXs;
+          } else if (onLattice and not identical(jets,
+                                                 fastJetJets(std::vector<Tower>(towers.rbegin(), towers.rend()),
+                                                             fjJetDefinition,
+                                                             ptMin))) {
+            ++nDifferentBXs;
+          }
+        }
+
+        // the comparison must not reduce to FastJet vs FastJet
+        auto const testSuccess = (nDifferentBXs == 0 and (not sample.latticeBXsRequired or nLatticeBXs > 0));
+        success &= testSuccess;
+
+        std::cout << "Test #" << ++test_idx << " (" << sample.label << ", R = " << rParam << ", ptMin = " << ptMin
+                  << "): BXs = " << sample.bxs.size() << ", clustered on the lattice = " << nLatticeBXs
+                  << ", with jets different from FastJet = " << nDifferentBXs << " -> "
+                  << (testSuccess ? "SUCCESS" : "FAILURE") << std::endl;
+      }
+    }
+  }
+
+  std::cout << delimiter << std::endl;
+  std::cout << (success ? "SUCCESS" : "FAILURE") << std::endl;
+
+  return success ? 0 : 1;
+}
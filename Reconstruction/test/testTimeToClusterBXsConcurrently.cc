@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+
+#include "L1ScoutingTools/Reconstruction/interface/LatticeAntiKtClustering.h"
+#include "L1TriggerScouting/Utilities/interface/conversion.h"
+
+struct Tower {
+  int hwPt;
+  int hwEta;
+  int hwPhi;
+};
+
+using Jets = std::vector<LatticeAntiKtClustering::Jet>;
+
+// same per-BX steps as L1TCaloTowerAKJetProducer (Lattice backend)
+void clusterBX(std::vector<Tower> const& towers, LatticeAntiKtClustering& clustering, Jets& jets) {
+  clustering.clear();
+  for (auto const& tower : towers) {
+    clustering.addTower(tower.hwPt, tower.hwEta, tower.hwPhi);
+  }
+  clustering.run();
+  auto const& outJets = clustering.inclusiveJets(0.);
+  jets.assign(outJets.begin(), outJets.end());
+}
+
+bool identical(std::vector<Jets> const& jets1, std::vector<Jets> const& jets2) {
+  return std::equal(jets1.begin(), jets1.end(), jets2.begin(), jets2.end(), [](auto const& bx1, auto const& bx2) {
+    return std::equal(bx1.begin(), bx1.end(), bx2.begin(), bx2.end(), [](auto const& j1, auto const& j2) {
+      return j1.px == j2.px and j1.py == j2.py and j1.pz == j2.pz and j1.E == j2.E;
+    });
+  });
+}
+
+int main() {
+  unsigned int const nOrbits = 1;
+  unsigned int const nBXsPerOrbit = 3564;
+  unsigned int const nBXs = nOrbits * nBXsPerOrbit;
+  double const rParam = 0.4;
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nOrbits = " << nOrbits << ", nBXs = " << nBXs << ", R = " << rParam << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // Number of CaloTowers for every BX.
+  //  - Using here as rough approximation a Gaussian distribution,
+  //    based on the CaloTowers' multiplicity observed in 2025 ZeroBias data.
+  //  - Towers sit on distinct (hwEta, hwPhi) cells, with hwPt from an exponential distribution.
+  std::mt19937 gen(12345);
+  std::normal_distribution nTowersDistrib{1500., 600.};
+  std::exponential_distribution hwPtDistrib{0.2};
+
+  std::vector<Tower> cells;
+  for (auto hwEta = -128; hwEta < 128; ++hwEta) {
+    for (auto hwPhi = 0; hwPhi < 256; ++hwPhi) {
+      if (l1ScoutingRun3::calol1::validHwEta(hwEta) and l1ScoutingRun3::calol1::validHwPhi(hwPhi)) {
+        cells.emplace_back(Tower{0, hwEta, hwPhi});
+      }
+    }
+  }
+
+  std::vector<std::vector<Tower>> towers(nBXs);
+  for (auto& bxTowers : towers) {
+    auto const nTowers = std::min(long(cells.size()), std::max(1l, std::lround(nTowersDistrib(gen))));
+    std::shuffle(cells.begin(), cells.end(), gen);
+    bxTowers.assign(cells.begin(), cells.begin() + nTowers);
+    for (auto& tower : bxTowers) {
+      tower.hwPt = std::min(511l, 1l + std::lround(hwPtDistrib(gen)));
+    }
+  }
+
+  std::cout << "Generated CaloTowers for " << nBXs << " BXs" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  //
+  // Test #1: serial clustering (reference)
+  //
+  ++test_idx;
+  std::vector<Jets> refJets(nBXs);
+  {
+    LatticeAntiKtClustering clustering{rParam};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto ibx = 0u; ibx < nBXs; ++ibx) {
+      clusterBX(towers[ibx], clustering, refJets[ibx]);
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (serial): " << duration.count() << " sec" << std::endl;
+    std::cout << delimiter << std::endl;
+  }
+
+  //
+  // Test #2-#6: concurrent clustering with 1, 2, 4, 8, 16 threads
+  //
+  for (auto const nThreads : {1, 2, 4, 8, 16}) {
+    ++test_idx;
+
+    tbb::global_control control{tbb::global_control::max_allowed_parallelism, std::size_t(nThreads)};
+
+    tbb::enumerable_thread_specific<LatticeAntiKtClustering> clusterings{rParam};
+    std::vector<Jets> jets(nBXs);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nBXs), [&](tbb::blocked_range<unsigned int> const& range) {
+      auto& clustering = clusterings.local();
+      for (auto ibx = range.begin(); ibx != range.end(); ++ibx) {
+        clusterBX(towers[ibx], clustering, jets[ibx]);
+      }
+    });
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (threads=" << nThreads << "): " << duration.count()
+              << " sec, identical to serial: " << identical(jets, refJets) << std::endl;
+    std::cout << delimiter << std::endl;
+  }
+
+  return 0;
+}
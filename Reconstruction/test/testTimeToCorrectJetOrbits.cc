@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/FileInPath.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+
+// jets of one orbit in contiguous arrays, with per-BX offsets
+struct OrbitJets {
+  std::vector<float> pt;
+  std::vector<float> eta;
+  std::vector<unsigned int> bxOffsets;
+  int puProxy;
+};
+
+int main() {
+  unsigned int const nOrbits = 100;
+  unsigned int const nBXs = 3564;
+  double const nJetsPerOrbit = 10000.;
+  unsigned int const nRepetitions = 5;
+
+  std::string const jecFile =
+      edm::FileInPath("L1ScoutingTools/Reconstruction/data/JEC_AK4CaloTowerL1S_Run3Winter25_v2.txt").fullPath();
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nOrbits = " << nOrbits << ", nJetsPerOrbit ~ " << nJetsPerOrbit << ", nRepetitions = " << nRepetitions
+            << ", JEC file = " << jecFile << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // orbits: ~10k jets spread over the BXs, falling pT spectrum, uniform in eta, one PU proxy per orbit
+  std::mt19937 gen(12345);
+  std::poisson_distribution nJetsDistrib{nJetsPerOrbit / nBXs};
+  std::exponential_distribution ptDistrib{0.05};
+  std::uniform_real_distribution etaDistrib{-5.2f, 5.2f};
+  std::normal_distribution puProxyDistrib{60., 20.};
+
+  std::vector<OrbitJets> orbits(nOrbits);
+  unsigned long nJetsTotal{0};
+  for (auto& orbit : orbits) {
+    orbit.puProxy = std::max(0, int(std::lround(puProxyDistrib(gen))));
+    orbit.bxOffsets.reserve(nBXs + 1);
+    orbit.bxOffsets.emplace_back(0);
+    for (auto bx = 0u; bx < nBXs; ++bx) {
+      auto const nJets = nJetsDistrib(gen);
+      for (auto ijet = 0; ijet < nJets; ++ijet) {
+        orbit.pt.emplace_back(1. + ptDistrib(gen));
+        orbit.eta.emplace_back(etaDistrib(gen));
+      }
+      orbit.bxOffsets.emplace_back(orbit.pt.size());
+    }
+    nJetsTotal += orbit.pt.size();
+  }
+
+  std::cout << "Generated " << nJetsTotal << " jets" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  JetCorrector const jetCorrector{jecFile, JetCorrector::FormulaType::CorrectedPt};
+
+  // buffers of the batch interface, re-used across batches and orbits
+  JetCorrector::Workspace workspace;
+
+  std::vector<std::vector<double>> refCorrections(nOrbits);
+  std::vector<std::vector<double>> corrections(nOrbits);
+  for (auto iorb = 0u; iorb < nOrbits; ++iorb) {
+    refCorrections[iorb].resize(orbits[iorb].pt.size());
+    corrections[iorb].resize(orbits[iorb].pt.size());
+  }
+
+  auto const run = [&](auto const& correctOrbit, std::vector<std::vector<double>>& corrs, std::string const& label) {
+    ++test_idx;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto irep = 0u; irep < nRepetitions; ++irep) {
+      for (auto iorb = 0u; iorb < nOrbits; ++iorb) {
+        correctOrbit(orbits[iorb], corrs[iorb]);
+      }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e6 * duration.count() / (nRepetitions * nOrbits) << " us per orbit, "
+              << 1e-6 * nRepetitions * nJetsTotal / duration.count() << " M corrections/sec)" << std::endl;
+  };
+
+  auto const compare = [&]() {
+    unsigned long nDifferent{0};
+    for (auto iorb = 0u; iorb < nOrbits; ++iorb) {
+      for (auto ijet = 0u; ijet < corrections[iorb].size(); ++ijet) {
+        nDifferent += (corrections[iorb][ijet] != refCorrections[iorb][ijet]);
+      }
+    }
+    std::cout << "Jets with a correction different from Test #1: " << nDifferent << std::endl;
+    std::cout << delimiter << std::endl;
+  };
+
+  //
+  // Test #1: one call to JetCorrector::correction per jet
+  //
+  run(
+      [&](OrbitJets const& orbit, std::vector<double>& corrs) {
+        for (auto ijet = 0u; ijet < orbit.pt.size(); ++ijet) {
+          corrs[ijet] = jetCorrector.correction(orbit.pt[ijet], orbit.eta[ijet], orbit.puProxy);
+        }
+      },
+      refCorrections,
+      "JetCorrector::correction, one call per jet");
+  std::cout << delimiter << std::endl;
+
+  //
+  // Test #2: one batch per BX
+  //
+  run(
+      [&](OrbitJets const& orbit, std::vector<double>& corrs) {
+        for (auto bx = 0u; bx < nBXs; ++bx) {
+          auto const first = orbit.bxOffsets[bx];
+          auto const nJets = orbit.bxOffsets[bx + 1] - first;
+          jetCorrector.corrections({orbit.pt.data() + first, nJets},
+                                   {orbit.eta.data() + first, nJets},
+                                   orbit.puProxy,
+                                   {corrs.data() + first, nJets},
+                                   workspace);
+        }
+      },
+      corrections,
+      "JetCorrector::corrections, one batch per BX");
+  compare();
+
+  //
+  // Test #3: one batch per orbit
+  //
+  run([&](OrbitJets const& orbit, std::vector<double>& corrs) {
+    jetCorrector.corrections(orbit.pt, orbit.eta, orbit.puProxy, corrs, workspace);
+  },
+      corrections,
+      "JetCorrector::corrections, one batch per orbit");
+  compare();
+
+  //
+  // Test #4: one batch per orbit, corrections from interpolation tables (evaluated bin by bin without calls to
+  // the math functions); the corrections differ from Test #1 within the tabulation tolerance
+  //
+  JetCorrector const tabulatedJetCorrector{jecFile, JetCorrector::FormulaType::CorrectedPt, true, 1e-4};
+  run([&](OrbitJets const& orbit, std::vector<double>& corrs) {
+    tabulatedJetCorrector.corrections(orbit.pt, orbit.eta, orbit.puProxy, corrs, workspace);
+  },
+      corrections,
+      "JetCorrector::corrections with interpolation tables, one batch per orbit");
+  std::cout << delimiter << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CommonTools/Utils/interface/FormulaEvaluator.h"
+#include "FWCore/Utilities/interface/FileInPath.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+
+// JetCorrector of L1TCaloTowerJetCorrectorC before the indexing of the bins (linear scan over all bins)
+class LinearScanJetCorrector {
+public:
+  explicit LinearScanJetCorrector(std::string const& filePath) {
+    std::ifstream infile(filePath);
+    std::string line{};
+    while (std::getline(infile, line)) {
+      std::istringstream iss(line);
+
+      Entry entry{0.f, 0.f, 0.f, 0.f, 0, 0, reco::FormulaEvaluator{"0"}, {}};
+      std::string formEvalStr{""};
+      int formNParams{0};
+      iss >> entry.ptMin >> entry.ptMax >> entry.etaMin >> entry.etaMax >> entry.puProxyMin >> entry.puProxyMax >>
+          formEvalStr >> formNParams;
+
+      entry.formulaEvaluator = reco::FormulaEvaluator{formEvalStr};
+      entry.formulaParameters.resize(formNParams);
+      for (auto& param : entry.formulaParameters) {
+        iss >> param;
+      }
+
+      data_.emplace_back(std::move(entry));
+    }
+  }
+
+  double correction(float const pt, float const eta, int const puProxy) const {
+    for (auto const& entry : data_) {
+      if (eta >= entry.etaMin and eta < entry.etaMax and (entry.puProxyMin < 0 or puProxy >= entry.puProxyMin) and
+          (entry.puProxyMax < 0 or puProxy < entry.puProxyMax)) {
+        std::vector<double> vars{std::clamp(pt, entry.ptMin, entry.ptMax)};
+        return (entry.formulaEvaluator.evaluate(vars, entry.formulaParameters) / vars[0]);
+      }
+    }
+    return 0;
+  }
+
+private:
+  struct Entry {
+    float ptMin;
+    float ptMax;
+    float etaMin;
+    float etaMax;
+    int puProxyMin;
+    int puProxyMax;
+    reco::FormulaEvaluator formulaEvaluator;
+    std::vector<double> formulaParameters;
+  };
+
+  std::vector<Entry> data_;
+};
+
+struct Jet {
+  float pt;
+  float eta;
+  int puProxy;
+};
+
+int main() {
+  unsigned int const nJets = 1000000;
+
+  std::string const jecFile =
+      edm::FileInPath("L1ScoutingTools/Reconstruction/data/JEC_AK4CaloTowerL1S_Run3Winter25_v2.txt").fullPath();
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nJets = " << nJets << ", JEC file = " << jecFile << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // jets: falling pT spectrum, uniform in eta (including values outside the JEC bins), PU proxy as in 2025 data
+  std::mt19937 gen(12345);
+  std::exponential_distribution ptDistrib{0.05};
+  std::uniform_real_distribution etaDistrib{-5.2f, 5.2f};
+  std::normal_distribution puProxyDistrib{60., 20.};
+
+  std::vector<Jet> jets;
+  jets.reserve(nJets);
+  for (auto ijet = 0u; ijet < nJets; ++ijet) {
+    jets.emplace_back(
+        Jet{float(1. + ptDistrib(gen)), etaDistrib(gen), std::max(0, int(std::lround(puProxyDistrib(gen))))});
+  }
+
+  std::vector<double> corrections(nJets);
+  std::vector<double> refCorrections(nJets);
+
+  auto const run = [&](auto const& jetCorrector, std::vector<double>& corrs, std::string const& label) {
+    ++test_idx;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto ijet = 0u; ijet < nJets; ++ijet) {
+      corrs[ijet] = jetCorrector.correction(jets[ijet].pt, jets[ijet].eta, jets[ijet].puProxy);
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e-6 * nJets / duration.count() << " M corrections/sec)" << std::endl;
+  };
+
+  auto const compare = [&]() {
+    unsigned int nDifferent{0};
+    double maxRelDiff{0};
+    for (auto ijet = 0u; ijet < nJets; ++ijet) {
+      if (corrections[ijet] != refCorrections[ijet]) {
+        ++nDifferent;
+        maxRelDiff = std::max(maxRelDiff, std::abs(corrections[ijet] / refCorrections[ijet] - 1.));
+      }
+    }
+    std::cout << "Jets with a correction different from Test #1: " << nDifferent
+              << " (max relative difference: " << maxRelDiff << ")" << std::endl;
+    std::cout << delimiter << std::endl;
+  };
+
+  //
+  // Test #1: linear scan over the bins
+  //
+  {
+    LinearScanJetCorrector const jetCorrector{jecFile};
+    run(jetCorrector, refCorrections, "linear scan");
+    std::cout << delimiter << std::endl;
+  }
+
+  //
+  // Test #2: indexed bins, formulas evaluated with reco::FormulaEvaluator (JetCorrector without kernels)
+  //
+  {
+    JetCorrector const jetCorrector{jecFile, JetCorrector::FormulaType::CorrectedPt, false};
+    run(jetCorrector, corrections, "JetCorrector, " + std::to_string(jetCorrector.nBins()) + " bins in " +
+                                       std::to_string(jetCorrector.nEtaBins()) + " eta bins, FormulaEvaluator");
+    compare();
+  }
+
+  //
+  // Test #3: indexed bins, formulas evaluated with inline kernels (JetCorrector)
+  //
+  {
+    JetCorrector const jetCorrector{jecFile, JetCorrector::FormulaType::CorrectedPt};
+    run(jetCorrector,
+        corrections,
+        "JetCorrector, kernels for " + std::to_string(jetCorrector.nBins() - jetCorrector.nGenericBins()) + "/" +
+            std::to_string(jetCorrector.nBins()) + " bins");
+    compare();
+  }
+
+  //
+  // Test #4: indexed bins, corrections interpolated from tables (JetCorrector with tabulation)
+  //
+  for (auto const tolerance : {1e-3, 1e-4}) {
+    JetCorrector const jetCorrector{jecFile, JetCorrector::FormulaType::CorrectedPt, true, tolerance};
+    run(jetCorrector,
+        corrections,
+        "JetCorrector, tables with " + std::to_string(jetCorrector.tableSize()) +
+            " points, tolerance = " + std::to_string(tolerance) +
+            ", max deviation = " + std::to_string(jetCorrector.maxTabulationDeviation()));
+    compare();
+  }
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerWindowMasks.h"
+
+// CaloTower multiplicities in several (hwPt, |hwEta|) windows:
+// one L1TCaloTowerMultiplicityProducer per window (every module loops over all BXs, and rescans the towers),
+// vs L1TCaloTowerMultiWindowMultiplicityProducer (one pass over the towers of the requested BX, bitmasks of windows).
+struct Window {
+  std::string label;
+  int towerMinHwPt;
+  int towerMaxHwPt;
+  int towerMinAbsHwEta;
+  int towerMaxAbsHwEta;
+};
+
+// same as L1TCaloTowerMultiplicityProducer::produce
+int countOneWindow(l1t::CaloTowerBxCollection const& inputs, int const bunchCrossing, Window const& window) {
+  int ret_value{0};
+
+  for (auto bx = inputs.getFirstBX(); bx <= inputs.getLastBX(); ++bx) {
+    if (bx != bunchCrossing) {
+      continue;
+    }
+
+    auto const nInputs = inputs.size(bx);
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& input = inputs.at(bx, idx);
+      auto const absHwEta = std::abs(input.hwEta());
+      if ((window.towerMinHwPt < 0 or input.hwPt() >= window.towerMinHwPt) and
+          (window.towerMaxHwPt < 0 or input.hwPt() <= window.towerMaxHwPt) and
+          (window.towerMinAbsHwEta < 0 or absHwEta >= window.towerMinAbsHwEta) and
+          (window.towerMaxAbsHwEta < 0 or absHwEta <= window.towerMaxAbsHwEta)) {
+        ++ret_value;
+      }
+    }
+  }
+
+  return ret_value;
+}
+
+// same as L1TCaloTowerMultiWindowMultiplicityProducer
+class MultiWindowCounter {
+public:
+  explicit MultiWindowCounter(std::vector<Window> const& windows) : nWindows_(windows.size()) {
+    std::vector<CaloTowerWindowMasks::Window> edges;
+    for (auto const& window : windows) {
+      edges.emplace_back(CaloTowerWindowMasks::Window{
+          window.towerMinHwPt, window.towerMaxHwPt, window.towerMinAbsHwEta, window.towerMaxAbsHwEta});
+    }
+    windowMasks_ = CaloTowerWindowMasks{edges};
+  }
+
+  void count(l1t::CaloTowerBxCollection const& inputs, int const bunchCrossing, std::vector<int>& counts) const {
+    counts.assign(nWindows_, 0);
+
+    if (bunchCrossing < inputs.getFirstBX() or bunchCrossing > inputs.getLastBX()) {
+      return;
+    }
+
+    auto const nInputs = inputs.size(bunchCrossing);
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& input = inputs.at(bunchCrossing, idx);
+      for (auto mask = windowMasks_.mask(input.hwPt(), input.hwEta()); mask != 0; mask &= mask - 1) {
+        ++counts[std::countr_zero(mask)];
+      }
+    }
+  }
+
+private:
+  unsigned int nWindows_;
+  CaloTowerWindowMasks windowMasks_;
+};
+
+int main() {
+  unsigned int const nEvents = 2000;
+  int const bxMin = -2;
+  int const bxMax = 2;
+  int const bunchCrossing = 0;
+
+  std::vector<Window> const windows{
+      {"AbsIEta4", 1, -1, -1, 4},
+      {"Barrel", 1, -1, -1, 16},
+      {"Endcap", 1, -1, 17, 28},
+      {"HF", 1, -1, 30, -1},
+      {"HwPtGe2", 2, -1, -1, -1},
+      {"HwPtGe4", 4, -1, -1, -1},
+      {"HwPtGe8", 8, -1, -1, -1},
+      {"HwPtGe16", 16, -1, -1, -1},
+  };
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nEvents = " << nEvents << ", BXs = [" << bxMin << ", " << bxMax << "], nWindows = " << windows.size()
+            << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // CaloTowers for every BX: multiplicity from a Gaussian distribution, hwPt from an exponential distribution,
+  // hwEta uniform in [-41, 41] (without 0 and +-29)
+  std::mt19937 gen(12345);
+  std::normal_distribution nTowersDistrib{1500., 600.};
+  std::exponential_distribution hwPtDistrib{0.3};
+  std::uniform_int_distribution<int> hwEtaDistrib{-41, 41};
+  std::uniform_int_distribution<int> hwPhiDistrib{1, 72};
+
+  std::vector<l1t::CaloTowerBxCollection> events;
+  events.reserve(nEvents);
+
+  unsigned long nTowersTotal{0};
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    auto& evt = events.emplace_back(0, bxMin, bxMax);
+    for (auto bx = bxMin; bx <= bxMax; ++bx) {
+      auto const nTowers = std::max(0, int(nTowersDistrib(gen)));
+      nTowersTotal += nTowers;
+      for (auto itow = 0; itow < nTowers; ++itow) {
+        int hwEta{0};
+        while (hwEta == 0 or std::abs(hwEta) == 29) {
+          hwEta = hwEtaDistrib(gen);
+        }
+        int const hwPt = 1 + int(hwPtDistrib(gen));
+        evt.push_back(bx, l1t::CaloTower(l1t::CaloTower::LorentzVector(), 0., 0., hwPt, hwEta, hwPhiDistrib(gen), 0));
+      }
+    }
+  }
+
+  std::cout << "Generated " << nTowersTotal << " CaloTowers" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  std::vector<std::vector<int>> refCounts(nEvents, std::vector<int>(windows.size()));
+  std::vector<std::vector<int>> counts(nEvents);
+
+  auto const report = [&](auto const startTime, std::string const& label) {
+    auto const endTime = std::chrono::steady_clock::now();
+    auto const duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << ++test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e6 * duration.count() / nEvents << " us per event)" << std::endl;
+  };
+
+  //
+  // Test #1: one module per window
+  //
+  auto startTime = std::chrono::steady_clock::now();
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    for (auto iwin = 0u; iwin < windows.size(); ++iwin) {
+      refCounts[ievt][iwin] = countOneWindow(events[ievt], bunchCrossing, windows[iwin]);
+    }
+  }
+  report(startTime, std::to_string(windows.size()) + " modules, one per window");
+  std::cout << delimiter << std::endl;
+
+  //
+  // Test #2: one module for all windows
+  //
+  MultiWindowCounter const counter{windows};
+
+  startTime = std::chrono::steady_clock::now();
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    counter.count(events[ievt], bunchCrossing, counts[ievt]);
+  }
+  report(startTime, "one module, all windows in one pass");
+
+  unsigned long nDifferent{0};
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    nDifferent += (counts[ievt] != refCounts[ievt]);
+  }
+
+  std::cout << "Events with different multiplicities from Test #1: " << nDifferent << std::endl;
+  std::cout << delimiter << std::endl;
+
+  return (nDifferent == 0) ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DataFormats/L1Scouting/interface/OrbitCollection.h"
+#include "DataFormats/L1Trigger/interface/Jet.h"
+
+// Jet seeds evaluated on every BX of an orbit:
+// one selector per seed (every selector loops over all the jets of every BX),
+// vs L1TOrbitJetSeedsFilter (one pass over the jets of every BX for all seeds, with early exit).
+struct Seed {
+  std::string label;
+  int nMin;
+  double ptMin;
+  double absEtaMin;
+  double absEtaMax;
+
+  bool selected(double const pt, double const absEta) const {
+    return (absEtaMin < 0 or absEta > absEtaMin) and (absEtaMax < 0 or absEta < absEtaMax) and pt > ptMin;
+  }
+};
+
+using Mask = std::uint64_t;
+
+// one selector per seed: BXs in which the seed fired
+std::vector<unsigned> selectBxsOneSeed(OrbitCollection<l1t::Jet> const& jets, Seed const& seed) {
+  std::vector<unsigned> ret;
+  for (auto bx = 0u; bx <= unsigned(OrbitCollection<l1t::Jet>::NBX); ++bx) {
+    int nJets{0};
+    auto const nInputs = jets.getBxSize(bx);
+    for (auto idx = 0; idx < nInputs; ++idx) {
+      auto const& jet = jets.getBxObject(bx, idx);
+      nJets += seed.selected(jet.pt(), std::abs(jet.eta()));
+    }
+    if (nJets >= seed.nMin) {
+      ret.emplace_back(bx);
+    }
+  }
+  return ret;
+}
+
+// same as L1TOrbitJetSeedsFilter::firedSeeds
+Mask firedSeeds(OrbitCollection<l1t::Jet> const& jets,
+                unsigned int const bx,
+                std::vector<Seed> const& seeds,
+                int const nMinAllSeeds,
+                std::vector<int>& counts) {
+  int const nJets = jets.getBxSize(bx);
+  if (nJets < nMinAllSeeds) {
+    return 0;
+  }
+
+  Mask pending{0};
+  for (auto iseed = 0u; iseed < seeds.size(); ++iseed) {
+    if (seeds[iseed].nMin <= nJets) {
+      pending |= Mask(1) << iseed;
+      counts[iseed] = 0;
+    }
+  }
+
+  Mask fired{0};
+  for (auto idx = 0; idx < nJets and pending != 0; ++idx) {
+    auto const& jet = jets.getBxObject(bx, idx);
+    auto const pt = jet.pt();
+    auto const absEta = std::abs(jet.eta());
+
+    for (auto mask = pending; mask != 0; mask &= mask - 1) {
+      auto const iseed = std::countr_zero(mask);
+      auto const& seed = seeds[iseed];
+      if (seed.selected(pt, absEta)) {
+        if (++counts[iseed] >= seed.nMin) {
+          fired |= Mask(1) << iseed;
+          pending &= ~(Mask(1) << iseed);
+        }
+      } else if (seed.nMin - counts[iseed] > nJets - idx - 1) {
+        pending &= ~(Mask(1) << iseed);
+      }
+    }
+  }
+
+  return fired;
+}
+
+int main() {
+  unsigned int const nOrbits = 50;
+  unsigned int const nBXs = 3564;
+  double const nJetsPerOrbit = 30000.;
+
+  std::vector<Seed> const seeds{
+      {"DijetEt30", 2, 30., -1., -1.},
+      {"HMJetMult4Et20", 4, 20., -1., -1.},
+      {"SingleJetEt60", 1, 60., -1., -1.},
+      {"SingleJetForwardEt30", 1, 30., 3., -1.},
+      {"DijetCentralEt40", 2, 40., -1., 2.5},
+      {"HMJetMult6Et10", 6, 10., -1., -1.},
+  };
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nOrbits = " << nOrbits << ", nJetsPerOrbit ~ " << nJetsPerOrbit << ", nSeeds = " << seeds.size()
+            << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // orbits: jets spread over the BXs, falling pT spectrum, uniform in eta and phi
+  std::mt19937 gen(12345);
+  std::poisson_distribution nJetsDistrib{nJetsPerOrbit / nBXs};
+  std::exponential_distribution ptDistrib{0.1};
+  std::uniform_real_distribution etaDistrib{-5., 5.};
+  std::uniform_real_distribution phiDistrib{-M_PI, M_PI};
+
+  std::vector<OrbitCollection<l1t::Jet>> orbits;
+  orbits.reserve(nOrbits);
+
+  unsigned long nJetsTotal{0};
+  std::vector<std::vector<l1t::Jet>> orbitBuffer(OrbitCollection<l1t::Jet>::NBX + 1);
+  for (auto iorb = 0u; iorb < nOrbits; ++iorb) {
+    unsigned int nJetsOrbit{0};
+    for (auto bx = 1u; bx <= nBXs; ++bx) {
+      auto const nJets = nJetsDistrib(gen);
+      nJetsOrbit += nJets;
+      for (auto ijet = 0; ijet < nJets; ++ijet) {
+        auto const pt = 1. + ptDistrib(gen);
+        auto const eta = etaDistrib(gen);
+        auto const phi = phiDistrib(gen);
+        l1t::Jet::LorentzVector const p4{pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta), pt * std::cosh(eta)};
+        orbitBuffer[bx].emplace_back(p4);
+      }
+    }
+    orbits.emplace_back(orbitBuffer, nJetsOrbit);
+    nJetsTotal += nJetsOrbit;
+  }
+
+  std::cout << "Generated " << nJetsTotal << " jets" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  auto const report = [&](auto const startTime, std::string const& label) {
+    auto const endTime = std::chrono::steady_clock::now();
+    auto const duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << ++test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e3 * duration.count() / nOrbits << " ms per orbit)" << std::endl;
+  };
+
+  //
+  // Test #1: one selector per seed
+  //
+  std::vector<std::vector<std::vector<unsigned>>> refSeedBxs(nOrbits);
+
+  auto startTime = std::chrono::steady_clock::now();
+  for (auto iorb = 0u; iorb < nOrbits; ++iorb) {
+    for (auto const& seed : seeds) {
+      refSeedBxs[iorb].emplace_back(selectBxsOneSeed(orbits[iorb], seed));
+    }
+  }
+  report(startTime, std::to_string(seeds.size()) + " selectors, one per seed");
+  std::cout << delimiter << std::endl;
+
+  //
+  // Test #2: all seeds in one pass
+  //
+  int const nMinAllSeeds =
+      std::min_element(seeds.begin(), seeds.end(), [](auto const& a, auto const& b) { return a.nMin < b.nMin; })->nMin;
+
+  std::vector<std::vector<std::vector<unsigned>>> seedBxs(nOrbits);
+  std::vector<int> counts(seeds.size(), 0);
+  unsigned long nSelBxs{0};
+
+  startTime = std::chrono::steady_clock::now();
+  for (auto iorb = 0u; iorb < nOrbits; ++iorb) {
+    seedBxs[iorb].resize(seeds.size());
+    for (auto bx = 0u; bx <= unsigned(OrbitCollection<l1t::Jet>::NBX); ++bx) {
+      auto const fired = firedSeeds(orbits[iorb], bx, seeds, nMinAllSeeds, counts);
+      nSelBxs += (fired != 0);
+      for (auto mask = fired; mask != 0; mask &= mask - 1) {
+        seedBxs[iorb][std::countr_zero(mask)].emplace_back(bx);
+      }
+    }
+  }
+  report(startTime, "one pass for all seeds");
+
+  unsigned long nDifferent{0};
+  for (auto iorb = 0u; iorb < nOrbits; ++iorb) {
+    nDifferent += (seedBxs[iorb] != refSeedBxs[iorb]);
+  }
+
+  std::cout << "Selected BXs (any seed): " << nSelBxs << std::endl;
+  std::cout << "Orbits with different selected BXs from Test #1: " << nDifferent << std::endl;
+  std::cout << delimiter << std::endl;
+
+  return (nDifferent == 0) ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DataFormats/L1Trigger/interface/Jet.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetSoABxCollection.h"
+
+// same selection as L1TJetKinematicsFilter (single precision, for both layouts)
+struct Selection {
+  int bxMin;
+  int bxMax;
+  float ptMin;
+  float absEtaMax;
+
+  bool selected(float const pt, float const eta) const { return std::abs(eta) < absEtaMax and pt > ptMin; }
+};
+
+int countJets(l1t::JetBxCollection const& jets, Selection const& sel) {
+  int nJets{0};
+  for (auto bx = sel.bxMin; bx <= sel.bxMax; ++bx) {
+    auto const nInputs = jets.size(bx);
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& jet = jets.at(bx, idx);
+      nJets += sel.selected(jet.pt(), jet.eta());
+    }
+  }
+  return nJets;
+}
+
+int countJets(JetSoABxCollection const& jets, Selection const& sel) {
+  auto const pts = jets.pt(sel.bxMin, sel.bxMax);
+  auto const etas = jets.eta(sel.bxMin, sel.bxMax);
+
+  int nJets{0};
+  for (auto idx = 0u; idx < pts.size(); ++idx) {
+    nJets += sel.selected(pts[idx], etas[idx]);
+  }
+  return nJets;
+}
+
+int main() {
+  unsigned int const nEvents = 20000;
+  int const bxMin = -2;
+  int const bxMax = 2;
+  unsigned int const nRepetitions = 10;
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nEvents = " << nEvents << ", BXs = [" << bxMin << ", " << bxMax
+            << "], nRepetitions = " << nRepetitions << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // jets of every event in both layouts (AK4 CaloTower jets: ~40 jets per BX, falling pT spectrum)
+  std::mt19937 gen(12345);
+  std::poisson_distribution nJetsDistrib{40.};
+  std::exponential_distribution ptDistrib{0.1};
+  std::uniform_real_distribution etaDistrib{-5., 5.};
+  std::uniform_real_distribution phiDistrib{-M_PI, M_PI};
+
+  std::vector<l1t::JetBxCollection> aosJets;
+  std::vector<JetSoABxCollection> soaJets;
+  aosJets.reserve(nEvents);
+  soaJets.reserve(nEvents);
+
+  unsigned long nJetsTotal{0};
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    auto& aos = aosJets.emplace_back(0, bxMin, bxMax);
+    auto& soa = soaJets.emplace_back(bxMin, bxMax);
+
+    for (auto bx = bxMin; bx <= bxMax; ++bx) {
+      auto const nJets = nJetsDistrib(gen);
+      nJetsTotal += nJets;
+      for (auto ijet = 0; ijet < nJets; ++ijet) {
+        auto const pt = 1. + ptDistrib(gen);
+        auto const eta = etaDistrib(gen);
+        auto const phi = phiDistrib(gen);
+        l1t::Jet::LorentzVector const p4{pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta), pt * std::cosh(eta)};
+        aos.push_back(bx, l1t::Jet{p4});
+        soa.push_back(bx, p4.pt(), p4.eta(), p4.phi(), p4.mass());
+      }
+    }
+    soa.finalize();
+  }
+
+  std::cout << "Generated " << nJetsTotal << " jets" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // selections of the CaloTower-jet paths (see testCaloTowerJetFilters.sh)
+  std::vector<Selection> const selections{{0, 0, 20., 2.5}, {0, 0, 30., 2.5}, {0, 0, 40., 1.3}, {bxMin, bxMax, 30., 2.5}};
+
+  auto const run = [&](auto const& jets, std::string const& label) {
+    ++test_idx;
+
+    unsigned long nAccepted{0};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto irep = 0u; irep < nRepetitions; ++irep) {
+      for (auto const& evtJets : jets) {
+        for (auto const& sel : selections) {
+          nAccepted += (countJets(evtJets, sel) >= 2);
+        }
+      }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    auto const nFilterCalls = double(nRepetitions) * jets.size() * selections.size();
+    std::cout << "Test #" << test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e9 * duration.count() / nFilterCalls << " ns per filter call, accepted " << nAccepted << ")"
+              << std::endl;
+    std::cout << delimiter << std::endl;
+
+    return nAccepted;
+  };
+
+  //
+  // Test #1: l1t::JetBxCollection
+  //
+  auto const nAcceptedAoS = run(aosJets, "l1t::JetBxCollection");
+
+  //
+  // Test #2: JetSoABxCollection
+  //
+  auto const nAcceptedSoA = run(soaJets, "JetSoABxCollection");
+
+  // same decisions for both layouts
+  std::cout << "Accepted: l1t::JetBxCollection = " << nAcceptedAoS << ", JetSoABxCollection = " << nAcceptedSoA
+            << (nAcceptedAoS == nAcceptedSoA ? " -> SUCCESS" : " -> FAILURE") << std::endl;
+  std::cout << delimiter << std::endl;
+
+  return (nAcceptedAoS == nAcceptedSoA) ? 0 : 1;
+}
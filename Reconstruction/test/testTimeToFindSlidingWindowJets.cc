@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/LatticeAntiKtClustering.h"
+#include "L1ScoutingTools/Reconstruction/interface/SlidingWindowJetFinder.h"
+
+struct Tower {
+  int hwPt;
+  int hwEta;
+  int hwPhi;
+};
+
+struct Jet {
+  double pt;
+  double eta;
+  double phi;
+};
+
+template <class InputJet>
+Jet toJet(InputJet const& jet) {
+  auto const pt = std::sqrt(jet.px * jet.px + jet.py * jet.py);
+  return Jet{pt, std::asinh(jet.pz / pt), std::atan2(jet.py, jet.px)};
+}
+
+int main() {
+  unsigned int const nOrbits = 1;
+  unsigned int const nBXsPerOrbit = 3564;
+  unsigned int const nBXs = nOrbits * nBXsPerOrbit;
+
+  double const akRParam = 0.4;
+  int const swWindowHalfSize = 4;
+  int const swSeedMinHwPt = 8;
+
+  double const jetPtMin = 20.;
+  double const maxDeltaRMatch = 0.2;
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nOrbits = " << nOrbits << ", nBXs = " << nBXs << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // CaloTowers for every BX.
+  //  - Pileup-like towers: multiplicity from a Gaussian distribution
+  //    (rough approximation of the CaloTowers' multiplicity observed in 2025 ZeroBias data),
+  //    hwPt from an exponential distribution.
+  //  - Jet-like deposits: 4 per BX, with a Gaussian transverse profile (sigma of 1.5 towers) around a random tower.
+  auto const& lut = CaloTowerLUT::get();
+
+  std::vector<int> validHwEtas;
+  for (auto hwEta = CaloTowerLUT::kHwEtaMin; hwEta <= CaloTowerLUT::kHwEtaMax; ++hwEta) {
+    if (lut.validHwEta(hwEta)) {
+      validHwEtas.emplace_back(hwEta);
+    }
+  }
+
+  std::vector<int> validHwPhis;
+  for (auto hwPhi = CaloTowerLUT::kHwPhiMin; hwPhi <= CaloTowerLUT::kHwPhiMax; ++hwPhi) {
+    if (lut.validHwPhi(hwPhi)) {
+      validHwPhis.emplace_back(hwPhi);
+    }
+  }
+
+  int const nEta = validHwEtas.size();
+  int const nPhi = validHwPhis.size();
+
+  std::mt19937 gen(12345);
+  std::normal_distribution nTowersDistrib{1500., 600.};
+  std::exponential_distribution puHwPtDistrib{0.5};
+  std::uniform_int_distribution<int> etaIdxDistrib{0, nEta - 1};
+  std::uniform_int_distribution<int> phiIdxDistrib{0, nPhi - 1};
+  std::uniform_real_distribution jetHwPtDistrib{40., 600.};
+  std::normal_distribution jetProfileDistrib{0., 1.5};
+
+  std::vector<std::vector<Tower>> towers(nBXs);
+  for (auto& bxTowers : towers) {
+    std::map<std::pair<int, int>, int> cells;
+
+    auto const nPUTowers = std::max(1l, std::lround(nTowersDistrib(gen)));
+    for (auto ict = 0; ict < nPUTowers; ++ict) {
+      cells[{etaIdxDistrib(gen), phiIdxDistrib(gen)}] += 1 + std::lround(puHwPtDistrib(gen));
+    }
+
+    for (auto ijet = 0; ijet < 4; ++ijet) {
+      auto const etaIdx0 = etaIdxDistrib(gen);
+      auto const phiIdx0 = phiIdxDistrib(gen);
+      auto const nJetTowerHits = std::lround(jetHwPtDistrib(gen));
+      for (auto ihit = 0; ihit < nJetTowerHits; ++ihit) {
+        auto const etaIdx = etaIdx0 + std::lround(jetProfileDistrib(gen));
+        auto const phiIdx = (phiIdx0 + std::lround(jetProfileDistrib(gen)) + nPhi) % nPhi;
+        if (etaIdx >= 0 and etaIdx < nEta) {
+          cells[{etaIdx, phiIdx}] += 1;
+        }
+      }
+    }
+
+    for (auto const& [cell, hwPt] : cells) {
+      bxTowers.emplace_back(Tower{std::min(hwPt, CaloTowerLUT::kHwPtMax), validHwEtas[cell.first], validHwPhis[cell.second]});
+    }
+  }
+
+  std::cout << "Generated CaloTowers for " << nBXs << " BXs" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  std::vector<std::vector<Jet>> akJets(nBXs);
+  std::vector<std::vector<Jet>> swJets(nBXs);
+
+  //
+  // Test #1: anti-kT (LatticeAntiKtClustering, R=0.4)
+  //
+  ++test_idx;
+  {
+    LatticeAntiKtClustering clustering{akRParam};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto ibx = 0u; ibx < nBXs; ++ibx) {
+      clustering.clear();
+      for (auto const& tower : towers[ibx]) {
+        clustering.addTower(tower.hwPt, tower.hwEta, tower.hwPhi);
+      }
+      clustering.run();
+      for (auto const& jet : clustering.inclusiveJets(jetPtMin)) {
+        akJets[ibx].emplace_back(toJet(jet));
+      }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (AK4): " << duration.count() << " sec" << std::endl;
+    std::cout << delimiter << std::endl;
+  }
+
+  //
+  // Test #2: sliding window (SlidingWindowJetFinder, 9x9)
+  //
+  ++test_idx;
+  {
+    SlidingWindowJetFinder jetFinder{swWindowHalfSize, swSeedMinHwPt};
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto ibx = 0u; ibx < nBXs; ++ibx) {
+      jetFinder.clear();
+      for (auto const& tower : towers[ibx]) {
+        jetFinder.addTower(tower.hwPt, tower.hwEta, tower.hwPhi);
+      }
+      jetFinder.run();
+      for (auto const& jet : jetFinder.jets(jetPtMin)) {
+        swJets[ibx].emplace_back(toJet(jet));
+      }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (SW9x9): " << duration.count() << " sec" << std::endl;
+    std::cout << delimiter << std::endl;
+  }
+
+  //
+  // Response of SW9x9 jets relative to the closest AK4 jet (pT > jetPtMin, DeltaR < maxDeltaRMatch)
+  //
+  {
+    unsigned long nAKJets{0}, nSWJets{0}, nMatched{0};
+    double sumRatio{0}, sumRatio2{0};
+
+    for (auto ibx = 0u; ibx < nBXs; ++ibx) {
+      nAKJets += akJets[ibx].size();
+      nSWJets += swJets[ibx].size();
+
+      for (auto const& akJet : akJets[ibx]) {
+        Jet const* match{nullptr};
+        auto minDeltaR2 = maxDeltaRMatch * maxDeltaRMatch;
+        for (auto const& swJet : swJets[ibx]) {
+          auto const deta = swJet.eta - akJet.eta;
+          auto const dphi = std::remainder(swJet.phi - akJet.phi, 2 * M_PI);
+          auto const deltaR2 = deta * deta + dphi * dphi;
+          if (deltaR2 < minDeltaR2) {
+            minDeltaR2 = deltaR2;
+            match = &swJet;
+          }
+        }
+
+        if (match) {
+          ++nMatched;
+          auto const ratio = match->pt / akJet.pt;
+          sumRatio += ratio;
+          sumRatio2 += ratio * ratio;
+        }
+      }
+    }
+
+    auto const meanRatio = (nMatched > 0) ? sumRatio / nMatched : 0.;
+    auto const rmsRatio = (nMatched > 0) ? std::sqrt(std::max(0., sumRatio2 / nMatched - meanRatio * meanRatio)) : 0.;
+
+    std::cout << "Jets with pT > " << jetPtMin << " GeV: AK4=" << nAKJets << ", SW9x9=" << nSWJets << std::endl;
+    std::cout << "AK4 jets matched to a SW9x9 jet (DeltaR < " << maxDeltaRMatch
+              << "): " << (nAKJets > 0 ? double(nMatched) / nAKJets : 0.) << std::endl;
+    std::cout << "pT(SW9x9) / pT(AK4) of matched jets: mean = " << meanRatio << ", rms = " << rmsRatio << std::endl;
+    std::cout << delimiter << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/FileInPath.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrectionPayload.h"
+#include "L1ScoutingTools/Reconstruction/interface/JetCorrector.h"
+
+// Construction of JetCorrector from the text JEC file vs from the binary JEC file (converted here),
+// and comparison of the corrections obtained with the two.
+int main() {
+  unsigned int const nCorrectors = 200;
+  unsigned int const nJets = 100000;
+
+  std::string const textFile =
+      edm::FileInPath("L1ScoutingTools/Reconstruction/data/JEC_AK4CaloTowerL1S_Run3Winter25_v2.txt").fullPath();
+  std::string const binaryFile =
+      (std::filesystem::temp_directory_path() / "testTimeToLoadJetCorrections_JEC.bin").string();
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  JetCorrectionPayload{textFile}.writeBinary(binaryFile);
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nCorrectors = " << nCorrectors << ", text file = " << textFile << " ("
+            << std::filesystem::file_size(textFile) << " bytes), binary file = " << binaryFile << " ("
+            << std::filesystem::file_size(binaryFile) << " bytes)" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  auto const run = [&](std::string const& filePath, std::string const& label) {
+    ++test_idx;
+
+    std::vector<JetCorrector> correctors;
+    correctors.reserve(nCorrectors);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto icorr = 0u; icorr < nCorrectors; ++icorr) {
+      correctors.emplace_back(filePath, JetCorrector::FormulaType::CorrectedPt);
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e6 * duration.count() / nCorrectors << " us per JetCorrector)" << std::endl;
+    std::cout << delimiter << std::endl;
+  };
+
+  //
+  // Test #1: text file
+  //
+  run(textFile, "text file");
+
+  //
+  // Test #2: binary file
+  //
+  run(binaryFile, "binary file");
+
+  // corrections from the two files (both formula types, with and without kernels)
+  std::mt19937 gen(12345);
+  std::exponential_distribution ptDistrib{0.05};
+  std::uniform_real_distribution etaDistrib{-5.2f, 5.2f};
+  std::uniform_int_distribution puProxyDistrib{0, 150};
+
+  unsigned long nDifferent{0};
+  for (auto const formulaType : {JetCorrector::FormulaType::CorrectionFactor, JetCorrector::FormulaType::CorrectedPt}) {
+    for (auto const useKernels : {false, true}) {
+      JetCorrector const textCorrector{textFile, formulaType, useKernels};
+      JetCorrector const binaryCorrector{binaryFile, formulaType, useKernels};
+      for (auto ijet = 0u; ijet < nJets; ++ijet) {
+        float const pt = 1. + ptDistrib(gen);
+        float const eta = etaDistrib(gen);
+        int const puProxy = puProxyDistrib(gen);
+        nDifferent +=
+            (textCorrector.correction(pt, eta, puProxy) != binaryCorrector.correction(pt, eta, puProxy));
+      }
+    }
+  }
+
+  std::filesystem::remove(binaryFile);
+
+  std::cout << "Jets with a different correction from the text and binary files: " << nDifferent << " (out of "
+            << 4 * nJets << ")" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  return (nDifferent == 0) ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataFormats/L1Trigger/interface/Jet.h"
+
+// Output of L1TCaloTowerJetCorrectorB/C at high jet multiplicity:
+// copies of the corrected jets sorted via an index vector (before maxJetsPerBx),
+// vs sort keys (corrected pT, index) with a partial sort of the leading jets written directly to the output.
+struct Event {
+  l1t::JetBxCollection jets;
+  std::vector<double> corrs;
+};
+
+// corrected jets of one BX: copies of all the jets, full sort of their indices
+void correctAndSortCopies(Event const& evt, int const bx, unsigned int const corrOffset, l1t::JetBxCollection& output) {
+  auto const nInputs = evt.jets.size(bx);
+
+  std::vector<l1t::Jet> out_jets{};
+  out_jets.reserve(nInputs);
+  for (auto idx = 0u; idx < nInputs; ++idx) {
+    auto jet = evt.jets.at(bx, idx);
+    auto const corr = evt.corrs[corrOffset + idx];
+    if (corr <= 0) {
+      continue;
+    }
+    jet.setP4(jet.p4() * corr);
+    out_jets.emplace_back(std::move(jet));
+  }
+
+  std::vector<size_t> sortIdxs(out_jets.size());
+  std::iota(sortIdxs.begin(), sortIdxs.end(), 0);
+  std::sort(sortIdxs.begin(), sortIdxs.end(), [&](size_t const i1, size_t const i2) {
+    return out_jets[i1].pt() > out_jets[i2].pt();
+  });
+
+  for (auto idx : sortIdxs) {
+    output.push_back(bx, out_jets[idx]);
+  }
+}
+
+// corrected jets of one BX: sort keys, partial sort of the leading maxJetsPerBx jets (all jets if negative)
+void correctAndSortKeys(Event const& evt,
+                        int const bx,
+                        unsigned int const corrOffset,
+                        int const maxJetsPerBx,
+                        std::vector<std::pair<double, unsigned int>>& sortKeys,
+                        l1t::JetBxCollection& output) {
+  auto const byDecreasingPt = [](auto const& key1, auto const& key2) {
+    return key1.first > key2.first or (key1.first == key2.first and key1.second < key2.second);
+  };
+
+  auto const nInputs = evt.jets.size(bx);
+  auto const corrsBegin = evt.corrs.cbegin() + corrOffset;
+
+  sortKeys.clear();
+  for (auto idx = 0u; idx < nInputs; ++idx) {
+    auto const corr = corrsBegin[idx];
+    if (corr > 0) {
+      sortKeys.emplace_back((evt.jets.at(bx, idx).p4() * corr).pt(), idx);
+    }
+  }
+
+  auto const nOutputs = (maxJetsPerBx < 0) ? sortKeys.size() : std::min(sortKeys.size(), std::size_t(maxJetsPerBx));
+  auto const sortKeysEnd = sortKeys.begin() + nOutputs;
+  if (sortKeysEnd != sortKeys.end()) {
+    std::nth_element(sortKeys.begin(), sortKeysEnd, sortKeys.end(), byDecreasingPt);
+  }
+  std::sort(sortKeys.begin(), sortKeysEnd, byDecreasingPt);
+
+  for (auto key = sortKeys.begin(); key != sortKeysEnd; ++key) {
+    auto const& input = evt.jets.at(bx, key->second);
+    l1t::Jet jet{input};
+    jet.setP4(input.p4() * corrsBegin[key->second]);
+    output.push_back(bx, std::move(jet));
+  }
+}
+
+int main() {
+  unsigned int const nEvents = 2000;
+  int const bxMin = -2;
+  int const bxMax = 2;
+  double const nJetsPerBx = 300.;
+  int const maxJetsPerBx = 12;
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nEvents = " << nEvents << ", BXs = [" << bxMin << ", " << bxMax << "], nJetsPerBx ~ " << nJetsPerBx
+            << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // jets with a falling pT spectrum, and corrections between 0.8 and 2 (zero for 5% of the jets)
+  std::mt19937 gen(12345);
+  std::poisson_distribution nJetsDistrib{nJetsPerBx};
+  std::exponential_distribution ptDistrib{0.1};
+  std::uniform_real_distribution etaDistrib{-5., 5.};
+  std::uniform_real_distribution phiDistrib{-M_PI, M_PI};
+  std::uniform_real_distribution corrDistrib{0.8, 2.};
+  std::bernoulli_distribution zeroCorrDistrib{0.05};
+
+  std::vector<Event> events;
+  events.reserve(nEvents);
+
+  unsigned long nJetsTotal{0};
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    auto& evt = events.emplace_back(Event{l1t::JetBxCollection(0, bxMin, bxMax), {}});
+    for (auto bx = bxMin; bx <= bxMax; ++bx) {
+      auto const nJets = nJetsDistrib(gen);
+      nJetsTotal += nJets;
+      for (auto ijet = 0; ijet < nJets; ++ijet) {
+        auto const pt = 1. + ptDistrib(gen);
+        auto const eta = etaDistrib(gen);
+        auto const phi = phiDistrib(gen);
+        l1t::Jet::LorentzVector const p4{pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta), pt * std::cosh(eta)};
+        evt.jets.push_back(bx, l1t::Jet{p4});
+        evt.corrs.emplace_back(zeroCorrDistrib(gen) ? 0. : corrDistrib(gen));
+      }
+    }
+  }
+
+  std::cout << "Generated " << nJetsTotal << " jets" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  std::vector<l1t::JetBxCollection> refOutputs(nEvents);
+  std::vector<l1t::JetBxCollection> outputs(nEvents);
+
+  auto const run = [&](auto const& correctAndSort, std::vector<l1t::JetBxCollection>& outs, std::string const& label) {
+    ++test_idx;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+      outs[ievt] = l1t::JetBxCollection(0, bxMin, bxMax);
+      auto corrOffset = 0u;
+      for (auto bx = bxMin; bx <= bxMax; ++bx) {
+        correctAndSort(events[ievt], bx, corrOffset, outs[ievt]);
+        corrOffset += events[ievt].jets.size(bx);
+      }
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e6 * duration.count() / nEvents << " us per event)" << std::endl;
+  };
+
+  // number of output jets different from the leading jets of Test #1
+  auto const compare = [&](int const maxJets) {
+    unsigned long nJets{0};
+    unsigned long nDifferent{0};
+    for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+      for (auto bx = bxMin; bx <= bxMax; ++bx) {
+        auto const nRef = refOutputs[ievt].size(bx);
+        auto const nExpected = (maxJets < 0) ? nRef : std::min(nRef, unsigned(maxJets));
+        auto const nOut = outputs[ievt].size(bx);
+        nDifferent += (nOut > nExpected) ? (nOut - nExpected) : (nExpected - nOut);
+        for (auto idx = 0u; idx < std::min(nOut, nExpected); ++idx) {
+          ++nJets;
+          nDifferent += (outputs[ievt].at(bx, idx).p4() != refOutputs[ievt].at(bx, idx).p4());
+        }
+      }
+    }
+    std::cout << "Output jets: " << nJets << ", different from Test #1: " << nDifferent << std::endl;
+    std::cout << delimiter << std::endl;
+  };
+
+  //
+  // Test #1: copies of the corrected jets, full sort of their indices
+  //
+  run([&](Event const& evt, int const bx, unsigned int const corrOffset,
+          l1t::JetBxCollection& output) { correctAndSortCopies(evt, bx, corrOffset, output); },
+      refOutputs,
+      "copies of the jets, full sort");
+  std::cout << delimiter << std::endl;
+
+  std::vector<std::pair<double, unsigned int>> sortKeys;
+
+  //
+  // Test #2: sort keys, full sort (maxJetsPerBx = -1)
+  //
+  run([&](Event const& evt, int const bx, unsigned int const corrOffset,
+          l1t::JetBxCollection& output) { correctAndSortKeys(evt, bx, corrOffset, -1, sortKeys, output); },
+      outputs,
+      "sort keys, all jets");
+  compare(-1);
+
+  //
+  // Test #3: sort keys, partial sort of the leading jets
+  //
+  run([&](Event const& evt, int const bx, unsigned int const corrOffset,
+          l1t::JetBxCollection& output) { correctAndSortKeys(evt, bx, corrOffset, maxJetsPerBx, sortKeys, output); },
+      outputs,
+      "sort keys, leading " + std::to_string(maxJetsPerBx) + " jets");
+  compare(maxJetsPerBx);
+
+  return 0;
+}
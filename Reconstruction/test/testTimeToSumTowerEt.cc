@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerLUT.h"
+#include "L1ScoutingTools/Reconstruction/interface/CaloTowerWindowMasks.h"
+#include "L1TriggerScouting/Utilities/interface/conversion.h"
+
+// Scalar ET and missing ET of CaloTowers in several (hwPt, |hwEta|) windows ("configurations"):
+// one pass over the towers per configuration, with the ET and phi of every tower from l1ScoutingRun3::calol1,
+// vs L1TCaloTowerEtSumsProducer (one pass over the towers of every BX, bitmasks of configurations, CaloTowerLUT).
+// The sums of both are compared for every BX and configuration (same towers and same order of the sums).
+struct Config {
+  std::string label;
+  int towerMinHwPt;
+  int towerMaxHwPt;
+  int towerMinAbsHwEta;
+  int towerMaxAbsHwEta;
+};
+
+// ET, Ex and Ey sums of every BX (index: (ievt * nBXs + ibx) * nConfigs + icfg)
+struct Sums {
+  std::vector<double> et;
+  std::vector<double> ex;
+  std::vector<double> ey;
+
+  explicit Sums(unsigned int const size) : et(size, 0.), ex(size, 0.), ey(size, 0.) {}
+};
+
+// one pass over the towers of every BX for one configuration, direct conversion of every tower
+void sumOneConfig(l1t::CaloTowerBxCollection const& inputs,
+                  Config const& config,
+                  unsigned int const offset,
+                  unsigned int const nConfigs,
+                  Sums& sums) {
+  for (auto bx = inputs.getFirstBX(); bx <= inputs.getLastBX(); ++bx) {
+    double et{0}, ex{0}, ey{0};
+
+    auto const nInputs = inputs.size(bx);
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& input = inputs.at(bx, idx);
+      auto const absHwEta = std::abs(input.hwEta());
+      if ((config.towerMinHwPt < 0 or input.hwPt() >= config.towerMinHwPt) and
+          (config.towerMaxHwPt < 0 or input.hwPt() <= config.towerMaxHwPt) and
+          (config.towerMinAbsHwEta < 0 or absHwEta >= config.towerMinAbsHwEta) and
+          (config.towerMaxAbsHwEta < 0 or absHwEta <= config.towerMaxAbsHwEta) and
+          l1ScoutingRun3::calol1::validHwEta(input.hwEta()) and l1ScoutingRun3::calol1::validHwPhi(input.hwPhi())) {
+        double const towerEt = l1ScoutingRun3::calol1::fEt(input.hwPt());
+        double const phi = l1ScoutingRun3::calol1::fPhi(input.hwPhi());
+        et += towerEt;
+        ex += towerEt * std::cos(phi);
+        ey += towerEt * std::sin(phi);
+      }
+    }
+
+    auto const idx = offset + (bx - inputs.getFirstBX()) * nConfigs;
+    sums.et[idx] = et;
+    sums.ex[idx] = ex;
+    sums.ey[idx] = ey;
+  }
+}
+
+// same as L1TCaloTowerEtSumsProducer::sumBX for every BX
+void sumAllConfigs(l1t::CaloTowerBxCollection const& inputs,
+                   CaloTowerLUT const& lut,
+                   CaloTowerWindowMasks const& configMasks,
+                   unsigned int const offset,
+                   unsigned int const nConfigs,
+                   Sums& sums) {
+  for (auto bx = inputs.getFirstBX(); bx <= inputs.getLastBX(); ++bx) {
+    auto const first = offset + (bx - inputs.getFirstBX()) * nConfigs;
+
+    auto const nInputs = inputs.size(bx);
+    for (auto idx = 0u; idx < nInputs; ++idx) {
+      auto const& input = inputs.at(bx, idx);
+      auto const towerHwPt = input.hwPt();
+      auto const hwEta = input.hwEta();
+      auto const hwPhi = input.hwPhi();
+
+      auto mask = configMasks.mask(towerHwPt, hwEta);
+      if (mask == 0 or not lut.validHwEta(hwEta) or not lut.validHwPhi(hwPhi)) {
+        continue;
+      }
+
+      double const towerEt = lut.et(towerHwPt);
+      double const towerEx = towerEt * lut.cosPhi(hwPhi);
+      double const towerEy = towerEt * lut.sinPhi(hwPhi);
+
+      for (; mask != 0; mask &= mask - 1) {
+        auto const icfg = first + std::countr_zero(mask);
+        sums.et[icfg] += towerEt;
+        sums.ex[icfg] += towerEx;
+        sums.ey[icfg] += towerEy;
+      }
+    }
+  }
+}
+
+int main() {
+  unsigned int const nEvents = 2000;
+  int const bxMin = -2;
+  int const bxMax = 2;
+  double const maxRelDiffAllowed = 1e-12;
+
+  std::vector<Config> const configs{
+      {"All", 1, -1, -1, -1},
+      {"NoHF", 1, -1, -1, 28},
+      {"Barrel", 1, -1, -1, 16},
+      {"NoHFHwPtGe2", 2, -1, -1, 28},
+      {"Endcap", 1, -1, 17, 28},
+      {"HF", 1, -1, 30, -1},
+      {"HwPtGe8", 8, -1, -1, -1},
+      {"HwPt1To4", 1, 4, -1, -1},
+  };
+
+  unsigned int const nConfigs = configs.size();
+  unsigned int const nBXs = bxMax - bxMin + 1;
+
+  std::string const delimiter = "================================================";
+  unsigned int test_idx = 0;
+
+  std::cout << delimiter << std::endl;
+  std::cout << "nEvents = " << nEvents << ", BXs = [" << bxMin << ", " << bxMax << "], nConfigs = " << nConfigs
+            << std::endl;
+  std::cout << delimiter << std::endl;
+
+  // CaloTowers for every BX: multiplicity from a Gaussian distribution, hwPt from an exponential distribution
+  // (including hwPt = 0), hwEta uniform in [-41, 41] (including the invalid values 0 and +-29), hwPhi uniform in [1, 72]
+  std::mt19937 gen(12345);
+  std::normal_distribution nTowersDistrib{1500., 600.};
+  std::exponential_distribution hwPtDistrib{0.3};
+  std::uniform_int_distribution<int> hwEtaDistrib{-41, 41};
+  std::uniform_int_distribution<int> hwPhiDistrib{1, 72};
+
+  std::vector<l1t::CaloTowerBxCollection> events;
+  events.reserve(nEvents);
+
+  unsigned long nTowersTotal{0};
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    auto& evt = events.emplace_back(0, bxMin, bxMax);
+    for (auto bx = bxMin; bx <= bxMax; ++bx) {
+      auto const nTowers = std::max(0, int(nTowersDistrib(gen)));
+      nTowersTotal += nTowers;
+      for (auto itow = 0; itow < nTowers; ++itow) {
+        int const hwPt = int(hwPtDistrib(gen));
+        evt.push_back(
+            bx, l1t::CaloTower(l1t::CaloTower::LorentzVector(), 0., 0., hwPt, hwEtaDistrib(gen), hwPhiDistrib(gen), 0));
+      }
+    }
+  }
+
+  std::cout << "Generated " << nTowersTotal << " CaloTowers" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  Sums refSums(nEvents * nBXs * nConfigs);
+  Sums sums(nEvents * nBXs * nConfigs);
+
+  auto const report = [&](auto const startTime, std::string const& label) {
+    auto const endTime = std::chrono::steady_clock::now();
+    auto const duration = std::chrono::duration<double>(endTime - startTime);
+    std::cout << "Test #" << ++test_idx << " (" << label << "): " << duration.count() << " sec ("
+              << 1e6 * duration.count() / nEvents << " us per event)" << std::endl;
+  };
+
+  //
+  // Test #1: one pass per configuration, direct conversion of every tower
+  //
+  auto startTime = std::chrono::steady_clock::now();
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    for (auto icfg = 0u; icfg < nConfigs; ++icfg) {
+      sumOneConfig(events[ievt], configs[icfg], ievt * nBXs * nConfigs + icfg, nConfigs, refSums);
+    }
+  }
+  report(startTime, std::to_string(nConfigs) + " passes, one per configuration, calol1 functions");
+  std::cout << delimiter << std::endl;
+
+  //
+  // Test #2: one pass for all configurations
+  //
+  auto const& lut = CaloTowerLUT::get();
+
+  std::vector<CaloTowerWindowMasks::Window> windows;
+  for (auto const& config : configs) {
+    windows.emplace_back(CaloTowerWindowMasks::Window{
+        config.towerMinHwPt, config.towerMaxHwPt, config.towerMinAbsHwEta, config.towerMaxAbsHwEta});
+  }
+  CaloTowerWindowMasks const configMasks{windows};
+
+  startTime = std::chrono::steady_clock::now();
+  for (auto ievt = 0u; ievt < nEvents; ++ievt) {
+    sumAllConfigs(events[ievt], lut, configMasks, ievt * nBXs * nConfigs, nConfigs, sums);
+  }
+  report(startTime, "one pass, all configurations, bitmasks and CaloTowerLUT");
+
+  // differences relative to max(ET, 1 GeV) of the reference
+  double maxRelDiff{0};
+  for (auto idx = 0u; idx < refSums.et.size(); ++idx) {
+    auto const scale = std::max(refSums.et[idx], 1.);
+    maxRelDiff = std::max({maxRelDiff,
+                           std::abs(sums.et[idx] - refSums.et[idx]) / scale,
+                           std::abs(sums.ex[idx] - refSums.ex[idx]) / scale,
+                           std::abs(sums.ey[idx] - refSums.ey[idx]) / scale});
+  }
+
+  std::cout << "Max relative difference of ET, METx and METy from Test #1: " << maxRelDiff
+            << " (max allowed: " << maxRelDiffAllowed << ")" << std::endl;
+  std::cout << delimiter << std::endl;
+
+  return (maxRelDiff <= maxRelDiffAllowed) ? 0 : 1;
+}